@@ -84,4 +84,18 @@ inline void RunInGameThread(TUniqueFunction<void()> Function)
     Future.Wait();
 }
 
+/** Waits for the given future on the game thread, while running any tasks queued for the game thread, so that work
+    which uses RunInGameThread can be waited for without a deadlock. */
+template <typename ResultType>
+inline void WaitInGameThread(const TFuture<ResultType>& Future)
+{
+    check(IsInGameThread());
+
+    while (!Future.IsReady())
+    {
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FPlatformProcess::Sleep(0.01f);
+    }
+}
+
 }
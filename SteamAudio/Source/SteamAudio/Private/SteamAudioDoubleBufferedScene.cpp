@@ -0,0 +1,270 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioDoubleBufferedScene.h"
+#include "Async/Async.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioDoubleBufferedScene
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioDoubleBufferedScene::FSteamAudioDoubleBufferedScene()
+    : Scenes{ nullptr, nullptr }
+    , CurrentIndex(0)
+    , bDoubleBuffered(false)
+    , NextHandle(0)
+    , bCommitInProgress(false)
+    , bCommitComplete(false)
+{}
+
+FSteamAudioDoubleBufferedScene::~FSteamAudioDoubleBufferedScene()
+{
+    Shutdown();
+}
+
+bool FSteamAudioDoubleBufferedScene::Initialize(IPLContext Context, const IPLSceneSettings& SceneSettings, bool bInDoubleBuffered)
+{
+    check(!Scenes[0]);
+
+    bDoubleBuffered = bInDoubleBuffered;
+    CurrentIndex = 0;
+
+    IPLSceneSettings SceneSettingsCopy = SceneSettings;
+
+    for (int32 i = 0; i < NumScenes(); ++i)
+    {
+        IPLerror Status = iplSceneCreate(Context, &SceneSettingsCopy, &Scenes[i]);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create scene. [%d]"), Status);
+            Shutdown();
+            return false;
+        }
+
+        // Simulators can start using the current scene right away.
+        iplSceneCommit(Scenes[i]);
+    }
+
+    return true;
+}
+
+void FSteamAudioDoubleBufferedScene::Shutdown()
+{
+    while (bCommitInProgress)
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    for (auto& Pair : Instances)
+    {
+        for (int32 i = 0; i < 2; ++i)
+        {
+            iplInstancedMeshRelease(&Pair.Value.InstancedMeshes[i]);
+        }
+
+        iplSceneRelease(&Pair.Value.SubScene);
+    }
+
+    Instances.Empty();
+
+    for (int32 i = 0; i < 2; ++i)
+    {
+        PendingChanges[i] = FPendingChanges();
+        iplSceneRelease(&Scenes[i]);
+    }
+
+    CurrentIndex = 0;
+    bCommitComplete = false;
+}
+
+FSteamAudioDoubleBufferedScene::FInstanceHandle FSteamAudioDoubleBufferedScene::AddInstance(IPLScene SubScene, const IPLMatrix4x4& Transform)
+{
+    check(IsInGameThread());
+    check(SubScene);
+
+    if (!Scenes[0])
+        return INDEX_NONE;
+
+    FInstanceHandle Handle = NextHandle++;
+
+    FInstance& Instance = Instances.Add(Handle);
+    Instance.SubScene = iplSceneRetain(SubScene);
+    Instance.Transform = Transform;
+
+    for (int32 i = 0; i < NumScenes(); ++i)
+    {
+        PendingChanges[i].InstanceChanges.Add({Handle, true});
+    }
+
+    return Handle;
+}
+
+void FSteamAudioDoubleBufferedScene::RemoveInstance(FInstanceHandle Handle)
+{
+    check(IsInGameThread());
+
+    FInstance* Instance = Instances.Find(Handle);
+    if (!Instance || Instance->NumScenesPendingRemoval > 0)
+        return;
+
+    Instance->NumScenesPendingRemoval = NumScenes();
+
+    for (int32 i = 0; i < NumScenes(); ++i)
+    {
+        PendingChanges[i].InstanceChanges.Add({Handle, false});
+    }
+}
+
+void FSteamAudioDoubleBufferedScene::UpdateInstanceTransform(FInstanceHandle Handle, const IPLMatrix4x4& Transform)
+{
+    check(IsInGameThread());
+
+    FInstance* Instance = Instances.Find(Handle);
+    if (!Instance || Instance->NumScenesPendingRemoval > 0)
+        return;
+
+    Instance->Transform = Transform;
+
+    for (int32 i = 0; i < NumScenes(); ++i)
+    {
+        PendingChanges[i].MovedInstances.Add(Handle);
+    }
+}
+
+bool FSteamAudioDoubleBufferedScene::SwapBuffers()
+{
+    check(IsInGameThread());
+
+    if (!Scenes[0])
+        return false;
+
+    if (!bDoubleBuffered)
+    {
+        if (PendingChanges[0].IsEmpty())
+            return false;
+
+        TArray<IPLScene> RetiredSubScenes;
+        ApplyPendingChanges(0, RetiredSubScenes);
+        iplSceneCommit(Scenes[0]);
+
+        for (IPLScene& SubScene : RetiredSubScenes)
+        {
+            iplSceneRelease(&SubScene);
+        }
+
+        return true;
+    }
+
+    if (!bCommitComplete)
+        return false;
+
+    CurrentIndex = 1 - CurrentIndex;
+    bCommitComplete = false;
+    return true;
+}
+
+void FSteamAudioDoubleBufferedScene::CommitAsync()
+{
+    check(IsInGameThread());
+
+    // The pending scene can't be touched while it's being committed, or while it's waiting to become current.
+    if (!bDoubleBuffered || !Scenes[0] || bCommitInProgress || bCommitComplete)
+        return;
+
+    int32 PendingIndex = 1 - CurrentIndex;
+    if (PendingChanges[PendingIndex].IsEmpty())
+        return;
+
+    TArray<IPLScene> RetiredSubScenes;
+    ApplyPendingChanges(PendingIndex, RetiredSubScenes);
+
+    bCommitInProgress = true;
+
+    Async(EAsyncExecution::ThreadPool, [this, Scene = Scenes[PendingIndex], RetiredSubScenes = MoveTemp(RetiredSubScenes)]() mutable
+    {
+        iplSceneCommit(Scene);
+
+        // The other scene stopped using these when it was committed, so this frees their acceleration structures.
+        for (IPLScene& SubScene : RetiredSubScenes)
+        {
+            iplSceneRelease(&SubScene);
+        }
+
+        bCommitComplete = true;
+        bCommitInProgress = false;
+    });
+}
+
+void FSteamAudioDoubleBufferedScene::ApplyPendingChanges(int32 SceneIndex, TArray<IPLScene>& RetiredSubScenes)
+{
+    IPLScene Scene = Scenes[SceneIndex];
+    FPendingChanges& Changes = PendingChanges[SceneIndex];
+
+    for (const FInstanceChange& Change : Changes.InstanceChanges)
+    {
+        FInstance* Instance = Instances.Find(Change.Handle);
+        if (!Instance)
+            continue;
+
+        IPLInstancedMesh& InstancedMesh = Instance->InstancedMeshes[SceneIndex];
+
+        if (Change.bAdded)
+        {
+            IPLInstancedMeshSettings InstancedMeshSettings{};
+            InstancedMeshSettings.subScene = Instance->SubScene;
+            InstancedMeshSettings.transform = Instance->Transform;
+
+            IPLerror Status = iplInstancedMeshCreate(Scene, &InstancedMeshSettings, &InstancedMesh);
+            if (Status != IPL_STATUS_SUCCESS)
+            {
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to create instanced mesh. [%d]"), Status);
+                continue;
+            }
+
+            iplInstancedMeshAdd(InstancedMesh, Scene);
+        }
+        else
+        {
+            if (InstancedMesh)
+            {
+                iplInstancedMeshRemove(InstancedMesh, Scene);
+                iplInstancedMeshRelease(&InstancedMesh);
+            }
+
+            if (--Instance->NumScenesPendingRemoval == 0)
+            {
+                RetiredSubScenes.Add(Instance->SubScene);
+                Instances.Remove(Change.Handle);
+            }
+        }
+    }
+
+    // Newly added instances were created with their latest transform, so updating them again is harmless.
+    for (FInstanceHandle Handle : Changes.MovedInstances)
+    {
+        FInstance* Instance = Instances.Find(Handle);
+        if (Instance && Instance->InstancedMeshes[SceneIndex])
+        {
+            iplInstancedMeshUpdateTransform(Instance->InstancedMeshes[SceneIndex], Scene, Instance->Transform);
+        }
+    }
+
+    Changes = FPendingChanges();
+}
+
+}
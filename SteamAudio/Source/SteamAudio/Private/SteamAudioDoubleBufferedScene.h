@@ -0,0 +1,144 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioDoubleBufferedScene
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * A top-level scene made up of instanced sub-scenes, kept as two Steam Audio scenes: the current scene, which
+ * simulators use, and a pending scene, to which changes are applied and which is committed on a worker thread. Once
+ * a commit finishes, the two are swapped the next time the simulators are idle, so neither the game thread nor the
+ * simulation thread waits for acceleration structures to be rebuilt. Every change is applied to the pending scene
+ * first, and replayed on the other scene once it becomes the pending scene after a swap.
+ *
+ * When single-buffered (while baking or exporting, or when tracing against the physics scene), changes are applied to
+ * the current scene and committed in place by SwapBuffers.
+ */
+class FSteamAudioDoubleBufferedScene
+{
+public:
+    /** Identifies an instance across both scenes. */
+    typedef int32 FInstanceHandle;
+
+    FSteamAudioDoubleBufferedScene();
+
+    ~FSteamAudioDoubleBufferedScene();
+
+    /** Creates the scene(s). */
+    bool Initialize(IPLContext Context, const IPLSceneSettings& SceneSettings, bool bInDoubleBuffered);
+
+    /** Waits for any commit in progress to finish, and releases all instances and scenes. Instances removed after
+        this are ignored. */
+    void Shutdown();
+
+    /** Returns the scene that simulators should use. Only changes after a call to SwapBuffers returns true. */
+    IPLScene GetScene() const { return Scenes[CurrentIndex]; }
+
+    /** Instances the given sub-scene with the given transform. The sub-scene is retained until the instance has been
+        removed from both scenes. Returns INDEX_NONE on failure. Call on the game thread. */
+    FInstanceHandle AddInstance(IPLScene SubScene, const IPLMatrix4x4& Transform);
+
+    /** Removes an instance. Call on the game thread. */
+    void RemoveInstance(FInstanceHandle Handle);
+
+    /** Changes the transform of an instance. Call on the game thread. */
+    void UpdateInstanceTransform(FInstanceHandle Handle, const IPLMatrix4x4& Transform);
+
+    /** Makes the most recently committed version of the scene current. Returns true if the current scene changed, in
+        which case simulators using it must be given the new scene and committed. Call on the game thread, while no
+        simulation is running against the current scene. */
+    bool SwapBuffers();
+
+    /** Applies all changes made since the last commit to the pending scene, and starts committing it on a worker
+        thread, unless a commit is already in progress or waiting to be swapped in. Call on the game thread. */
+    void CommitAsync();
+
+private:
+    /** A sub-scene instanced into both scenes. */
+    struct FInstance
+    {
+        /** Retained reference to the instanced sub-scene. */
+        IPLScene SubScene = nullptr;
+
+        /** The instance in each scene, or nullptr if it hasn't been added to that scene yet. */
+        IPLInstancedMesh InstancedMeshes[2] = { nullptr, nullptr };
+
+        /** The most recent transform. */
+        IPLMatrix4x4 Transform;
+
+        /** Number of scenes from which the instance has yet to be removed, once it has been removed. */
+        int32 NumScenesPendingRemoval = 0;
+    };
+
+    /** An instance that was added or removed. */
+    struct FInstanceChange
+    {
+        FInstanceHandle Handle;
+        bool bAdded;
+    };
+
+    /** Changes that have yet to be applied to one of the scenes. */
+    struct FPendingChanges
+    {
+        /** Instances added or removed, in order. */
+        TArray<FInstanceChange> InstanceChanges;
+
+        /** Instances whose transform has changed. */
+        TSet<FInstanceHandle> MovedInstances;
+
+        bool IsEmpty() const { return InstanceChanges.Num() == 0 && MovedInstances.Num() == 0; }
+    };
+
+    /** The two scenes. If single-buffered, only the first one is created. */
+    IPLScene Scenes[2];
+
+    /** Changes that have yet to be applied to each scene. */
+    FPendingChanges PendingChanges[2];
+
+    /** Index of the current scene. */
+    int32 CurrentIndex;
+
+    /** True if changes are committed to a separate scene. */
+    bool bDoubleBuffered;
+
+    /** All instances, indexed by handle. */
+    TMap<FInstanceHandle, FInstance> Instances;
+
+    /** The handle to use for the next instance. */
+    FInstanceHandle NextHandle;
+
+    /** True while the pending scene is being committed on a worker thread. */
+    std::atomic<bool> bCommitInProgress;
+
+    /** True if the pending scene has been committed, and is waiting to be swapped in. */
+    std::atomic<bool> bCommitComplete;
+
+    /** Applies pending changes to the given scene. Sub-scenes that are no longer instanced anywhere are added to the
+        given array, and must be released once the scene has been committed. */
+    void ApplyPendingChanges(int32 SceneIndex, TArray<IPLScene>& RetiredSubScenes);
+
+    /** Returns the number of scenes to which changes are applied. */
+    int32 NumScenes() const { return bDoubleBuffered ? 2 : 1; }
+};
+
+}
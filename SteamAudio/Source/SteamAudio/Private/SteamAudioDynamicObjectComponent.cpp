@@ -25,12 +25,16 @@
 
 USteamAudioDynamicObjectComponent::USteamAudioDynamicObjectComponent()
     : Asset()
+    , bFastMoving(false)
     , Scene(nullptr)
-    , InstancedMesh(nullptr)
+    , InstanceHandle(INDEX_NONE)
+    , ReflectionScene(nullptr)
+    , ReflectionInstanceHandle(INDEX_NONE)
+    , LastTransform(FTransform::Identity)
 {
-    // Enable ticking.
+    // Transforms are updated in a single pass by the Steam Audio Manager, so we don't need to tick.
     bAutoActivate = true;
-    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bCanEverTick = false;
 }
 
 FSoftObjectPath USteamAudioDynamicObjectComponent::GetAssetToLoad()
@@ -64,42 +68,94 @@ void USteamAudioDynamicObjectComponent::BeginPlay()
     if (Manager.InitializedType() != SteamAudio::EManagerInitReason::PLAYING)
         return;
 
-    Scene = iplSceneRetain(Manager.GetScene());
+    Scene = Manager.GetDoubleBufferedScene();
     if (!Scene)
         return;
 
-    InstancedMesh = Manager.LoadDynamicObject(this);
-    if (!InstancedMesh)
+    if (Manager.HasSeparateReflectionScene())
     {
-        iplSceneRelease(&Scene);
-        return;
+        ReflectionScene = Manager.GetDoubleBufferedReflectionScene();
     }
 
-    iplInstancedMeshAdd(InstancedMesh, Scene);
+    // The geometry is loaded in the background, so spawning many dynamic objects at once doesn't stall the game
+    // thread. The manager only calls us back if we haven't been unloaded in the meantime.
+    Manager.LoadDynamicObjectAsync(this, [this](int32 LoadedInstanceHandle)
+    {
+        InstanceHandle = LoadedInstanceHandle;
+        if (InstanceHandle != INDEX_NONE && Scene)
+        {
+            SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+
+            // The instance was created using the owner's current transform.
+            LastTransform = GetOwner()->GetRootComponent()->GetComponentTransform();
+
+            if (ReflectionScene)
+            {
+                ReflectionInstanceHandle = Manager.CreateDynamicObjectReflectionInstance(this);
+            }
+
+            Manager.AddDynamicObject(this);
+        }
+    });
 }
 
 void USteamAudioDynamicObjectComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
 
-    if (Scene && InstancedMesh)
+    if (Scene)
     {
-        iplInstancedMeshRemove(InstancedMesh, Scene);
+        if (InstanceHandle != INDEX_NONE)
+        {
+            Manager.RemoveDynamicObject(this);
+
+            Scene->RemoveInstance(InstanceHandle);
+            InstanceHandle = INDEX_NONE;
+        }
+
+        if (ReflectionInstanceHandle != INDEX_NONE)
+        {
+            ReflectionScene->RemoveInstance(ReflectionInstanceHandle);
+            ReflectionInstanceHandle = INDEX_NONE;
+        }
+
         Manager.UnloadDynamicObject(this);
-        iplInstancedMeshRelease(&InstancedMesh);
-        iplSceneRelease(&Scene);
+        ReflectionScene.Reset();
+        Scene.Reset();
     }
 
     Super::EndPlay(EndPlayReason);
 }
 
-void USteamAudioDynamicObjectComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void USteamAudioDynamicObjectComponent::UpdateTransform(float TranslationThreshold, float RotationThreshold)
 {
-    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    if (!Scene || InstanceHandle == INDEX_NONE)
+        return;
+
+    const FTransform& Transform = GetOwner()->GetRootComponent()->GetComponentTransform();
+
+    // Fast-moving objects skip the thresholds, but a transform that hasn't changed at all is never sent, so that an
+    // object at rest doesn't cause the scene to be committed.
+    if (bFastMoving)
+    {
+        if (Transform.Equals(LastTransform, 0.0f))
+            return;
+    }
+    else
+    {
+        bool bTranslated = FVector::DistSquared(Transform.GetLocation(), LastTransform.GetLocation()) > FMath::Square(TranslationThreshold);
+        bool bRotated = Transform.GetRotation().AngularDistance(LastTransform.GetRotation()) > FMath::DegreesToRadians(RotationThreshold);
+        bool bScaled = !Transform.GetScale3D().Equals(LastTransform.GetScale3D());
+
+        if (!bTranslated && !bRotated && !bScaled)
+            return;
+    }
+
+    LastTransform = Transform;
+    Scene->UpdateInstanceTransform(InstanceHandle, SteamAudio::ConvertTransform(Transform));
 
-    if (Scene && InstancedMesh)
+    if (ReflectionInstanceHandle != INDEX_NONE)
     {
-        IPLMatrix4x4 Transform = SteamAudio::ConvertTransform(GetOwner()->GetRootComponent()->GetComponentTransform());
-        iplInstancedMeshUpdateTransform(InstancedMesh, Scene, Transform);
+        ReflectionScene->UpdateInstanceTransform(ReflectionInstanceHandle, SteamAudio::ConvertTransform(Transform));
     }
 }
@@ -144,7 +144,7 @@ void USteamAudioListenerComponent::BeginPlay()
 	if (Manager.InitializedType() != SteamAudio::EManagerInitReason::PLAYING)
 		return;
 
-    Simulator = iplSimulatorRetain(Manager.GetSimulator());
+    Simulator = iplSimulatorRetain(Manager.GetReflectionSimulator());
 	if (!Simulator)
 		return;
 
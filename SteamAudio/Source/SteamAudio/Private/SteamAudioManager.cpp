@@ -20,9 +20,17 @@
 #include "HAL/UnrealMemory.h"
 #include "SteamAudioAudioEngineInterface.h"
 #include "SteamAudioCommon.h"
+#include "SteamAudioDoubleBufferedScene.h"
 #include "SteamAudioDynamicObjectComponent.h"
 #include "SteamAudioListenerComponent.h"
+#include "SteamAudioPortalComponent.h"
+#include "SteamAudioPhysicsRayTracer.h"
+#include "SteamAudioProxyOccluders.h"
+#include "SteamAudioQueryService.h"
 #include "SteamAudioScene.h"
+#include "SteamAudioProbeStreamer.h"
+#include "SteamAudioSceneStreamer.h"
+#include "SteamAudioSerializedObject.h"
 #include "SteamAudioSettings.h"
 #include "SteamAudioSourceComponent.h"
 #include "SOFAFile.h"
@@ -63,6 +71,12 @@ FSteamAudioManager::FSteamAudioManager()
     , TrueAudioNextDevice(nullptr)
     , Scene(nullptr)
     , Simulator(nullptr)
+    , ReflectionScene(nullptr)
+    , ReflectionSimulator(nullptr)
+    , ProxyOccluders(MakeUnique<FSteamAudioProxyOccluders>())
+    , SceneStreamer(MakeUnique<FSteamAudioSceneStreamer>(*this))
+    , ProbeStreamer(MakeUnique<FSteamAudioProbeStreamer>(*this))
+    , QueryService(MakeUnique<FSteamAudioQueryService>())
     , InitializationAttempted(EManagerInitReason::NONE)
     , bInitializationSucceded(false)
     , SteamAudioSettings()
@@ -70,6 +84,8 @@ FSteamAudioManager::FSteamAudioManager()
     , SimulationUpdateTimeElapsed(0.0f)
     , ThreadPool(nullptr)
     , ThreadPoolIdle(true)
+    , ShutdownCount(0)
+    , NumAsyncLoads(0)
 {
     IPLContextSettings ContextSettings{};
     ContextSettings.version = STEAMAUDIO_VERSION;
@@ -211,6 +227,12 @@ bool FSteamAudioManager::InitializeSteamAudio(EManagerInitReason Reason)
     IPLSceneType ConfiguredSceneType = SteamAudioSettings.SceneType;
     IPLReflectionEffectType ConfiguredReflectionEffectType = SteamAudioSettings.ReflectionEffectType;
 
+    // The parametric reverb fast path needs the simulator to output reverb times and EQ, rather than impulse responses.
+    if (Reason == EManagerInitReason::PLAYING && SteamAudioSettings.bParametricReverbFastPath)
+    {
+        ConfiguredReflectionEffectType = IPL_REFLECTIONEFFECTTYPE_PARAMETRIC;
+    }
+
     ActualSceneType = ConfiguredSceneType;
     ActualReflectionEffectType = ConfiguredReflectionEffectType;
 
@@ -219,6 +241,21 @@ bool FSteamAudioManager::InitializeSteamAudio(EManagerInitReason Reason)
         ActualSceneType = IPL_SCENETYPE_DEFAULT;
     }
 
+    // Baking runs against the exported geometry, since the editor world's physics scene doesn't necessarily match
+    // what's loaded at runtime.
+    if (ConfiguredSceneType == IPL_SCENETYPE_CUSTOM)
+    {
+        if (Reason == EManagerInitReason::PLAYING)
+        {
+            check(!PhysicsRayTracer);
+            PhysicsRayTracer = MakeUnique<FSteamAudioPhysicsRayTracer>(SteamAudioSettings, *ProxyOccluders);
+        }
+        else
+        {
+            ActualSceneType = IPL_SCENETYPE_DEFAULT;
+        }
+    }
+
     bool bShouldInitEmbree = (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING) && (ConfiguredSceneType == IPL_SCENETYPE_EMBREE);
     bool bShouldInitRadeonRays = (Reason == EManagerInitReason::BAKING || Reason == EManagerInitReason::PLAYING) && (ConfiguredSceneType == IPL_SCENETYPE_RADEONRAYS);
     bool bShouldInitTrueAudioNext = (Reason == EManagerInitReason::PLAYING) && (ConfiguredReflectionEffectType == IPL_REFLECTIONEFFECTTYPE_TAN);
@@ -305,17 +342,18 @@ bool FSteamAudioManager::InitializeSteamAudio(EManagerInitReason Reason)
 
     check(!Scene);
 
-    IPLSceneSettings SceneSettings{};
-    SceneSettings.type = static_cast<IPLSceneType>(ActualSceneType);
-    SceneSettings.embreeDevice = EmbreeDevice;
-    SceneSettings.radeonRaysDevice = RadeonRaysDevice;
+    IPLSceneSettings SceneSettings = GetSceneSettings();
 
-    IPLerror Status = iplSceneCreate(Context, &SceneSettings, &Scene);
-    if (Status != IPL_STATUS_SUCCESS)
+    // While playing, changes to the scene are committed in the background, and swapped in once the commit finishes.
+    // The physics scene has no acceleration structures to rebuild, so there's nothing to gain from it there.
+    bool bDoubleBufferScenes = (Reason == EManagerInitReason::PLAYING) && !IsUsingPhysicsScene();
+
+    Scene = MakeShared<FSteamAudioDoubleBufferedScene>();
+    if (!Scene->Initialize(Context, SceneSettings, bDoubleBufferScenes))
     {
+        Scene.Reset();
         ShutDownSteamAudio(false);
         bInitializationSucceded = false;
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create scene. [%d]"), Status);
         return false;
     }
 
@@ -343,16 +381,41 @@ bool FSteamAudioManager::InitializeSteamAudio(EManagerInitReason Reason)
         FSteamAudioModule::SetAudioEngineState(AudioEngineStateFactory->CreateAudioEngineState());
     }
 
+    // The physics scene can't be simplified, so there's nothing to gain from a separate reflection scene.
+    bool bShouldUseReflectionScene = (Reason == EManagerInitReason::PLAYING) && SteamAudioSettings.bUseReflectionGeometry && !IsUsingPhysicsScene();
+
+    if (bShouldUseReflectionScene)
+    {
+        check(!ReflectionScene);
+
+        ReflectionScene = MakeShared<FSteamAudioDoubleBufferedScene>();
+        if (!ReflectionScene->Initialize(Context, SceneSettings, bDoubleBufferScenes))
+        {
+            ReflectionScene.Reset();
+            ShutDownSteamAudio(false);
+            bInitializationSucceded = false;
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection scene."));
+            return false;
+        }
+    }
+
     if (Reason == EManagerInitReason::PLAYING)
     {
         check(!Simulator);
+        check(!ReflectionSimulator);
 
         IPLSimulationSettings SimulationSettings = GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
         SimulationSettings.openCLDevice = OpenCLDevice;
         SimulationSettings.radeonRaysDevice = RadeonRaysDevice;
         SimulationSettings.tanDevice = TrueAudioNextDevice;
 
-        Status = iplSimulatorCreate(Context, &SimulationSettings, &Simulator);
+        IPLSimulationSettings DirectSimulationSettings = SimulationSettings;
+        if (ReflectionScene)
+        {
+            DirectSimulationSettings.flags = IPL_SIMULATIONFLAGS_DIRECT;
+        }
+
+        IPLerror Status = iplSimulatorCreate(Context, &DirectSimulationSettings, &Simulator);
         if (Status != IPL_STATUS_SUCCESS)
         {
             ShutDownSteamAudio(false);
@@ -361,6 +424,32 @@ bool FSteamAudioManager::InitializeSteamAudio(EManagerInitReason Reason)
             return false;
         }
 
+        if (ReflectionScene)
+        {
+            IPLSimulationSettings ReflectionSimulationSettings = SimulationSettings;
+            ReflectionSimulationSettings.flags = static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING);
+
+            Status = iplSimulatorCreate(Context, &ReflectionSimulationSettings, &ReflectionSimulator);
+            if (Status != IPL_STATUS_SUCCESS)
+            {
+                ShutDownSteamAudio(false);
+                bInitializationSucceded = false;
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to create reflection simulator. [%d]"), Status);
+                return false;
+            }
+        }
+
+        // Queries are only used for gameplay, so Steam Audio can still run without them.
+        QueryService->Initialize(Context, DirectSimulationSettings);
+
+        iplSimulatorSetScene(Simulator, GetScene());
+        QueryService->SetScene(GetScene());
+
+        if (ReflectionSimulator)
+        {
+            iplSimulatorSetScene(ReflectionSimulator, GetReflectionScene());
+        }
+
         if (!ThreadPool)
         {
             ThreadPool = FQueuedThreadPool::Allocate();
@@ -428,6 +517,15 @@ void FSteamAudioManager::ShutDownSteamAudio(bool bResetFlags /* = true */)
 		OnShutDown.Broadcast(InitializationAttempted);
 	}
 
+    // Async loads that haven't started deserializing yet will see this and give up. Those that have are waited for,
+    // since they use the devices and settings the scene(s) were created with.
+    ShutdownCount++;
+
+    while (NumAsyncLoads > 0)
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+
     IAudioEngineState* AudioEngineState = FSteamAudioModule::GetAudioEngineState();
     if (AudioEngineState)
     {
@@ -446,8 +544,35 @@ void FSteamAudioManager::ShutDownSteamAudio(bool bResetFlags /* = true */)
         SimulationUpdateTimeElapsed = 0.0f;
     }
 
+    // Queries trace rays against the main scene, and through the physics ray tracer against the world, so this waits
+    // for any running queries before either is released.
+    QueryService->Shutdown();
+
+    SceneStreamer->Reset();
+    ProbeStreamer->Reset();
+
+    DynamicObjectComponents.Empty();
+    ProxyOccluderComponents.Empty();
+    PortalComponents.Empty();
+    ProxyOccluders->Reset();
+
+    iplSimulatorRelease(&ReflectionSimulator);
     iplSimulatorRelease(&Simulator);
-    iplSceneRelease(&Scene);
+
+    // Dynamic objects may still hold references to the scenes, but everything in them is released here.
+    if (ReflectionScene)
+    {
+        ReflectionScene->Shutdown();
+        ReflectionScene.Reset();
+    }
+
+    if (Scene)
+    {
+        Scene->Shutdown();
+        Scene.Reset();
+    }
+
+    PhysicsRayTracer.Reset();
     iplTrueAudioNextDeviceRelease(&TrueAudioNextDevice);
     iplRadeonRaysDeviceRelease(&RadeonRaysDevice);
     iplOpenCLDeviceRelease(&OpenCLDevice);
@@ -539,68 +664,168 @@ IPLSimulationSettings FSteamAudioManager::GetBakingSettings(IPLSimulationFlags F
     return SimulationSettings;
 }
 
-IPLInstancedMesh FSteamAudioManager::LoadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+IPLSceneSettings FSteamAudioManager::GetSceneSettings() const
+{
+    IPLSceneSettings SceneSettings{};
+    SceneSettings.type = static_cast<IPLSceneType>(ActualSceneType);
+    SceneSettings.embreeDevice = EmbreeDevice;
+    SceneSettings.radeonRaysDevice = RadeonRaysDevice;
+
+    if (ActualSceneType == IPL_SCENETYPE_CUSTOM && PhysicsRayTracer)
+    {
+        PhysicsRayTracer->InitSceneSettings(SceneSettings);
+    }
+
+    return SceneSettings;
+}
+
+void FSteamAudioManager::SetPhysicsWorld(const UWorld* World)
+{
+    check(IsInGameThread());
+
+    if (!PhysicsRayTracer || PhysicsRayTracer->GetWorld() == World)
+        return;
+
+    // The simulation thread and the query service may be tracing rays against the old world. New queries are only
+    // dispatched from the game thread, so none can start until the world has been replaced.
+    while (!ThreadPoolIdle || !QueryService->IsIdle())
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    PhysicsRayTracer->SetWorld(World);
+}
+
+FSteamAudioDoubleBufferedScene::FInstanceHandle FSteamAudioManager::LoadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
 {
     check(DynamicObjectComponent);
 
-    if (!bInitializationSucceded)
-        return nullptr;
+    if (!bInitializationSucceded || IsUsingPhysicsScene())
+        return INDEX_NONE;
 
     if (!DynamicObjectComponent->GetAssetToLoad().IsAsset())
-        return nullptr;
+        return INDEX_NONE;
 
     FString AssetName = DynamicObjectComponent->GetAssetToLoad().GetAssetPathString();
 
-    IPLScene SubScene = nullptr;
-    IPLerror Status = IPL_STATUS_SUCCESS;
-    if (DynamicObjects.Contains(AssetName))
+    IPLScene SubScene = DynamicObjects.FindRef(AssetName);
+    if (!SubScene)
     {
-        SubScene = DynamicObjects[AssetName];
-        DynamicObjectRefCounts[AssetName]++;
+        // If an async load for this data is in flight, we load it again here, and the async load discards its result
+        // when it completes.
+        USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(DynamicObjectComponent->GetAssetToLoad().TryLoad());
+        if (!AssetObject)
+            return INDEX_NONE;
+
+        SubScene = CreateSubSceneFromAsset(AssetObject, Context, GetSceneSettings());
+        if (!SubScene)
+            return INDEX_NONE;
+
+        DynamicObjects.Add(AssetName, SubScene);
     }
-    else
+
+    DynamicObjectRefCounts.FindOrAdd(AssetName)++;
+
+    return CreateDynamicObjectInstance(SubScene, DynamicObjectComponent);
+}
+
+void FSteamAudioManager::LoadDynamicObjectAsync(USteamAudioDynamicObjectComponent* DynamicObjectComponent, TFunction<void(FSteamAudioDoubleBufferedScene::FInstanceHandle)> OnLoaded)
+{
+    check(IsInGameThread());
+    check(DynamicObjectComponent);
+
+    // When tracing against the physics scene, dynamic objects are already part of it through their collision.
+    if (!bInitializationSucceded || IsUsingPhysicsScene() || !DynamicObjectComponent->GetAssetToLoad().IsAsset())
     {
-        IPLSceneSettings SceneSettings{};
-        SceneSettings.type = static_cast<IPLSceneType>(ActualSceneType);
-        SceneSettings.embreeDevice = EmbreeDevice;
-        SceneSettings.radeonRaysDevice = RadeonRaysDevice;
+        OnLoaded(INDEX_NONE);
+        return;
+    }
 
-        Status = iplSceneCreate(Context, &SceneSettings, &SubScene);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create scene. [%d]"), Status);
-            return nullptr;
-        }
+    FString AssetName = DynamicObjectComponent->GetAssetToLoad().GetAssetPathString();
 
-        IPLStaticMesh StaticMesh = LoadStaticMeshFromAsset(DynamicObjectComponent->GetAssetToLoad(), Context, SubScene);
-        if (!StaticMesh)
-        {
-            iplSceneRelease(&SubScene);
-            return nullptr;
-        }
+    DynamicObjectRefCounts.FindOrAdd(AssetName)++;
 
-        iplStaticMeshAdd(StaticMesh, SubScene);
-        iplSceneCommit(SubScene);
+    // Some other component has already loaded this data.
+    IPLScene SubScene = DynamicObjects.FindRef(AssetName);
+    if (SubScene)
+    {
+        OnLoaded(CreateDynamicObjectInstance(SubScene, DynamicObjectComponent));
+        return;
+    }
 
-        iplStaticMeshRelease(&StaticMesh);
+    // If some other component is already loading this data, just wait for that load to complete.
+    bool bLoadInFlight = PendingDynamicObjects.Contains(AssetName);
 
-        DynamicObjects.Add(AssetName, SubScene);
-        DynamicObjectRefCounts.Add(AssetName, 1);
+    PendingDynamicObjects.FindOrAdd(AssetName).Add({DynamicObjectComponent, MoveTemp(OnLoaded)});
+
+    if (bLoadInFlight)
+        return;
+
+    LoadSubSceneFromAssetAsync(DynamicObjectComponent->GetAssetToLoad(), Context, GetSceneSettings(), [this, AssetName](IPLScene LoadedSubScene)
+    {
+        OnDynamicObjectLoaded(AssetName, LoadedSubScene);
+    });
+}
+
+void FSteamAudioManager::OnDynamicObjectLoaded(const FString& AssetName, IPLScene SubScene)
+{
+    check(IsInGameThread());
+
+    TArray<FPendingDynamicObject> PendingComponents;
+    PendingDynamicObjects.RemoveAndCopyValue(AssetName, PendingComponents);
+
+    // Every component that requested this data has been unloaded in the meantime, or Steam Audio was shut down.
+    if (!Scene || DynamicObjectRefCounts.FindRef(AssetName) <= 0)
+    {
+        iplSceneRelease(&SubScene);
+        SubScene = nullptr;
     }
 
-    IPLInstancedMeshSettings InstancedMeshSettings{};
-    InstancedMeshSettings.subScene = SubScene;
-    InstancedMeshSettings.transform = ConvertTransform(DynamicObjectComponent->GetOwner()->GetRootComponent()->GetComponentTransform());
+    if (SubScene)
+    {
+        // The data may have been loaded synchronously while we were waiting.
+        if (DynamicObjects.Contains(AssetName))
+        {
+            iplSceneRelease(&SubScene);
+            SubScene = DynamicObjects[AssetName];
+        }
+        else
+        {
+            DynamicObjects.Add(AssetName, SubScene);
+        }
+    }
 
-    IPLInstancedMesh InstancedMesh = nullptr;
-    Status = iplInstancedMeshCreate(Scene, &InstancedMeshSettings, &InstancedMesh);
-    if (Status != IPL_STATUS_SUCCESS)
+    for (FPendingDynamicObject& PendingComponent : PendingComponents)
     {
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create instanced mesh. [%d]"), Status);
-        return nullptr;
+        PendingComponent.OnLoaded(SubScene ? CreateDynamicObjectInstance(SubScene, PendingComponent.Component) : INDEX_NONE);
     }
+}
 
-    return InstancedMesh;
+FSteamAudioDoubleBufferedScene::FInstanceHandle FSteamAudioManager::CreateDynamicObjectInstance(IPLScene SubScene, USteamAudioDynamicObjectComponent* DynamicObjectComponent, FSteamAudioDoubleBufferedScene* TargetScene /* = nullptr */)
+{
+    check(SubScene);
+    check(DynamicObjectComponent);
+
+    FSteamAudioDoubleBufferedScene* InstanceScene = TargetScene ? TargetScene : Scene.Get();
+    if (!InstanceScene)
+        return INDEX_NONE;
+
+    return InstanceScene->AddInstance(SubScene, ConvertTransform(DynamicObjectComponent->GetOwner()->GetRootComponent()->GetComponentTransform()));
+}
+
+FSteamAudioDoubleBufferedScene::FInstanceHandle FSteamAudioManager::CreateDynamicObjectReflectionInstance(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+{
+    check(DynamicObjectComponent);
+
+    if (!ReflectionScene)
+        return INDEX_NONE;
+
+    // Dynamic objects are usually small enough that their full geometry is used for reflections too.
+    IPLScene SubScene = DynamicObjects.FindRef(DynamicObjectComponent->GetAssetToLoad().GetAssetPathString());
+    if (!SubScene)
+        return INDEX_NONE;
+
+    return CreateDynamicObjectInstance(SubScene, DynamicObjectComponent, ReflectionScene.Get());
 }
 
 void FSteamAudioManager::UnloadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
@@ -612,17 +837,117 @@ void FSteamAudioManager::UnloadDynamicObject(USteamAudioDynamicObjectComponent*
 
     FString AssetName = DynamicObjectComponent->GetAssetToLoad().GetAssetPathString();
 
+    // If this component is still waiting for an async load, it no longer wants to be notified.
+    TArray<FPendingDynamicObject>* PendingComponents = PendingDynamicObjects.Find(AssetName);
+    if (PendingComponents)
+    {
+        PendingComponents->RemoveAll([DynamicObjectComponent](const FPendingDynamicObject& PendingComponent)
+        {
+            return PendingComponent.Component == DynamicObjectComponent;
+        });
+    }
+
+    int* RefCount = DynamicObjectRefCounts.Find(AssetName);
+    if (!RefCount)
+        return;
+
+    (*RefCount)--;
+    if (*RefCount > 0)
+        return;
+
+    DynamicObjectRefCounts.Remove(AssetName);
+
+    // If the data is still loading, it will be released when the load completes.
     if (DynamicObjects.Contains(AssetName))
     {
-        DynamicObjectRefCounts[AssetName]--;
-        if (DynamicObjectRefCounts[AssetName] <= 0)
+        iplSceneRelease(&DynamicObjects[AssetName]);
+        DynamicObjects.Remove(AssetName);
+    }
+}
+
+void FSteamAudioManager::AddDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+{
+    check(DynamicObjectComponent);
+    DynamicObjectComponents.Add(DynamicObjectComponent);
+}
+
+void FSteamAudioManager::RemoveDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent)
+{
+    check(DynamicObjectComponent);
+    DynamicObjectComponents.Remove(DynamicObjectComponent);
+}
+
+void FSteamAudioManager::UpdateDynamicObjects()
+{
+    for (USteamAudioDynamicObjectComponent* DynamicObjectComponent : DynamicObjectComponents)
+    {
+        DynamicObjectComponent->UpdateTransform(SteamAudioSettings.DynamicObjectTranslationThreshold, SteamAudioSettings.DynamicObjectRotationThreshold);
+    }
+}
+
+void FSteamAudioManager::AddProxyOccluder(USteamAudioProxyOccluderComponent* ProxyOccluderComponent)
+{
+    check(ProxyOccluderComponent);
+    ProxyOccluderComponents.Add(ProxyOccluderComponent);
+}
+
+void FSteamAudioManager::RemoveProxyOccluder(USteamAudioProxyOccluderComponent* ProxyOccluderComponent)
+{
+    check(ProxyOccluderComponent);
+    ProxyOccluderComponents.Remove(ProxyOccluderComponent);
+}
+
+void FSteamAudioManager::AddPortal(USteamAudioPortalComponent* PortalComponent)
+{
+    check(PortalComponent);
+    PortalComponents.Add(PortalComponent);
+}
+
+void FSteamAudioManager::RemovePortal(USteamAudioPortalComponent* PortalComponent)
+{
+    check(PortalComponent);
+    PortalComponents.Remove(PortalComponent);
+}
+
+void FSteamAudioManager::UpdateProxyOccluders()
+{
+    FSteamAudioProxyOccluders::FShapeArray Shapes;
+    Shapes.Reserve(ProxyOccluderComponents.Num() + PortalComponents.Num());
+
+    for (USteamAudioProxyOccluderComponent* ProxyOccluderComponent : ProxyOccluderComponents)
+    {
+        FSteamAudioProxyOccluderShape Shape;
+        if (ProxyOccluderComponent->GetShape(Shape))
         {
-            iplSceneRelease(&DynamicObjects[AssetName]);
+            Shapes.Add(Shape);
+        }
+    }
 
-            DynamicObjectRefCounts.Remove(AssetName);
-            DynamicObjects.Remove(AssetName);
+    // Doors are published alongside proxies, so opening or closing one takes effect on the next direct simulation.
+    for (USteamAudioPortalComponent* PortalComponent : PortalComponents)
+    {
+        FSteamAudioProxyOccluderShape Shape;
+        if (PortalComponent->GetShape(Shape))
+        {
+            Shapes.Add(Shape);
         }
     }
+
+    // Proxies are tested analytically, so unlike dynamic objects, moving them doesn't dirty the scene.
+    ProxyOccluders->SetShapes(MoveTemp(Shapes));
+}
+
+void FSteamAudioManager::QueryOcclusionAsync(TArray<FSteamAudioOcclusionQuery> Queries, TFunction<void(TArray<FSteamAudioOcclusionQueryResult>&&)> OnCompleted)
+{
+    check(IsInGameThread());
+
+    if (InitializedType() != EManagerInitReason::PLAYING)
+    {
+        OnCompleted(TArray<FSteamAudioOcclusionQueryResult>());
+        return;
+    }
+
+    QueryService->Submit(MoveTemp(Queries), ConvertVectorInverse(GetListenerCoordinates().origin), MoveTemp(OnCompleted));
 }
 
 void FSteamAudioManager::AddSource(USteamAudioSourceComponent* Source)
@@ -663,6 +988,18 @@ void FSteamAudioManager::RemoveListener(USteamAudioListenerComponent* Listener)
     Listeners.Remove(Listener);
 }
 
+FSteamAudioSimulationStats FSteamAudioManager::GetSimulationStats() const
+{
+    FScopeLock Lock(&SimulationStatsCriticalSection);
+    return SimulationStats;
+}
+
+void FSteamAudioManager::ResetSimulationStats()
+{
+    FScopeLock Lock(&SimulationStatsCriticalSection);
+    SimulationStats = FSteamAudioSimulationStats();
+}
+
 TStatId FSteamAudioManager::GetStatId() const
 {
     RETURN_QUICK_DECLARE_CYCLE_STAT(FSteamAudioManager, STATGROUP_Tickables);
@@ -673,14 +1010,68 @@ void FSteamAudioManager::Tick(float DeltaTime)
     if (InitializedType() != EManagerInitReason::PLAYING)
         return;
 
-    if (ThreadPool && ThreadPoolIdle)
+    UpdateDynamicObjects();
+    UpdateProxyOccluders();
+
+    // Add any static geometry that finished streaming in (or out) to the pending scene(s).
+    SceneStreamer->ApplyPendingChanges();
+    SceneStreamer->ReleaseRetiredGeometry();
+
+    // Start loading probe volumes near the listeners, and unload those that no longer fit in the memory budget.
+    if (SteamAudioSettings.bEnableProbeStreaming)
     {
-        iplSceneCommit(Scene);
+        TArray<FVector, TInlineAllocator<4>> ListenerPositions;
+        ListenerPositions.Add(ConvertVectorInverse(GetListenerCoordinates().origin));
+
+        for (USteamAudioListenerComponent* Listener : Listeners)
+        {
+            if (Listener->GetOwner())
+            {
+                ListenerPositions.Add(Listener->GetOwner()->GetActorLocation());
+            }
+        }
+
+        ProbeStreamer->Update(ListenerPositions);
+    }
+
+    // The current scene can't be replaced while the simulation thread or queries are tracing rays against it.
+    if (ThreadPool && ThreadPoolIdle && QueryService->IsIdle())
+    {
+        if (Scene->SwapBuffers())
+        {
+            iplSimulatorSetScene(Simulator, GetScene());
+            QueryService->SetScene(GetScene());
+        }
+
+        if (ReflectionScene && ReflectionScene->SwapBuffers())
+        {
+            iplSimulatorSetScene(ReflectionSimulator, GetReflectionScene());
+        }
+
+        ProbeStreamer->ApplyPendingChanges();
 
-        iplSimulatorSetScene(Simulator, Scene);
         iplSimulatorCommit(Simulator);
+
+        if (ReflectionSimulator)
+        {
+            iplSimulatorCommit(ReflectionSimulator);
+        }
+
+        ProxyOccluders->ReleaseRetiredShapes();
+        ProbeStreamer->ReleaseRetiredProbeBatches();
+    }
+
+    // The simulators no longer use the pending scene(s), so changes made since the last commit can be committed in
+    // the background.
+    Scene->CommitAsync();
+
+    if (ReflectionScene)
+    {
+        ReflectionScene->CommitAsync();
     }
 
+    double DirectStartTime = FPlatformTime::Seconds();
+
     IPLSimulationSettings SimulationSettings = GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
 
     IPLSimulationSharedInputs SharedInputs{};
@@ -715,6 +1106,16 @@ void FSteamAudioManager::Tick(float DeltaTime)
         Listener->UpdateOutputs(IPL_SIMULATIONFLAGS_DIRECT);
     }
 
+    {
+        FScopeLock Lock(&SimulationStatsCriticalSection);
+        SimulationStats.NumDirectUpdates++;
+        SimulationStats.DirectTime += FPlatformTime::Seconds() - DirectStartTime;
+    }
+
+    // All queries submitted since the last dispatch share a single batch. When tracing against the physics scene, the
+    // ray tracer already hits proxy occluders, so only doors are applied.
+    QueryService->Dispatch(ProxyOccluders->GetShapes(), IsUsingPhysicsScene());
+
     SimulationUpdateTimeElapsed += DeltaTime;
     if (SimulationUpdateTimeElapsed < SteamAudioSettings.SimulationUpdateInterval)
         return;
@@ -733,7 +1134,7 @@ void FSteamAudioManager::Tick(float DeltaTime)
             Listener->UpdateOutputs(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
         }
 
-        iplSimulatorSetSharedInputs(Simulator, static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING), &SharedInputs);
+        iplSimulatorSetSharedInputs(GetReflectionSimulator(), static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING), &SharedInputs);
 
         for (const auto& Source : Sources)
         {
@@ -745,10 +1146,23 @@ void FSteamAudioManager::Tick(float DeltaTime)
             Listener->SetInputs(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
         }
 
-        AsyncPool(*ThreadPool, [this]
+        AsyncPool(*ThreadPool, [this, RunSimulator = GetReflectionSimulator()]
         {
-            iplSimulatorRunReflections(Simulator);
-            iplSimulatorRunPathing(Simulator);
+            double StartTime = FPlatformTime::Seconds();
+            iplSimulatorRunReflections(RunSimulator);
+
+            double ReflectionsEndTime = FPlatformTime::Seconds();
+            iplSimulatorRunPathing(RunSimulator);
+
+            double PathingEndTime = FPlatformTime::Seconds();
+
+            {
+                FScopeLock Lock(&SimulationStatsCriticalSection);
+                SimulationStats.NumReflectionsUpdates++;
+                SimulationStats.ReflectionsTime += ReflectionsEndTime - StartTime;
+                SimulationStats.PathingTime += PathingEndTime - ReflectionsEndTime;
+            }
+
             ThreadPoolIdle = true;
         });
     }
@@ -18,13 +18,18 @@
 
 #include "SteamAudioModule.h"
 #include "Tickable.h"
+#include "Engine/StreamableManager.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
 #include "Misc/QueuedThreadPool.h"
+#include "SteamAudioDoubleBufferedScene.h"
+#include "SteamAudioOcclusionQuery.h"
 #include "SteamAudioSettings.h"
 
 class USteamAudioDynamicObjectComponent;
 class USteamAudioListenerComponent;
+class USteamAudioPortalComponent;
+class USteamAudioProxyOccluderComponent;
 class USteamAudioSourceComponent;
 
 namespace SteamAudio {
@@ -61,6 +66,11 @@ private:
 // ---------------------------------------------------------------------------------------------------------------------
 
 class FSimulationThreadRunnable;
+class FSteamAudioPhysicsRayTracer;
+class FSteamAudioProxyOccluders;
+class FSteamAudioQueryService;
+class FSteamAudioProbeStreamer;
+class FSteamAudioSceneStreamer;
 
 UENUM()
 enum class EManagerInitReason : uint8
@@ -72,6 +82,28 @@ enum class EManagerInitReason : uint8
     PLAYING
 };
 
+/**
+ * Time spent simulating, accumulated since the last call to FSteamAudioManager::ResetSimulationStats.
+ */
+struct FSteamAudioSimulationStats
+{
+    /** Number of times direct simulation was run. */
+    int32 NumDirectUpdates = 0;
+
+    /** Time spent on direct simulation on the game thread, including setting inputs and reading outputs for every
+        source and listener, in seconds. */
+    double DirectTime = 0.0;
+
+    /** Number of times reflections and pathing were simulated. */
+    int32 NumReflectionsUpdates = 0;
+
+    /** Time spent simulating reflections on the simulation thread, in seconds. */
+    double ReflectionsTime = 0.0;
+
+    /** Time spent simulating pathing on the simulation thread, in seconds. */
+    double PathingTime = 0.0;
+};
+
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnSteamAudioInitialized, EManagerInitReason)
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnSteamAudioShutDown, EManagerInitReason)
 
@@ -100,8 +132,18 @@ public:
 
     IPLContext GetContext() const { return Context; }
     IPLHRTF GetHRTF() const { return HRTF; }
-    IPLScene GetScene() const { return Scene; }
+    IPLScene GetScene() const { return Scene ? Scene->GetScene() : nullptr; }
     IPLSimulator GetSimulator() const { return Simulator; }
+    IPLScene GetReflectionScene() const { return ReflectionScene ? ReflectionScene->GetScene() : GetScene(); }
+    IPLSimulator GetReflectionSimulator() const { return ReflectionSimulator ? ReflectionSimulator : Simulator; }
+    TSharedPtr<FSteamAudioDoubleBufferedScene> GetDoubleBufferedScene() const { return Scene; }
+    TSharedPtr<FSteamAudioDoubleBufferedScene> GetDoubleBufferedReflectionScene() const { return ReflectionScene ? ReflectionScene : Scene; }
+    bool HasSeparateReflectionScene() const { return ReflectionScene.IsValid(); }
+    bool IsUsingPhysicsScene() const { return ActualSceneType == IPL_SCENETYPE_CUSTOM; }
+    FSteamAudioSceneStreamer& GetSceneStreamer() const { return *SceneStreamer; }
+    FSteamAudioProbeStreamer& GetProbeStreamer() const { return *ProbeStreamer; }
+    const FSteamAudioProxyOccluders& GetProxyOccluders() const { return *ProxyOccluders; }
+    FStreamableManager& GetStreamableManager() { return StreamableManager; }
     IPLCoordinateSpace3 GetListenerCoordinates() const;
     const FSteamAudioSettings& GetSteamAudioSettings() const { return SteamAudioSettings; }
     bool IsInitialized() const { return bInitializationSucceded; }
@@ -127,15 +169,58 @@ public:
     /** Returns the Steam Audio simulation settings to use while baking. */
     IPLSimulationSettings GetBakingSettings(IPLSimulationFlags Flags);
 
-    /** Creates an Instanced Mesh object for use by the given Steam Audio Dynamic Object component. If needed, loads
-        the geometry and material data into a Scene object before instantiation. If another component has already
-        loaded this data, we just reference it. */
-    IPLInstancedMesh LoadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent);
+    /** Returns the settings to use when creating scenes (including sub-scenes) compatible with the main scene. */
+    IPLSceneSettings GetSceneSettings() const;
+
+    /** Sets the world whose physics scene is used for ray tracing, if the Unreal Physics ray tracer is in use. Blocks
+        until the simulation thread is idle. */
+    void SetPhysicsWorld(const UWorld* World);
+
+    /** Instances the geometry of the given Steam Audio Dynamic Object component into the main scene, and returns the
+        handle of the instance (or INDEX_NONE on failure). If needed, loads the geometry and material data into a
+        Scene object before instantiation. If another component has already loaded this data, we just reference it. */
+    FSteamAudioDoubleBufferedScene::FInstanceHandle LoadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent);
+
+    /** Asynchronous version of LoadDynamicObject. The geometry and material data is loaded in the background and
+        deserialized on a worker thread. If another component is already loading the same data, both components share
+        a single load. OnLoaded is called on the game thread with the handle of the new instance (or INDEX_NONE on
+        failure), unless UnloadDynamicObject is called for this component first. Either way, UnloadDynamicObject must be
+        called for every call to this function. */
+    void LoadDynamicObjectAsync(USteamAudioDynamicObjectComponent* DynamicObjectComponent, TFunction<void(FSteamAudioDoubleBufferedScene::FInstanceHandle)> OnLoaded);
+
+    /** Instances the geometry of the given Steam Audio Dynamic Object component, whose data must already have been
+        loaded, into the reflection scene. Returns INDEX_NONE if no separate reflection scene is used. */
+    FSteamAudioDoubleBufferedScene::FInstanceHandle CreateDynamicObjectReflectionInstance(USteamAudioDynamicObjectComponent* DynamicObjectComponent);
 
     /** Releases the reference to the geometry and material data for the given Steam Audio Dynamic Mesh component.
         If the reference count reaches zero, the data is destroyed. */
     void UnloadDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent);
 
+    /** Registers a Steam Audio Dynamic Object component whose instance has been added to the main scene, so its
+        transform is kept up to date. */
+    void AddDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent);
+
+    /** Unregisters a Steam Audio Dynamic Object component before its instance is removed from the main scene. */
+    void RemoveDynamicObject(USteamAudioDynamicObjectComponent* DynamicObjectComponent);
+
+    /** Registers a Steam Audio Proxy Occluder component, so its shape is used for occlusion. */
+    void AddProxyOccluder(USteamAudioProxyOccluderComponent* ProxyOccluderComponent);
+
+    /** Unregisters a Steam Audio Proxy Occluder component. */
+    void RemoveProxyOccluder(USteamAudioProxyOccluderComponent* ProxyOccluderComponent);
+
+    /** Registers a Steam Audio Portal component, so its door is used for occlusion. */
+    void AddPortal(USteamAudioPortalComponent* PortalComponent);
+
+    /** Unregisters a Steam Audio Portal component. */
+    void RemovePortal(USteamAudioPortalComponent* PortalComponent);
+
+    /** Simulates occlusion and transmission between pairs of points, against the same geometry used for sources.
+        Queries submitted during a frame are run together in the background, and OnCompleted is called on the game
+        thread with one result per query, in order. If Steam Audio is not running, OnCompleted is called right away
+        with no results. */
+    void QueryOcclusionAsync(TArray<FSteamAudioOcclusionQuery> Queries, TFunction<void(TArray<FSteamAudioOcclusionQueryResult>&&)> OnCompleted);
+
     /** Registers a Steam Audio Source component for simulation. */
     void AddSource(USteamAudioSourceComponent* Source);
 
@@ -151,6 +236,24 @@ public:
     /** Unregisters a Steam Audio Listener component from simulation. */
     void RemoveListener(USteamAudioListenerComponent* Listener);
 
+    /** Returns the time spent simulating since the last reset. */
+    FSteamAudioSimulationStats GetSimulationStats() const;
+
+    /** Resets the time spent simulating. */
+    void ResetSimulationStats();
+
+    /** Returns true if reflections and pathing aren't currently being simulated. */
+    bool IsSimulationThreadIdle() const { return ThreadPoolIdle; }
+
+    /** Returns the number of times Steam Audio has been shut down. Async loads compare this before and after loading,
+        so objects created for an earlier initialization are released instead of being used. */
+    uint32 GetShutdownCount() const { return ShutdownCount; }
+
+    /** Called when an async load starts deserializing on a worker thread, and when it is done. Shutting down waits
+        for all such loads, since they use the devices and settings the scene(s) were created with. */
+    void BeginAsyncLoad() { NumAsyncLoads++; }
+    void EndAsyncLoad() { NumAsyncLoads--; }
+
 private:
     /** The scene type we were actually able to initialize. */
     IPLSceneType ActualSceneType;
@@ -176,12 +279,36 @@ private:
     /** The TrueAudio Next device. */
     IPLTrueAudioNextDevice TrueAudioNextDevice;
 
-    /** The global scene used for simulation. */
-    IPLScene Scene;
+    /** The global scene used for simulation. Shared with dynamic objects, which may outlive the manager's
+        initialization. */
+    TSharedPtr<FSteamAudioDoubleBufferedScene> Scene;
 
-    /** The Steam Audio Simulator object. */
+    /** The Steam Audio Simulator object. If a separate reflection scene is used, this only runs direct simulation. */
     IPLSimulator Simulator;
 
+    /** Simplified scene used for reflections and pathing, if enabled. Occlusion is always traced against the main
+        scene, so small details that matter for occlusion don't slow down reflection simulation. */
+    TSharedPtr<FSteamAudioDoubleBufferedScene> ReflectionScene;
+
+    /** Simulator that runs reflections and pathing against the reflection scene. Steam Audio only allows a single
+        scene per simulator, so this is separate from the main simulator. */
+    IPLSimulator ReflectionSimulator;
+
+    /** Traces rays against the physics scene, if the Unreal Physics ray tracer is in use. */
+    TUniquePtr<FSteamAudioPhysicsRayTracer> PhysicsRayTracer;
+
+    /** Shapes of the proxy occluders used for simulation. */
+    TUniquePtr<FSteamAudioProxyOccluders> ProxyOccluders;
+
+    /** Streams static geometry for (sub)levels in and out of the main scene. */
+    TUniquePtr<FSteamAudioSceneStreamer> SceneStreamer;
+
+    /** Streams probe batches in and out of the reflection simulator based on listener proximity. */
+    TUniquePtr<FSteamAudioProbeStreamer> ProbeStreamer;
+
+    /** Runs occlusion queries for gameplay code. */
+    TUniquePtr<FSteamAudioQueryService> QueryService;
+
     /** True if we've attempted to initialize Steam Audio. */
     EManagerInitReason InitializationAttempted;
 
@@ -197,9 +324,31 @@ private:
     /** Scenes referenced by each dynamic object that's currently loaded. */
     TMap<FString, IPLScene> DynamicObjects;
 
-    /** Reference counts for the scenes referenced by dynamic objects. */
+    /** Reference counts for the scenes referenced by dynamic objects, including components whose load is in flight. */
     TMap<FString, int> DynamicObjectRefCounts;
 
+    /** A component waiting for the data for a dynamic object to finish loading. */
+    struct FPendingDynamicObject
+    {
+        USteamAudioDynamicObjectComponent* Component;
+        TFunction<void(FSteamAudioDoubleBufferedScene::FInstanceHandle)> OnLoaded;
+    };
+
+    /** Components waiting for each dynamic object whose data is currently being loaded. */
+    TMap<FString, TArray<FPendingDynamicObject>> PendingDynamicObjects;
+
+    /** Used to load assets asynchronously. */
+    FStreamableManager StreamableManager;
+
+    /** Steam Audio Dynamic Object components whose instances are currently part of the main scene. */
+    TSet<USteamAudioDynamicObjectComponent*> DynamicObjectComponents;
+
+    /** Steam Audio Proxy Occluder components that are currently registered. */
+    TSet<USteamAudioProxyOccluderComponent*> ProxyOccluderComponents;
+
+    /** Steam Audio Portal components that are currently registered. */
+    TSet<USteamAudioPortalComponent*> PortalComponents;
+
     /** Steam Audio Source components that are currently registered for simulation. */
     TMap<uint32_t, USteamAudioSourceComponent*> Sources;
 
@@ -218,6 +367,31 @@ private:
     /** If true, the simulation thread is idle. */
     std::atomic<bool> ThreadPoolIdle;
 
+    /** Time spent simulating since the last reset. Updated by both the game thread and the simulation thread. */
+    FSteamAudioSimulationStats SimulationStats;
+
+    /** Guards SimulationStats. */
+    mutable FCriticalSection SimulationStatsCriticalSection;
+
+    /** Number of times Steam Audio has been shut down. */
+    std::atomic<uint32> ShutdownCount;
+
+    /** Number of async loads deserializing on worker threads. */
+    std::atomic<int32> NumAsyncLoads;
+
+    /** Instances the given sub-scene into the given scene (or the main scene) for the given dynamic object, and
+        returns the handle of the instance. */
+    FSteamAudioDoubleBufferedScene::FInstanceHandle CreateDynamicObjectInstance(IPLScene SubScene, USteamAudioDynamicObjectComponent* DynamicObjectComponent, FSteamAudioDoubleBufferedScene* TargetScene = nullptr);
+
+    /** Sends the transforms of all dynamic objects that have moved far enough to Steam Audio. */
+    void UpdateDynamicObjects();
+
+    /** Publishes the current shapes of all proxy occluders and doors. */
+    void UpdateProxyOccluders();
+
+    /** Called on the game thread when an async load started by LoadDynamicObjectAsync finishes. */
+    void OnDynamicObjectLoaded(const FString& AssetName, IPLScene SubScene);
+
     /** Called by Steam Audio, writes Steam Audio log messages to the Unreal log. */
     static void IPLCALL LogCallback(IPLLogLevel Level, IPLstring Message);
 
@@ -84,7 +84,9 @@ void FSteamAudioModule::StartupModule()
 #endif
 
     // Make sure the DLL is loaded.
-#if !PLATFORM_IOS
+#if STEAMAUDIO_STUB_PHONON
+    UE_LOG(LogSteamAudio, Warning, TEXT("Built with STEAMAUDIO_STUB_PHONON=1, using the stub Steam Audio implementation. Simulation and effects will have no audible result."));
+#elif !PLATFORM_IOS
     Library = FPlatformProcess::GetDllHandle(*LibraryPath);
     check(Library);
 #endif
@@ -110,6 +112,8 @@ void FSteamAudioModule::StartupModule()
 			WorldsHoldingManager.Remove(World);
 			if (WorldsHoldingManager.IsEmpty())
 				Manager->ShutDownSteamAudio();
+			else
+				UpdatePhysicsWorld();
 		}
 	});
 
@@ -120,6 +124,7 @@ void FSteamAudioModule::StartupModule()
 	    	if (WorldsHoldingManager.IsEmpty())
 	    		Manager->InitializeSteamAudio(EManagerInitReason::PLAYING);
 	    	WorldsHoldingManager.Add(World);
+	    	UpdatePhysicsWorld();
 	    }
     });
 	FAudioDeviceWorldDelegates::OnWorldUnregisteredWithAudioDevice.AddLambda([this](const UWorld* World, Audio::DeviceID DeviceID)
@@ -129,6 +134,8 @@ void FSteamAudioModule::StartupModule()
 			WorldsHoldingManager.Remove(World);
 			if (WorldsHoldingManager.IsEmpty())
 				Manager->ShutDownSteamAudio();
+			else
+				UpdatePhysicsWorld();
 		}
 	});
 
@@ -138,11 +145,27 @@ void FSteamAudioModule::StartupModule()
 void FSteamAudioModule::ShutdownModule()
 {
     // Unload the DLL.
-    FPlatformProcess::FreeDllHandle(Library);
+    if (Library)
+    {
+        FPlatformProcess::FreeDllHandle(Library);
+    }
 
     UE_LOG(LogSteamAudio, Log, TEXT("Shut down module SteamAudio."));
 }
 
+void FSteamAudioModule::UpdatePhysicsWorld()
+{
+    // Rays are traced against the first world that is still holding the manager.
+    const UWorld* PhysicsWorld = nullptr;
+    for (const UWorld* World : WorldsHoldingManager)
+    {
+        PhysicsWorld = World;
+        break;
+    }
+
+    Manager->SetPhysicsWorld(PhysicsWorld);
+}
+
 IAudioPluginFactory* FSteamAudioModule::GetPluginFactory(EAudioPlugin PluginType)
 {
     switch (PluginType)
@@ -0,0 +1,44 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioOcclusionQuery.h"
+#include "SteamAudioManager.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioOcclusionQueryAction
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioOcclusionQueryAction* USteamAudioOcclusionQueryAction::QueryOcclusion(UObject* WorldContextObject, const TArray<FSteamAudioOcclusionQuery>& Queries)
+{
+    USteamAudioOcclusionQueryAction* Action = NewObject<USteamAudioOcclusionQueryAction>();
+    Action->Queries = Queries;
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void USteamAudioOcclusionQueryAction::Activate()
+{
+    TWeakObjectPtr<USteamAudioOcclusionQueryAction> WeakThis(this);
+    SteamAudio::FSteamAudioModule::GetManager().QueryOcclusionAsync(MoveTemp(Queries), [WeakThis](TArray<FSteamAudioOcclusionQueryResult>&& Results)
+    {
+        USteamAudioOcclusionQueryAction* Action = WeakThis.Get();
+        if (!Action)
+            return;
+
+        Action->Completed.Broadcast(Results);
+        Action->SetReadyToDestroy();
+    });
+}
@@ -0,0 +1,175 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioPhysicsRayTracer.h"
+#include <limits>
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioSettings.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioPhysicsRayTracer
+// ---------------------------------------------------------------------------------------------------------------------
+
+const int32 FSteamAudioPhysicsRayTracer::MinRaysForParallelTrace = 64;
+
+FSteamAudioPhysicsRayTracer::FSteamAudioPhysicsRayTracer(const FSteamAudioSettings& Settings, const FSteamAudioProxyOccluders& InProxyOccluders)
+    : World(nullptr)
+    , ProxyOccluders(InProxyOccluders)
+    , TraceChannel(Settings.PhysicsTraceChannel)
+{
+    Materials.Add(Settings.DefaultMeshMaterial);
+
+    for (const auto& Pair : Settings.PhysicalMaterials)
+    {
+        MaterialIndices.Add(Pair.Key, Materials.Add(Pair.Value));
+    }
+}
+
+void FSteamAudioPhysicsRayTracer::InitSceneSettings(IPLSceneSettings& SceneSettings)
+{
+    SceneSettings.type = IPL_SCENETYPE_CUSTOM;
+    SceneSettings.closestHitCallback = ClosestHitCallback;
+    SceneSettings.anyHitCallback = AnyHitCallback;
+    SceneSettings.batchedClosestHitCallback = BatchedClosestHitCallback;
+    SceneSettings.batchedAnyHitCallback = BatchedAnyHitCallback;
+    SceneSettings.userData = this;
+}
+
+void FSteamAudioPhysicsRayTracer::ClosestHit(const IPLRay& Ray, float MinDistance, float MaxDistance, IPLHit& Hit, const FSteamAudioProxyOccluders::FShapeArray& ProxyShapes) const
+{
+    Hit.distance = std::numeric_limits<float>::infinity();
+    Hit.triangleIndex = -1;
+    Hit.objectIndex = -1;
+    Hit.materialIndex = -1;
+    Hit.material = nullptr;
+
+    FVector Start;
+    FVector End;
+    if (!GetTraceSegment(Ray, MinDistance, MaxDistance, Start, End))
+        return;
+
+    FVector Direction = ConvertVectorInverse(Ray.direction, false);
+    float TraceDistance = FVector::Dist(Start, End);
+
+    const UWorld* TraceWorld = World;
+    if (TraceWorld)
+    {
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SteamAudioClosestHit), true);
+        QueryParams.bReturnPhysicalMaterial = true;
+
+        FHitResult HitResult;
+        if (TraceWorld->LineTraceSingleByChannel(HitResult, Start, End, TraceChannel, QueryParams))
+        {
+            int32 MaterialIndex = MaterialIndices.FindRef(HitResult.PhysMaterial.Get());
+
+            Hit.distance = MinDistance + (HitResult.Distance / ConvertSteamAudioDistanceToUnreal(1.0f));
+            Hit.normal = ConvertVector(HitResult.ImpactNormal, false);
+            Hit.materialIndex = MaterialIndex;
+            Hit.material = const_cast<IPLMaterial*>(&Materials[MaterialIndex]);
+
+            TraceDistance = HitResult.Distance;
+        }
+    }
+
+    float ProxyDistance;
+    FVector ProxyNormal;
+    const IPLMaterial* ProxyMaterial = nullptr;
+    if (FSteamAudioProxyOccluders::ClosestHit(ProxyShapes, Start, Direction, TraceDistance, ProxyDistance, ProxyNormal, ProxyMaterial))
+    {
+        Hit.distance = MinDistance + (ProxyDistance / ConvertSteamAudioDistanceToUnreal(1.0f));
+        Hit.normal = ConvertVector(ProxyNormal, false);
+        Hit.materialIndex = -1;
+        Hit.material = const_cast<IPLMaterial*>(ProxyMaterial);
+    }
+}
+
+bool FSteamAudioPhysicsRayTracer::AnyHit(const IPLRay& Ray, float MinDistance, float MaxDistance, const FSteamAudioProxyOccluders::FShapeArray& ProxyShapes) const
+{
+    FVector Start;
+    FVector End;
+    if (!GetTraceSegment(Ray, MinDistance, MaxDistance, Start, End))
+        return false;
+
+    // Proxies are much cheaper to test than the physics scene.
+    if (FSteamAudioProxyOccluders::AnyHit(ProxyShapes, Start, End))
+        return true;
+
+    const UWorld* TraceWorld = World;
+    if (!TraceWorld)
+        return false;
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SteamAudioAnyHit), true);
+
+    return TraceWorld->LineTestByChannel(Start, End, TraceChannel, QueryParams);
+}
+
+bool FSteamAudioPhysicsRayTracer::GetTraceSegment(const IPLRay& Ray, float MinDistance, float MaxDistance, FVector& Start, FVector& End)
+{
+    if (MaxDistance <= MinDistance)
+        return false;
+
+    FVector Origin = ConvertVectorInverse(Ray.origin);
+    FVector Direction = ConvertVectorInverse(Ray.direction, false);
+
+    // Steam Audio may pass an infinite max distance; clamp it so the physics engine gets a finite segment.
+    float MaxTraceDistance = FMath::Min(MaxDistance, static_cast<float>(HALF_WORLD_MAX) / ConvertSteamAudioDistanceToUnreal(1.0f));
+
+    Start = Origin + Direction * ConvertSteamAudioDistanceToUnreal(MinDistance);
+    End = Origin + Direction * ConvertSteamAudioDistanceToUnreal(MaxTraceDistance);
+    return true;
+}
+
+void IPLCALL FSteamAudioPhysicsRayTracer::ClosestHitCallback(const IPLRay* Ray, IPLfloat32 MinDistance, IPLfloat32 MaxDistance, IPLHit* Hit, void* UserData)
+{
+    const FSteamAudioPhysicsRayTracer* RayTracer = static_cast<const FSteamAudioPhysicsRayTracer*>(UserData);
+    RayTracer->ClosestHit(*Ray, MinDistance, MaxDistance, *Hit, *RayTracer->ProxyOccluders.GetShapes());
+}
+
+void IPLCALL FSteamAudioPhysicsRayTracer::AnyHitCallback(const IPLRay* Ray, IPLfloat32 MinDistance, IPLfloat32 MaxDistance, IPLuint8* Occluded, void* UserData)
+{
+    const FSteamAudioPhysicsRayTracer* RayTracer = static_cast<const FSteamAudioPhysicsRayTracer*>(UserData);
+    *Occluded = RayTracer->AnyHit(*Ray, MinDistance, MaxDistance, *RayTracer->ProxyOccluders.GetShapes()) ? 1 : 0;
+}
+
+void IPLCALL FSteamAudioPhysicsRayTracer::BatchedClosestHitCallback(IPLint32 NumRays, const IPLRay* Rays, const IPLfloat32* MinDistances, const IPLfloat32* MaxDistances, IPLHit* Hits, void* UserData)
+{
+    const FSteamAudioPhysicsRayTracer* RayTracer = static_cast<const FSteamAudioPhysicsRayTracer*>(UserData);
+    FSteamAudioProxyOccluders::FShapeSnapshot ProxyShapes = RayTracer->ProxyOccluders.GetShapes();
+
+    // Scene queries only take a read lock on the physics scene, so a batch of rays can be traced in parallel.
+    ParallelFor(NumRays, [&](int32 i)
+    {
+        RayTracer->ClosestHit(Rays[i], MinDistances[i], MaxDistances[i], Hits[i], *ProxyShapes);
+    }, NumRays < MinRaysForParallelTrace);
+}
+
+void IPLCALL FSteamAudioPhysicsRayTracer::BatchedAnyHitCallback(IPLint32 NumRays, const IPLRay* Rays, const IPLfloat32* MinDistances, const IPLfloat32* MaxDistances, IPLuint8* Occluded, void* UserData)
+{
+    const FSteamAudioPhysicsRayTracer* RayTracer = static_cast<const FSteamAudioPhysicsRayTracer*>(UserData);
+    FSteamAudioProxyOccluders::FShapeSnapshot ProxyShapes = RayTracer->ProxyOccluders.GetShapes();
+
+    ParallelFor(NumRays, [&](int32 i)
+    {
+        Occluded[i] = RayTracer->AnyHit(Rays[i], MinDistances[i], MaxDistances[i], *ProxyShapes) ? 1 : 0;
+    }, NumRays < MinRaysForParallelTrace);
+}
+
+}
@@ -0,0 +1,90 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+#include "Engine/EngineTypes.h"
+#include "SteamAudioProxyOccluders.h"
+
+class UPhysicalMaterial;
+
+namespace SteamAudio {
+
+struct FSteamAudioSettings;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioPhysicsRayTracer
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Implements the ray tracing callbacks for a custom (IPL_SCENETYPE_CUSTOM) scene by tracing rays against the
+ * collision geometry in a world's physics scene. This avoids keeping a second copy of the level's geometry in memory
+ * for Steam Audio, and means that no geometry needs to be exported. Does not depend on the audio engine, so it can be
+ * used with any world that has collision, including one created without rendering or audio. Proxy occluders are
+ * tested alongside the physics scene, and hit with their own material.
+ */
+class STEAMAUDIO_API FSteamAudioPhysicsRayTracer
+{
+public:
+    FSteamAudioPhysicsRayTracer(const FSteamAudioSettings& Settings, const FSteamAudioProxyOccluders& InProxyOccluders);
+
+    /** Sets the world whose physics scene we trace rays against. Until this is called, nothing is hit. The caller
+        must make sure no ray tracing callbacks are running while the world is being changed. */
+    void SetWorld(const UWorld* InWorld) { World = InWorld; }
+
+    const UWorld* GetWorld() const { return World; }
+
+    /** Fills in the callbacks and user data of the given scene settings to use this ray tracer. The ray tracer must
+        outlive any scene created using these settings. */
+    void InitSceneSettings(IPLSceneSettings& SceneSettings);
+
+    /** Returns the closest hit along the given ray interval, against the physics scene and the given proxy shapes. */
+    void ClosestHit(const IPLRay& Ray, float MinDistance, float MaxDistance, IPLHit& Hit, const FSteamAudioProxyOccluders::FShapeArray& ProxyShapes) const;
+
+    /** Returns true if anything is hit along the given ray interval, in the physics scene or the given proxy shapes. */
+    bool AnyHit(const IPLRay& Ray, float MinDistance, float MaxDistance, const FSteamAudioProxyOccluders::FShapeArray& ProxyShapes) const;
+
+private:
+    /** The world whose physics scene we trace rays against. */
+    std::atomic<const UWorld*> World;
+
+    /** Proxy occluders to test in addition to the physics scene. */
+    const FSteamAudioProxyOccluders& ProxyOccluders;
+
+    /** The collision channel to trace rays on. */
+    ECollisionChannel TraceChannel;
+
+    /** Steam Audio materials for the physical materials we know about. Index 0 is the default material. */
+    TArray<IPLMaterial> Materials;
+
+    /** Index into Materials for each physical material we know about. */
+    TMap<const UPhysicalMaterial*, int32> MaterialIndices;
+
+    /** Minimum number of rays in a batch before we trace them in parallel. */
+    static const int32 MinRaysForParallelTrace;
+
+    /** Converts a ray interval in Steam Audio's coordinate system to a line segment in Unreal's coordinate system.
+        Returns false if the interval is empty. */
+    static bool GetTraceSegment(const IPLRay& Ray, float MinDistance, float MaxDistance, FVector& Start, FVector& End);
+
+    static void IPLCALL ClosestHitCallback(const IPLRay* Ray, IPLfloat32 MinDistance, IPLfloat32 MaxDistance, IPLHit* Hit, void* UserData);
+    static void IPLCALL AnyHitCallback(const IPLRay* Ray, IPLfloat32 MinDistance, IPLfloat32 MaxDistance, IPLuint8* Occluded, void* UserData);
+    static void IPLCALL BatchedClosestHitCallback(IPLint32 NumRays, const IPLRay* Rays, const IPLfloat32* MinDistances, const IPLfloat32* MaxDistances, IPLHit* Hits, void* UserData);
+    static void IPLCALL BatchedAnyHitCallback(IPLint32 NumRays, const IPLRay* Rays, const IPLfloat32* MinDistances, const IPLfloat32* MaxDistances, IPLuint8* Occluded, void* UserData);
+};
+
+}
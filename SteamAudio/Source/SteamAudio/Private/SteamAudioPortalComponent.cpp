@@ -0,0 +1,104 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioPortalComponent.h"
+#include "GameFramework/Actor.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioProxyOccluders.h"
+#include "SteamAudioSettings.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioPortalComponent
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioPortalComponent::USteamAudioPortalComponent()
+    : Extents(50.0f, 10.0f, 100.0f)
+    , OpenFactor(0.0f)
+    , OpenAngle(90.0f)
+    , OpenDistance(100.0f)
+    , Material()
+    , DoorMaterial{}
+    , ClosedTransform(FTransform::Identity)
+{
+    // Doors are read in a single pass by the Steam Audio Manager, so we don't need to tick.
+    bAutoActivate = true;
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+bool USteamAudioPortalComponent::GetShape(SteamAudio::FSteamAudioProxyOccluderShape& OutShape) const
+{
+    FTransform OpeningTransform = GetClosedWorldTransform();
+
+    // How far the door has swung or slid away from where it was when closed.
+    FTransform DoorOffset = GetComponentTransform().GetRelativeTransform(OpeningTransform);
+
+    float Openness = FMath::Clamp(OpenFactor, 0.0f, 1.0f);
+    if (OpenAngle > 0.0f)
+    {
+        Openness = FMath::Max(Openness, FMath::RadiansToDegrees(DoorOffset.GetRotation().AngularDistance(FQuat::Identity)) / OpenAngle);
+    }
+    if (OpenDistance > 0.0f)
+    {
+        Openness = FMath::Max(Openness, DoorOffset.GetLocation().Size() * OpeningTransform.GetScale3D().GetAbsMax() / OpenDistance);
+    }
+
+    float Opacity = 1.0f - FMath::Min(Openness, 1.0f);
+    if (Opacity <= 0.0f)
+        return false;
+
+    OutShape.Type = EProxyOccluderShape::BOX;
+    OutShape.Transform = FTransform(OpeningTransform.GetRotation(), OpeningTransform.GetLocation());
+    OutShape.Extents = Extents * OpeningTransform.GetScale3D().GetAbs();
+    OutShape.HalfLength = 0.0f;
+    OutShape.BoundingRadius = OutShape.Extents.Size();
+    OutShape.Material = DoorMaterial;
+    OutShape.Opacity = Opacity;
+    OutShape.bPortal = true;
+
+    return true;
+}
+
+void USteamAudioPortalComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+    if (Manager.InitializedType() != SteamAudio::EManagerInitReason::PLAYING)
+        return;
+
+    DoorMaterial = Material.IsAsset() ? GetDefault<USteamAudioSettings>()->GetMaterialForAsset(Material) : Manager.GetSteamAudioSettings().DefaultMeshMaterial;
+
+    // The door is closed now, so this is where the opening is. Anchoring it to whatever the door is attached to keeps
+    // it in place as the door moves, but lets it follow the frame if the frame itself moves.
+    const AActor* Owner = GetOwner();
+    Anchor = (Owner && Owner->GetRootComponent()) ? Owner->GetRootComponent()->GetAttachParent() : nullptr;
+    ClosedTransform = Anchor.IsValid() ? GetComponentTransform().GetRelativeTransform(Anchor->GetComponentTransform()) : GetComponentTransform();
+
+    Manager.AddPortal(this);
+}
+
+FTransform USteamAudioPortalComponent::GetClosedWorldTransform() const
+{
+    const USceneComponent* AnchorComponent = Anchor.Get();
+    return AnchorComponent ? ClosedTransform * AnchorComponent->GetComponentTransform() : ClosedTransform;
+}
+
+void USteamAudioPortalComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    SteamAudio::FSteamAudioModule::GetManager().RemovePortal(this);
+
+    Super::EndPlay(EndPlayReason);
+}
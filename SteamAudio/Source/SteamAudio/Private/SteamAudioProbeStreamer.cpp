@@ -0,0 +1,318 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioProbeStreamer.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioProbeVolume.h"
+#include "SteamAudioScene.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioProbeStreamer
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioProbeStreamer::FSteamAudioProbeStreamer(FSteamAudioManager& InManager)
+    : Manager(InManager)
+    , bOverBudget(false)
+{}
+
+FSteamAudioProbeStreamer::~FSteamAudioProbeStreamer()
+{
+    check(Volumes.Num() == 0);
+    check(PendingRemovals.Num() == 0);
+    check(RetiredProbeBatches.Num() == 0);
+}
+
+void FSteamAudioProbeStreamer::AddVolume(ASteamAudioProbeVolume* ProbeVolume)
+{
+    check(IsInGameThread());
+    check(ProbeVolume);
+
+    if (!ProbeVolume->Asset.IsAsset())
+        return;
+
+    uint32 ActorId = ProbeVolume->GetUniqueID();
+    if (Volumes.Contains(ActorId))
+        return;
+
+    TSharedPtr<FStreamedProbeVolume> Volume = MakeShared<FStreamedProbeVolume>();
+    Volume->ProbeVolume = ProbeVolume;
+    Volume->Asset = ProbeVolume->Asset;
+    Volume->Bounds = ProbeVolume->GetComponentsBoundingBox(true);
+    Volume->Size = ProbeVolume->DataSize;
+
+    Volumes.Add(ActorId, Volume);
+}
+
+void FSteamAudioProbeStreamer::RemoveVolume(ASteamAudioProbeVolume* ProbeVolume)
+{
+    check(IsInGameThread());
+    check(ProbeVolume);
+
+    TSharedPtr<FStreamedProbeVolume> Volume;
+    if (!Volumes.RemoveAndCopyValue(ProbeVolume->GetUniqueID(), Volume))
+        return;
+
+    Unload(*Volume);
+}
+
+void FSteamAudioProbeStreamer::Update(TArrayView<const FVector> ListenerPositions)
+{
+    check(IsInGameThread());
+
+    const FSteamAudioSettings& Settings = Manager.GetSteamAudioSettings();
+    const double StreamingDistance = ConvertSteamAudioDistanceToUnreal(Settings.ProbeStreamingDistance);
+    const int64 MemoryBudget = static_cast<int64>(Settings.ProbeStreamingMemoryBudget) * 1024 * 1024;
+    const double Now = FPlatformTime::Seconds();
+
+    TArray<TSharedPtr<FStreamedProbeVolume>> VolumesToLoad;
+
+    for (auto& It : Volumes)
+    {
+        FStreamedProbeVolume& Volume = *It.Value;
+
+        Volume.DistanceSquared = TNumericLimits<double>::Max();
+        for (const FVector& ListenerPosition : ListenerPositions)
+        {
+            Volume.DistanceSquared = FMath::Min<double>(Volume.DistanceSquared, Volume.Bounds.ComputeSquaredDistanceToPoint(ListenerPosition));
+        }
+
+        if (Volume.DistanceSquared > StreamingDistance * StreamingDistance)
+            continue;
+
+        Volume.LastUsedTime = Now;
+
+        if (Volume.State == EState::UNLOADED && !Volume.bLoadFailed)
+        {
+            VolumesToLoad.Add(It.Value);
+        }
+    }
+
+    // Unload probe volumes until back within the budget, in case it was exceeded by probe volumes that were near
+    // listeners at the time.
+    int64 ResidentSize = GetResidentSize();
+    while (MemoryBudget > 0 && ResidentSize > MemoryBudget && UnloadLeastRecentlyUsed())
+    {
+        ResidentSize = GetResidentSize();
+    }
+
+    VolumesToLoad.Sort([](const TSharedPtr<FStreamedProbeVolume>& A, const TSharedPtr<FStreamedProbeVolume>& B)
+    {
+        return A->DistanceSquared < B->DistanceSquared;
+    });
+
+    bool bFitsInBudget = true;
+    for (const TSharedPtr<FStreamedProbeVolume>& Volume : VolumesToLoad)
+    {
+        if (MemoryBudget > 0)
+        {
+            while (ResidentSize + Volume->Size > MemoryBudget && UnloadLeastRecentlyUsed())
+            {
+                ResidentSize = GetResidentSize();
+            }
+
+            if (ResidentSize + Volume->Size > MemoryBudget)
+            {
+                bFitsInBudget = false;
+                continue;
+            }
+        }
+
+        StartLoad(Volume);
+        ResidentSize += Volume->Size;
+    }
+
+    if (!bFitsInBudget && !bOverBudget)
+    {
+        UE_LOG(LogSteamAudio, Warning, TEXT("Probe volumes near listeners exceed the probe streaming memory budget of %d MB. Some will not be loaded."),
+            Settings.ProbeStreamingMemoryBudget);
+    }
+
+    bOverBudget = !bFitsInBudget;
+}
+
+void FSteamAudioProbeStreamer::ApplyPendingChanges()
+{
+    check(IsInGameThread());
+
+    IPLSimulator Simulator = Manager.GetReflectionSimulator();
+
+    for (IPLProbeBatch ProbeBatch : PendingRemovals)
+    {
+        iplSimulatorRemoveProbeBatch(Simulator, ProbeBatch);
+        RetiredProbeBatches.Add(ProbeBatch);
+    }
+
+    PendingRemovals.Reset();
+
+    for (auto& It : Volumes)
+    {
+        FStreamedProbeVolume& Volume = *It.Value;
+        if (Volume.State != EState::LOADED)
+            continue;
+
+        iplSimulatorAddProbeBatch(Simulator, Volume.ProbeBatch);
+        Volume.State = EState::ADDED;
+
+        // Sources look up pathing probes through the probe volume.
+        if (ASteamAudioProbeVolume* ProbeVolume = Volume.ProbeVolume.Get())
+        {
+            ProbeVolume->ProbeBatch = Volume.ProbeBatch;
+        }
+    }
+}
+
+void FSteamAudioProbeStreamer::ReleaseRetiredProbeBatches()
+{
+    check(IsInGameThread());
+
+    for (IPLProbeBatch& ProbeBatch : RetiredProbeBatches)
+    {
+        iplProbeBatchRelease(&ProbeBatch);
+    }
+
+    RetiredProbeBatches.Reset();
+}
+
+void FSteamAudioProbeStreamer::Reset()
+{
+    // The manager is also shut down from worker threads after exporting or baking, in which case nothing was ever
+    // streamed in.
+    if (Volumes.Num() == 0 && PendingRemovals.Num() == 0 && RetiredProbeBatches.Num() == 0)
+        return;
+
+    check(IsInGameThread());
+
+    for (auto& It : Volumes)
+    {
+        Unload(*It.Value);
+    }
+
+    Volumes.Empty();
+
+    ApplyPendingChanges();
+    ReleaseRetiredProbeBatches();
+
+    bOverBudget = false;
+}
+
+void FSteamAudioProbeStreamer::StartLoad(const TSharedPtr<FStreamedProbeVolume>& Volume)
+{
+    check(Volume->State == EState::UNLOADED);
+
+    Volume->State = EState::LOADING;
+    uint32 LoadId = ++Volume->LoadId;
+
+    TArray<IPLBakedDataIdentifier> LayersToUnload;
+    if (ASteamAudioProbeVolume* ProbeVolume = Volume->ProbeVolume.Get())
+    {
+        LayersToUnload = ProbeVolume->GetLayersToUnload(Manager.GetSteamAudioSettings());
+    }
+
+    TWeakPtr<FStreamedProbeVolume> WeakVolume = Volume;
+    LoadProbeBatchFromAssetAsync(Volume->Asset, Manager.GetContext(), [WeakVolume, LoadId](IPLProbeBatch LoadedProbeBatch)
+    {
+        // The probe volume may have been unloaded, or stopped streaming, while the probe batch was loading.
+        TSharedPtr<FStreamedProbeVolume> Volume = WeakVolume.Pin();
+        if (!Volume || Volume->LoadId != LoadId || Volume->State != EState::LOADING)
+        {
+            iplProbeBatchRelease(&LoadedProbeBatch);
+            return;
+        }
+
+        if (!LoadedProbeBatch)
+        {
+            Volume->State = EState::UNLOADED;
+            Volume->bLoadFailed = true;
+            return;
+        }
+
+        Volume->ProbeBatch = LoadedProbeBatch;
+        Volume->State = EState::LOADED;
+    }, MoveTemp(LayersToUnload));
+}
+
+void FSteamAudioProbeStreamer::Unload(FStreamedProbeVolume& Volume)
+{
+    switch (Volume.State)
+    {
+    case EState::LOADING:
+        ++Volume.LoadId;
+        break;
+
+    case EState::LOADED:
+        RetiredProbeBatches.Add(Volume.ProbeBatch);
+        break;
+
+    case EState::ADDED:
+        if (ASteamAudioProbeVolume* ProbeVolume = Volume.ProbeVolume.Get())
+        {
+            ProbeVolume->ProbeBatch = nullptr;
+        }
+
+        PendingRemovals.Add(Volume.ProbeBatch);
+        break;
+
+    default:
+        break;
+    }
+
+    Volume.ProbeBatch = nullptr;
+    Volume.State = EState::UNLOADED;
+}
+
+int64 FSteamAudioProbeStreamer::GetResidentSize() const
+{
+    // Probe volumes that are loading count towards the budget, since they will be loaded soon.
+    int64 ResidentSize = 0;
+    for (const auto& It : Volumes)
+    {
+        if (It.Value->State != EState::UNLOADED)
+        {
+            ResidentSize += It.Value->Size;
+        }
+    }
+
+    return ResidentSize;
+}
+
+bool FSteamAudioProbeStreamer::UnloadLeastRecentlyUsed()
+{
+    const double StreamingDistance = ConvertSteamAudioDistanceToUnreal(Manager.GetSteamAudioSettings().ProbeStreamingDistance);
+
+    FStreamedProbeVolume* LeastRecentlyUsed = nullptr;
+    for (auto& It : Volumes)
+    {
+        FStreamedProbeVolume& Volume = *It.Value;
+        if (Volume.State == EState::UNLOADED || Volume.DistanceSquared <= StreamingDistance * StreamingDistance)
+            continue;
+
+        if (!LeastRecentlyUsed || Volume.LastUsedTime < LeastRecentlyUsed->LastUsedTime)
+        {
+            LeastRecentlyUsed = &Volume;
+        }
+    }
+
+    if (!LeastRecentlyUsed)
+        return false;
+
+    Unload(*LeastRecentlyUsed);
+    return true;
+}
+
+}
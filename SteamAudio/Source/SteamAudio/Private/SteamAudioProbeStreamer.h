@@ -0,0 +1,141 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+
+class ASteamAudioProbeVolume;
+
+namespace SteamAudio {
+
+class FSteamAudioManager;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioProbeStreamer
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Streams the probe batches of probe volumes in and out of the reflection simulator based on how close they are to
+ * the listeners. Probe volumes within the streaming distance of a listener are loaded asynchronously, nearest first,
+ * and added to the simulator the next time the manager commits it. Probe volumes stay loaded after listeners move away,
+ * until the memory budget is exceeded, at which point those used least recently are removed. Since Steam Audio can't
+ * split a probe batch, large probe volumes should be split into smaller probe volumes in the editor, each of which is
+ * streamed separately.
+ */
+class FSteamAudioProbeStreamer
+{
+public:
+    FSteamAudioProbeStreamer(FSteamAudioManager& InManager);
+
+    ~FSteamAudioProbeStreamer();
+
+    /** Starts streaming the given probe volume. Its probe batch is loaded once a listener comes near it. */
+    void AddVolume(ASteamAudioProbeVolume* ProbeVolume);
+
+    /** Stops streaming the given probe volume. Its probe batch is removed from the simulator at the next commit. */
+    void RemoveVolume(ASteamAudioProbeVolume* ProbeVolume);
+
+    /** Starts loading probe volumes near the given listener positions, and unloads probe volumes that are least
+        recently used to stay within the memory budget. Call on the game thread. */
+    void Update(TArrayView<const FVector> ListenerPositions);
+
+    /** Adds probe batches that have finished loading to the simulator, and removes unloaded ones. The changes take
+        effect once the simulator has been committed. Call on the game thread, while no simulation is running. */
+    void ApplyPendingChanges();
+
+    /** Releases probe batches that were removed from the simulator by the last call to ApplyPendingChanges. Call once
+        the simulator has been committed. */
+    void ReleaseRetiredProbeBatches();
+
+    /** Cancels all in-flight loads, and removes all probe batches from the simulator. Call before releasing the
+        simulator. */
+    void Reset();
+
+private:
+    /** Streaming state of a probe volume. */
+    enum class EState
+    {
+        UNLOADED,
+        LOADING,
+        LOADED,
+        ADDED,
+    };
+
+    /** A probe volume being streamed. */
+    struct FStreamedProbeVolume
+    {
+        /** The probe volume. */
+        TWeakObjectPtr<ASteamAudioProbeVolume> ProbeVolume;
+
+        /** The asset containing the serialized probe batch. */
+        FSoftObjectPath Asset;
+
+        /** World-space bounds of the probe volume. */
+        FBox Bounds{ForceInit};
+
+        /** Size (in bytes) of the probe batch, including baked data. */
+        int64 Size = 0;
+
+        /** Current streaming state. */
+        EState State = EState::UNLOADED;
+
+        /** The probe batch, once loaded. */
+        IPLProbeBatch ProbeBatch = nullptr;
+
+        /** Incremented whenever a load is started or cancelled, so results of cancelled loads can be discarded. */
+        uint32 LoadId = 0;
+
+        /** True if the last load failed, in which case the probe volume isn't loaded again. */
+        bool bLoadFailed = false;
+
+        /** Squared distance to the nearest listener, as of the last update. */
+        double DistanceSquared = 0.0;
+
+        /** Time (in seconds) at which a listener was last within the streaming distance. */
+        double LastUsedTime = 0.0;
+    };
+
+    /** Starts loading the probe batch for the given probe volume. */
+    void StartLoad(const TSharedPtr<FStreamedProbeVolume>& Volume);
+
+    /** Cancels any in-flight load for the given probe volume, and schedules its probe batch for removal. */
+    void Unload(FStreamedProbeVolume& Volume);
+
+    /** Returns the total size (in bytes) of probe batches that are loaded or loading. */
+    int64 GetResidentSize() const;
+
+    /** Unloads the probe volume that is loaded but not near a listener, and was used least recently. Returns false if
+        there is no such probe volume. */
+    bool UnloadLeastRecentlyUsed();
+
+    /** The manager that owns this object. */
+    FSteamAudioManager& Manager;
+
+    /** All probe volumes being streamed, indexed by actor id. */
+    TMap<uint32, TSharedPtr<FStreamedProbeVolume>> Volumes;
+
+    /** Probe batches that have been unloaded, and must be removed from the simulator at the next commit. */
+    TArray<IPLProbeBatch> PendingRemovals;
+
+    /** Probe batches that have been removed from the simulator (or never added), and must be released. */
+    TArray<IPLProbeBatch> RetiredProbeBatches;
+
+    /** True if the probe volumes near listeners didn't fit in the memory budget as of the last update. */
+    bool bOverBudget;
+};
+
+}
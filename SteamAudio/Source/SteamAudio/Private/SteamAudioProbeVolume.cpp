@@ -16,15 +16,225 @@
 
 #include "SteamAudioProbeVolume.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Components/PrimitiveComponent.h"
+#include "SteamAudioBakedListenerComponent.h"
+#include "SteamAudioBakedSourceComponent.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioManager.h"
 #include "SteamAudioProbeComponent.h"
+#include "SteamAudioProbeStreamer.h"
 #include "SteamAudioScene.h"
 #include "SteamAudioSerializedObject.h"
 #include "SteamAudioStaticMeshActor.h"
 
 
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Adaptive Probe Generation
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Height (in centimeters) of the cells used to separate probes on different floors. */
+static const float AdaptiveProbeFloorHeight = 250.0f;
+
+/** Complexity above which a cell is refined. */
+static const float AdaptiveProbeRefinementThreshold = 0.25f;
+
+/**
+ * Selects probes for adaptive probe generation from probes generated using uniform floor placement with the fine
+ * spacing. Probes are grouped into cells of the coarse spacing, and each cell keeps the probe closest to its centroid.
+ * Cells are then refined (i.e., keep all their probes) in decreasing order of complexity until the probe budget is
+ * reached. A cell's complexity is the fraction of it that has no probes because floor is missing or blocked by walls
+ * and obstacles, plus the change in floor height across it relative to the height of a floor.
+ */
+static void SelectAdaptiveProbes(IPLProbeArray ProbeArray, const FBox& Bounds, float CoarseSpacing, float FineSpacing,
+    int32 MaxProbes, TArray<IPLSphere>& OutProbes)
+{
+    struct FCell
+    {
+        TArray<int32> Probes;
+        FVector Centroid = FVector::ZeroVector;
+        float MinHeight = TNumericLimits<float>::Max();
+        float MaxHeight = TNumericLimits<float>::Lowest();
+        float Complexity = 0.0f;
+    };
+
+    const float CoarseCellSize = ConvertSteamAudioDistanceToUnreal(CoarseSpacing);
+    const float FineCellSize = ConvertSteamAudioDistanceToUnreal(FineSpacing);
+
+    int NumCandidates = iplProbeArrayGetNumProbes(ProbeArray);
+
+    TArray<FVector> Positions;
+    Positions.SetNumUninitialized(NumCandidates);
+
+    TMap<FIntVector, FCell> Cells;
+    for (int i = 0; i < NumCandidates; ++i)
+    {
+        FVector Position = ConvertVectorInverse(iplProbeArrayGetProbe(ProbeArray, i).center);
+        Positions[i] = Position;
+
+        FIntVector Key(FMath::FloorToInt((Position.X - Bounds.Min.X) / CoarseCellSize),
+            FMath::FloorToInt((Position.Y - Bounds.Min.Y) / CoarseCellSize),
+            FMath::FloorToInt(Position.Z / AdaptiveProbeFloorHeight));
+
+        FCell& Cell = Cells.FindOrAdd(Key);
+        Cell.Probes.Add(i);
+        Cell.Centroid += Position;
+        Cell.MinHeight = FMath::Min(Cell.MinHeight, static_cast<float>(Position.Z));
+        Cell.MaxHeight = FMath::Max(Cell.MaxHeight, static_cast<float>(Position.Z));
+    }
+
+    TArray<int32> Selected;
+    TArray<FCell*> CellsToRefine;
+
+    for (auto& It : Cells)
+    {
+        FCell& Cell = It.Value;
+        Cell.Centroid /= Cell.Probes.Num();
+
+        // Cells along the edge of the volume are only partly inside it, so only count the part that is.
+        float MinX = FMath::Max(Bounds.Min.X, Bounds.Min.X + It.Key.X * CoarseCellSize);
+        float MaxX = FMath::Min(Bounds.Max.X, Bounds.Min.X + (It.Key.X + 1) * CoarseCellSize);
+        float MinY = FMath::Max(Bounds.Min.Y, Bounds.Min.Y + It.Key.Y * CoarseCellSize);
+        float MaxY = FMath::Min(Bounds.Max.Y, Bounds.Min.Y + (It.Key.Y + 1) * CoarseCellSize);
+        float ExpectedProbes = FMath::Max(1.0f, ((MaxX - MinX) * (MaxY - MinY)) / (FineCellSize * FineCellSize));
+
+        float MissingFraction = FMath::Clamp(1.0f - Cell.Probes.Num() / ExpectedProbes, 0.0f, 1.0f);
+        float HeightChange = (Cell.MaxHeight - Cell.MinHeight) / AdaptiveProbeFloorHeight;
+        Cell.Complexity = MissingFraction + HeightChange;
+
+        int32 CoarseProbe = Cell.Probes[0];
+        for (int32 Probe : Cell.Probes)
+        {
+            if (FVector::DistSquared(Positions[Probe], Cell.Centroid) < FVector::DistSquared(Positions[CoarseProbe], Cell.Centroid))
+            {
+                CoarseProbe = Probe;
+            }
+        }
+
+        Selected.Add(CoarseProbe);
+
+        if (Cell.Probes.Num() > 1 && Cell.Complexity >= AdaptiveProbeRefinementThreshold)
+        {
+            Cell.Probes.Remove(CoarseProbe);
+            CellsToRefine.Add(&Cell);
+        }
+    }
+
+    if (MaxProbes > 0 && Selected.Num() > MaxProbes)
+    {
+        UE_LOG(LogSteamAudio, Warning, TEXT("Adaptive probe generation needs %d probes at %.2f m spacing, which exceeds the limit of %d."),
+            Selected.Num(), CoarseSpacing, MaxProbes);
+    }
+
+    CellsToRefine.Sort([](const FCell& A, const FCell& B) { return A.Complexity > B.Complexity; });
+
+    int NumCellsRefined = 0;
+    for (FCell* Cell : CellsToRefine)
+    {
+        if (MaxProbes > 0 && Selected.Num() + Cell->Probes.Num() > MaxProbes)
+            continue;
+
+        Selected.Append(Cell->Probes);
+        ++NumCellsRefined;
+    }
+
+    // Keep probes in the order in which they were generated, so regenerating gives the same probe batch.
+    Selected.Sort();
+
+    OutProbes.Empty(Selected.Num());
+    for (int32 Probe : Selected)
+    {
+        OutProbes.Add(iplProbeArrayGetProbe(ProbeArray, Probe));
+    }
+
+    UE_LOG(LogSteamAudio, Log, TEXT("Adaptive probe generation kept %d of %d probes (%d of %d cells refined)."),
+        OutProbes.Num(), NumCandidates, NumCellsRefined, Cells.Num());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Probe Generation
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Settings and results of probe generation for a single probe volume. */
+struct FProbeGenerationJob
+{
+    IPLProbeGenerationParams Params{};
+    bool bAdaptive = false;
+    float CoarseSpacing = 0.0f;
+    float FineSpacing = 0.0f;
+    int32 MaxProbes = 0;
+    FBox Bounds{ForceInit};
+
+    /** The generated probes. */
+    TArray<IPLSphere> Probes;
+
+    /** The generated probe batch, serialized. nullptr if probe generation failed. */
+    IPLSerializedObject SerializedObject = nullptr;
+};
+
+/** Generates probes for a single probe volume, against a committed scene. May be called from any thread. */
+static void GenerateProbeBatch(IPLContext Context, IPLScene Scene, FProbeGenerationJob& Job)
+{
+    // Create a probe array and generate probes in it.
+    IPLProbeArray ProbeArray = nullptr;
+    IPLerror Status = iplProbeArrayCreate(Context, &ProbeArray);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create probe array. [%d]"), Status);
+        return;
+    }
+
+    iplProbeArrayGenerateProbes(ProbeArray, Scene, &Job.Params);
+
+    if (Job.bAdaptive)
+    {
+        SelectAdaptiveProbes(ProbeArray, Job.Bounds, Job.CoarseSpacing, Job.FineSpacing, Job.MaxProbes, Job.Probes);
+    }
+    else
+    {
+        Job.Probes.SetNumUninitialized(iplProbeArrayGetNumProbes(ProbeArray));
+        for (int i = 0; i < Job.Probes.Num(); ++i)
+        {
+            Job.Probes[i] = iplProbeArrayGetProbe(ProbeArray, i);
+        }
+    }
+
+    iplProbeArrayRelease(&ProbeArray);
+
+    // Create a probe batch and add the generated probes to it.
+    IPLProbeBatch ProbeBatch = nullptr;
+    Status = iplProbeBatchCreate(Context, &ProbeBatch);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create probe batch. [%d]"), Status);
+        return;
+    }
+
+    for (const IPLSphere& Probe : Job.Probes)
+    {
+        iplProbeBatchAddProbe(ProbeBatch, Probe);
+    }
+
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &Job.SerializedObject);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+        Job.SerializedObject = nullptr;
+        iplProbeBatchRelease(&ProbeBatch);
+        return;
+    }
+
+    iplProbeBatchSave(ProbeBatch, Job.SerializedObject);
+    iplProbeBatchRelease(&ProbeBatch);
+}
+
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ASteamAudioProbeVolume
 // ---------------------------------------------------------------------------------------------------------------------
@@ -34,6 +244,8 @@ ASteamAudioProbeVolume::ASteamAudioProbeVolume()
 	, GenerationType(EProbeGenerationType::UNIFORM_FLOOR)
 	, HorizontalSpacing(3.0f)
 	, HeightAboveFloor(1.5f)
+	, MinHorizontalSpacing(1.0f)
+	, MaxProbes(0)
 	, NumProbes(0)
 	, DataSize(0)
 	, Simulator(nullptr)
@@ -55,9 +267,13 @@ bool ASteamAudioProbeVolume::CanEditChange(const FProperty* InProperty) const
     const bool bParentVal = Super::CanEditChange(InProperty);
 
     if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, HorizontalSpacing))
-        return bParentVal && (GenerationType == EProbeGenerationType::UNIFORM_FLOOR);
+        return bParentVal && (GenerationType != EProbeGenerationType::CENTROID);
     if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, HeightAboveFloor))
-        return bParentVal && (GenerationType == EProbeGenerationType::UNIFORM_FLOOR);
+        return bParentVal && (GenerationType != EProbeGenerationType::CENTROID);
+    if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MinHorizontalSpacing))
+        return bParentVal && (GenerationType == EProbeGenerationType::ADAPTIVE);
+    if (InProperty->GetFName() == GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MaxProbes))
+        return bParentVal && (GenerationType == EProbeGenerationType::ADAPTIVE);
 
     return bParentVal;
 }
@@ -76,28 +292,54 @@ void ASteamAudioProbeVolume::BeginPlay()
 	if (Manager.InitializedType() != SteamAudio::EManagerInitReason::PLAYING)
 		return;
 
-    Simulator = iplSimulatorRetain(Manager.GetSimulator());
+    // Probe volumes are loaded when listeners come near them.
+    if (Manager.GetSteamAudioSettings().bEnableProbeStreaming)
+    {
+        Manager.GetProbeStreamer().AddVolume(this);
+        return;
+    }
+
+    Simulator = iplSimulatorRetain(Manager.GetReflectionSimulator());
 	if (!Simulator)
 		return;
 
-    // Load the probe batch from the .uasset and add it to the simulator.
-    ProbeBatch = SteamAudio::LoadProbeBatchFromAsset(Asset, Manager.GetContext());
-	if (!ProbeBatch)
-	{
-		iplSimulatorRelease(&Simulator);
-		return;
-	}
+    // Load the probe batch from the .uasset in the background, and add it to the simulator once it's ready.
+    TWeakObjectPtr<ASteamAudioProbeVolume> WeakThis(this);
+    TArray<IPLBakedDataIdentifier> LayersToUnload = GetLayersToUnload(Manager.GetSteamAudioSettings());
+    SteamAudio::LoadProbeBatchFromAssetAsync(Asset, Manager.GetContext(), [WeakThis](IPLProbeBatch LoadedProbeBatch)
+    {
+        // The volume may have stopped playing while the probe batch was loading.
+        ASteamAudioProbeVolume* ProbeVolume = WeakThis.Get();
+        if (!ProbeVolume || !ProbeVolume->Simulator || ProbeVolume->ProbeBatch)
+        {
+            iplProbeBatchRelease(&LoadedProbeBatch);
+            return;
+        }
 
-    iplProbeBatchCommit(ProbeBatch);
-    iplSimulatorAddProbeBatch(Simulator, ProbeBatch);
+        ProbeVolume->ProbeBatch = LoadedProbeBatch;
+        if (ProbeVolume->ProbeBatch)
+        {
+            iplSimulatorAddProbeBatch(ProbeVolume->Simulator, ProbeVolume->ProbeBatch);
+        }
+    }, MoveTemp(LayersToUnload));
 }
 
 void ASteamAudioProbeVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (Simulator && ProbeBatch)
+    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+    if (Manager.InitializedType() == SteamAudio::EManagerInitReason::PLAYING && Manager.GetSteamAudioSettings().bEnableProbeStreaming)
+    {
+        Manager.GetProbeStreamer().RemoveVolume(this);
+    }
+
+	if (Simulator)
 	{
-        iplSimulatorRemoveProbeBatch(Simulator, ProbeBatch);
-        iplProbeBatchRelease(&ProbeBatch);
+        if (ProbeBatch)
+        {
+            iplSimulatorRemoveProbeBatch(Simulator, ProbeBatch);
+            iplProbeBatchRelease(&ProbeBatch);
+        }
+
         iplSimulatorRelease(&Simulator);
 	}
 
@@ -106,153 +348,155 @@ void ASteamAudioProbeVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 bool ASteamAudioProbeVolume::GenerateProbes(ASteamAudioStaticMeshActor* StaticMeshActor, FString AssetName)
 {
-	check(StaticMeshActor);
-    check(ProbeComponent);
-
-	TPromise<bool> Promise;
+    return GenerateProbesForVolumes(StaticMeshActor, {this}, {AssetName});
+}
 
-	Async(EAsyncExecution::Thread, [this, StaticMeshActor, AssetName, &Promise]()
-	{
-        // Make sure Steam Audio is initialized.
-		SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
-        bool bInitializeSucceeded = SteamAudio::RunInGameThread<bool>([&]()
-        {
-            return Manager.InitializeSteamAudio(SteamAudio::EManagerInitReason::GENERATING_PROBES);
-        });
-		if (!bInitializeSucceeded)
-		{
-			Promise.SetValue(false);
-			return;
-		}
-
-		IPLContext Context = Manager.GetContext();
-		IPLScene Scene = Manager.GetScene();
-
-		// Load the static geometry data against which probes will be generated.
-		IPLStaticMesh StaticMesh = SteamAudio::RunInGameThread<IPLStaticMesh>([&]()
-		{
-			return SteamAudio::LoadStaticMeshFromAsset(StaticMeshActor->Asset, Context, Scene);
-		});
-		if (!StaticMesh)
-		{
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to load static mesh asset: %s"), *StaticMeshActor->Asset.GetAssetPathString());
-			Manager.ShutDownSteamAudio();
-            Promise.SetValue(false);
-            return;
-		}
+bool ASteamAudioProbeVolume::GenerateProbesForVolumes(ASteamAudioStaticMeshActor* StaticMeshActor,
+    const TArray<ASteamAudioProbeVolume*>& ProbeVolumes, const TArray<FString>& AssetNames,
+    FSteamAudioProbeGenerationProgress* Progress /* = nullptr */)
+{
+    check(StaticMeshActor);
+    check(ProbeVolumes.Num() == AssetNames.Num());
+    check(!IsInGameThread());
 
-        iplStaticMeshAdd(StaticMesh, Scene);
-        iplSceneCommit(Scene);
+    // Make sure Steam Audio is initialized.
+    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+    bool bInitializeSucceeded = SteamAudio::RunInGameThread<bool>([&]()
+    {
+        return Manager.InitializeSteamAudio(SteamAudio::EManagerInitReason::GENERATING_PROBES);
+    });
+    if (!bInitializeSucceeded)
+        return false;
 
-        // Create a probe array and generate probes in it.
-        IPLProbeArray ProbeArray = nullptr;
-        IPLerror Status = iplProbeArrayCreate(Context, &ProbeArray);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create probe array. [%d]"), Status);
-            iplStaticMeshRelease(&StaticMesh);
-            Manager.ShutDownSteamAudio();
-            Promise.SetValue(false);
-            return;
-        }
+    IPLContext Context = Manager.GetContext();
+    IPLScene Scene = Manager.GetScene();
 
-        FTransform Transform = GetTransform();
-        Transform.MultiplyScale3D(FVector(2)); // todo: why?
+    // Load the static geometry data against which probes will be generated. This is shared by all probe volumes.
+    IPLStaticMesh StaticMesh = SteamAudio::RunInGameThread<IPLStaticMesh>([&]()
+    {
+        return SteamAudio::LoadStaticMeshFromAsset(StaticMeshActor->Asset, Context, Scene);
+    });
+    if (!StaticMesh)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to load static mesh asset: %s"), *StaticMeshActor->Asset.GetAssetPathString());
+        Manager.ShutDownSteamAudio();
+        return false;
+    }
 
-        IPLProbeGenerationParams ProbeGenerationParams{};
-        ProbeGenerationParams.type = static_cast<IPLProbeGenerationType>(GenerationType);
-        ProbeGenerationParams.spacing = HorizontalSpacing;
-        ProbeGenerationParams.height = HeightAboveFloor;
-        ProbeGenerationParams.transform = SteamAudio::ConvertTransform(Transform, false);
+    iplStaticMeshAdd(StaticMesh, Scene);
+    iplSceneCommit(Scene);
 
-        iplProbeArrayGenerateProbes(ProbeArray, Scene, &ProbeGenerationParams);
+    // Read the settings of each probe volume on the game thread, so the volumes aren't touched while generating.
+    TArray<SteamAudio::FProbeGenerationJob> Jobs;
+    Jobs.SetNum(ProbeVolumes.Num());
 
-        // Create a probe batch and add the generated probes to it.
-        IPLProbeBatch GeneratedProbeBatch = nullptr;
-        Status = iplProbeBatchCreate(Context, &GeneratedProbeBatch);
-        if (Status != IPL_STATUS_SUCCESS)
+    SteamAudio::RunInGameThread<void>([&]()
+    {
+        for (int i = 0; i < ProbeVolumes.Num(); ++i)
         {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create probe batch. [%d]"), Status);
-            iplProbeArrayRelease(&ProbeArray);
-            iplStaticMeshRelease(&StaticMesh);
-            Manager.ShutDownSteamAudio();
-            Promise.SetValue(false);
-            return;
+            ASteamAudioProbeVolume* ProbeVolume = ProbeVolumes[i];
+            SteamAudio::FProbeGenerationJob& Job = Jobs[i];
+            check(ProbeVolume->ProbeComponent);
+
+            FTransform Transform = ProbeVolume->GetTransform();
+            Transform.MultiplyScale3D(FVector(2)); // todo: why?
+
+            // Adaptive probe generation starts from uniform floor probes at the finest spacing, and discards those
+            // that aren't needed.
+            Job.bAdaptive = (ProbeVolume->GenerationType == EProbeGenerationType::ADAPTIVE);
+            Job.CoarseSpacing = ProbeVolume->HorizontalSpacing;
+            Job.FineSpacing = FMath::Min(ProbeVolume->MinHorizontalSpacing, ProbeVolume->HorizontalSpacing);
+            Job.MaxProbes = ProbeVolume->MaxProbes;
+            Job.Bounds = ProbeVolume->GetComponentsBoundingBox(true);
+
+            Job.Params.type = Job.bAdaptive ? IPL_PROBEGENERATIONTYPE_UNIFORMFLOOR : static_cast<IPLProbeGenerationType>(ProbeVolume->GenerationType);
+            Job.Params.spacing = Job.bAdaptive ? Job.FineSpacing : Job.CoarseSpacing;
+            Job.Params.height = ProbeVolume->HeightAboveFloor;
+            Job.Params.transform = SteamAudio::ConvertTransform(Transform, false);
         }
+    });
 
-        iplProbeBatchAddProbeArray(GeneratedProbeBatch, ProbeArray);
-
-        IPLSerializedObjectSettings SerializedObjectSettings{};
+    // Generate probes for all volumes in parallel. Probe generation itself can't be interrupted, so cancelling only
+    // skips volumes that haven't started yet.
+    std::atomic<int> NumVolumesCompleted(0);
 
-        // Save the probe batch to a .uasset file.
-        IPLSerializedObject SerializedObject = nullptr;
-        Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
-        if (Status != IPL_STATUS_SUCCESS)
-        {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
-            iplProbeBatchRelease(&GeneratedProbeBatch);
-            iplProbeArrayRelease(&ProbeArray);
-            iplStaticMeshRelease(&StaticMesh);
-            Manager.ShutDownSteamAudio();
-            Promise.SetValue(false);
+    ParallelFor(Jobs.Num(), [&](int32 i)
+    {
+        if (Progress && Progress->bCancel)
             return;
-        }
 
-        iplProbeBatchSave(GeneratedProbeBatch, SerializedObject);
+        SteamAudio::GenerateProbeBatch(Context, Scene, Jobs[i]);
 
-        USteamAudioSerializedObject* AssetObject = SteamAudio::RunInGameThread<USteamAudioSerializedObject*>([&]()
-        {
-            return USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, AssetName);
-        });
-        if (!AssetObject)
+        int NumCompleted = ++NumVolumesCompleted;
+        if (Progress && Progress->OnProgress)
         {
-            UE_LOG(LogSteamAudio, Error, TEXT("Unable to serialize probe batch."));
-            iplSerializedObjectRelease(&SerializedObject);
-            iplProbeBatchRelease(&GeneratedProbeBatch);
-            iplProbeArrayRelease(&ProbeArray);
-            iplStaticMeshRelease(&StaticMesh);
-            Manager.ShutDownSteamAudio();
-            Promise.SetValue(false);
-            return;
+            Progress->OnProgress(NumCompleted, Jobs.Num());
         }
+    });
+
+    bool bCancelled = (Progress && Progress->bCancel);
+    bool bSucceeded = !bCancelled;
 
+    // Save the probe batches to .uasset files, and update the volumes. If cancelled, all volumes are left unchanged.
+    if (!bCancelled)
+    {
         SteamAudio::RunInGameThread<void>([&]()
         {
-            // Update stats.
-            Asset = AssetObject;
-            NumProbes = iplProbeArrayGetNumProbes(ProbeArray);
-            UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
-            ResetLayers();
-
-            // Update probe positions for visualization.
+            for (int i = 0; i < Jobs.Num(); ++i)
             {
-                FScopeLock Lock(&ProbeComponent->ProbePositionsCriticalSection);
+                ASteamAudioProbeVolume* ProbeVolume = ProbeVolumes[i];
+                SteamAudio::FProbeGenerationJob& Job = Jobs[i];
 
-                TArray<FVector>& ProbePositions = ProbeComponent->ProbePositions;
-                ProbePositions.Empty();
-                ProbePositions.SetNumUninitialized(NumProbes);
+                if (!Job.SerializedObject)
+                {
+                    bSucceeded = false;
+                    continue;
+                }
 
-                for (int i = 0; i < NumProbes; ++i)
+                USteamAudioSerializedObject* AssetObject = USteamAudioSerializedObject::SerializeObjectToPackage(Job.SerializedObject, AssetNames[i]);
+                if (!AssetObject)
                 {
-                    ProbePositions[i] = SteamAudio::ConvertVectorInverse(iplProbeArrayGetProbe(ProbeArray, i).center);
+                    UE_LOG(LogSteamAudio, Error, TEXT("Unable to serialize probe batch."));
+                    bSucceeded = false;
+                    continue;
+                }
+
+                // Update stats.
+                ProbeVolume->Asset = AssetObject;
+                ProbeVolume->NumProbes = Job.Probes.Num();
+                ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(Job.SerializedObject));
+                ProbeVolume->ResetLayers();
+
+                // Update probe positions for visualization.
+                {
+                    FScopeLock Lock(&ProbeVolume->ProbeComponent->ProbePositionsCriticalSection);
+
+                    TArray<FVector>& ProbePositions = ProbeVolume->ProbeComponent->ProbePositions;
+                    ProbePositions.Empty();
+                    ProbePositions.SetNumUninitialized(Job.Probes.Num());
+
+                    for (int j = 0; j < Job.Probes.Num(); ++j)
+                    {
+                        ProbePositions[j] = SteamAudio::ConvertVectorInverse(Job.Probes[j].center);
+                    }
+
+                    ProbeVolume->ProbeComponent->ProbePositionsVersion++;
                 }
-            }
 
-            MarkPackageDirty();
+                ProbeVolume->MarkPackageDirty();
+            }
         });
+    }
 
-        iplSerializedObjectRelease(&SerializedObject);
-        iplProbeBatchRelease(&GeneratedProbeBatch);
-        iplProbeArrayRelease(&ProbeArray);
-        iplStaticMeshRelease(&StaticMesh);
-		Manager.ShutDownSteamAudio();
-		Promise.SetValue(true);
-	});
+    for (SteamAudio::FProbeGenerationJob& Job : Jobs)
+    {
+        iplSerializedObjectRelease(&Job.SerializedObject);
+    }
 
-	TFuture<bool> Value = Promise.GetFuture();
-	Value.Wait();
+    iplStaticMeshRelease(&StaticMesh);
+    Manager.ShutDownSteamAudio();
 
-	return Value.Get();
+    return bSucceeded;
 }
 
 void ASteamAudioProbeVolume::UpdateTotalSize(int Size)
@@ -274,20 +518,20 @@ void ASteamAudioProbeVolume::RemoveLayer(const FString& Name)
 	}
 }
 
-void ASteamAudioProbeVolume::AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size)
+void ASteamAudioProbeVolume::AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, uint32 GeometryHash)
 {
 	int Index = FindLayer(Name);
 	if (Index == INDEX_NONE)
 	{
-		AddLayer(Name, Identifier, Size);
+		AddLayer(Name, Identifier, Size, GeometryHash);
 	}
 	else
 	{
-		UpdateLayer(Name, Size);
+		UpdateLayer(Name, Identifier, Size, GeometryHash);
 	}
 }
 
-void ASteamAudioProbeVolume::AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size)
+void ASteamAudioProbeVolume::AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, uint32 GeometryHash)
 {
 	FSteamAudioBakedDataInfo Info;
 	Info.Name = Name;
@@ -296,16 +540,21 @@ void ASteamAudioProbeVolume::AddLayer(const FString& Name, IPLBakedDataIdentifie
 	Info.EndpointCenter = SteamAudio::ConvertVectorInverse(Identifier.endpointInfluence.center);
 	Info.EndpointRadius = Identifier.endpointInfluence.radius;
 	Info.Size = Size;
+	Info.GeometryHash = GeometryHash;
 
 	DetailedStats.Add(Info);
 }
 
-void ASteamAudioProbeVolume::UpdateLayer(const FString& Name, int Size)
+void ASteamAudioProbeVolume::UpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, uint32 GeometryHash)
 {
 	int Index = FindLayer(Name);
 	if (Index != INDEX_NONE)
 	{
+		// The endpoint may have moved since the layer was last baked.
+		DetailedStats[Index].EndpointCenter = SteamAudio::ConvertVectorInverse(Identifier.endpointInfluence.center);
+		DetailedStats[Index].EndpointRadius = Identifier.endpointInfluence.radius;
 		DetailedStats[Index].Size = Size;
+		DetailedStats[Index].GeometryHash = GeometryHash;
 	}
 }
 
@@ -313,3 +562,48 @@ int ASteamAudioProbeVolume::FindLayer(const FString& Name)
 {
 	return DetailedStats.IndexOfByPredicate([&Name](const FSteamAudioBakedDataInfo& Info) { return Info.Name == Name; });
 }
+
+TArray<IPLBakedDataIdentifier> ASteamAudioProbeVolume::GetLayersToUnload(const FSteamAudioSettings& Settings) const
+{
+    check(IsInGameThread());
+
+    // Layers are named after the actors they were baked for.
+    TSet<FString> ReferencedActors;
+    if (Settings.bLoadOnlyReferencedBakedLayers)
+    {
+        for (TObjectIterator<USteamAudioBakedSourceComponent> It; It; ++It)
+        {
+            if (It->GetWorld() == GetWorld() && It->GetOwner())
+            {
+                ReferencedActors.Add(It->GetOwner()->GetName());
+            }
+        }
+
+        for (TObjectIterator<USteamAudioBakedListenerComponent> It; It; ++It)
+        {
+            if (It->GetWorld() == GetWorld() && It->GetOwner())
+            {
+                ReferencedActors.Add(It->GetOwner()->GetName());
+            }
+        }
+    }
+
+    TArray<IPLBakedDataIdentifier> LayersToUnload;
+    for (const FSteamAudioBakedDataInfo& Info : DetailedStats)
+    {
+        IPLBakedDataIdentifier Identifier = Info.GetIdentifier();
+
+        bool bStripped = Settings.BakedDataPlatformRule.ShouldStrip(Identifier.type, Identifier.variation);
+
+        bool bHasEndpoint = (Identifier.type == IPL_BAKEDDATATYPE_REFLECTIONS) &&
+            (Identifier.variation == IPL_BAKEDDATAVARIATION_STATICSOURCE || Identifier.variation == IPL_BAKEDDATAVARIATION_STATICLISTENER);
+        bool bUnreferenced = Settings.bLoadOnlyReferencedBakedLayers && bHasEndpoint && !ReferencedActors.Contains(Info.Name);
+
+        if (bStripped || bUnreferenced)
+        {
+            LayersToUnload.Add(Identifier);
+        }
+    }
+
+    return LayersToUnload;
+}
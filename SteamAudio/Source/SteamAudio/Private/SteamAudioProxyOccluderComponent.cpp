@@ -0,0 +1,183 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioProxyOccluderComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioProxyOccluders.h"
+#include "SteamAudioSettings.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioProxyOccluderComponent
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioProxyOccluderComponent::USteamAudioProxyOccluderComponent()
+    : Material()
+    , ComponentName(NAME_None)
+    , ShapeScale(1.0f)
+    , ShapeType(EProxyOccluderShape::SPHERE)
+    , ShapeTransform(FTransform::Identity)
+    , ShapeExtents(FVector::ZeroVector)
+    , ShapeLength(0.0f)
+    , ShapeMaterial{}
+{
+    // Shapes are read in a single pass by the Steam Audio Manager, so we don't need to tick.
+    bAutoActivate = true;
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+bool USteamAudioProxyOccluderComponent::GetShape(SteamAudio::FSteamAudioProxyOccluderShape& OutShape) const
+{
+    const UPrimitiveComponent* Component = ShapeComponent.Get();
+    if (!Component)
+        return false;
+
+    const FTransform& ComponentTransform = Component->GetComponentTransform();
+    FVector Scale = ComponentTransform.GetScale3D().GetAbs() * ShapeScale;
+
+    OutShape.Type = ShapeType;
+    OutShape.Transform = FTransform(ComponentTransform.GetRotation() * ShapeTransform.GetRotation(), ComponentTransform.TransformPosition(ShapeTransform.GetLocation()));
+    OutShape.Material = ShapeMaterial;
+
+    // Scaling follows the same conventions as Unreal's simple collision.
+    switch (ShapeType)
+    {
+    case EProxyOccluderShape::SPHERE:
+        OutShape.Extents = FVector(ShapeExtents.X * Scale.GetMin());
+        OutShape.HalfLength = 0.0f;
+        OutShape.BoundingRadius = OutShape.Extents.X;
+        break;
+
+    case EProxyOccluderShape::CAPSULE:
+        OutShape.Extents = FVector(ShapeExtents.X * FMath::Min(Scale.X, Scale.Y));
+        OutShape.HalfLength = 0.5f * ShapeLength * Scale.Z;
+        OutShape.BoundingRadius = OutShape.Extents.X + OutShape.HalfLength;
+        break;
+
+    case EProxyOccluderShape::BOX:
+        OutShape.Extents = ShapeExtents * Scale;
+        OutShape.HalfLength = 0.0f;
+        OutShape.BoundingRadius = OutShape.Extents.Size();
+        break;
+    }
+
+    return true;
+}
+
+void USteamAudioProxyOccluderComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+    if (Manager.InitializedType() != SteamAudio::EManagerInitReason::PLAYING)
+        return;
+
+    if (!FindShape())
+    {
+        UE_LOG(LogSteamAudio, Warning, TEXT("Unable to find a sphere, capsule, or box to use as a proxy occluder for %s."), *GetOwner()->GetName());
+        return;
+    }
+
+    ShapeMaterial = Material.IsAsset() ? GetDefault<USteamAudioSettings>()->GetMaterialForAsset(Material) : Manager.GetSteamAudioSettings().DefaultMeshMaterial;
+
+    Manager.AddProxyOccluder(this);
+}
+
+void USteamAudioProxyOccluderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    SteamAudio::FSteamAudioModule::GetManager().RemoveProxyOccluder(this);
+    ShapeComponent.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+bool USteamAudioProxyOccluderComponent::FindShape()
+{
+    AActor* Owner = GetOwner();
+    if (!Owner)
+        return false;
+
+    TArray<UPrimitiveComponent*> Components;
+    Owner->GetComponents<UPrimitiveComponent>(Components);
+
+    if (ComponentName != NAME_None)
+    {
+        for (UPrimitiveComponent* Component : Components)
+        {
+            if (Component->GetFName() == ComponentName)
+                return InitShapeFromComponent(Component);
+        }
+
+        return false;
+    }
+
+    if (InitShapeFromComponent(Cast<UPrimitiveComponent>(Owner->GetRootComponent())))
+        return true;
+
+    for (UPrimitiveComponent* Component : Components)
+    {
+        if (InitShapeFromComponent(Component))
+            return true;
+    }
+
+    return false;
+}
+
+bool USteamAudioProxyOccluderComponent::InitShapeFromComponent(UPrimitiveComponent* Component)
+{
+    if (!Component)
+        return false;
+
+    UBodySetup* BodySetup = Component->GetBodySetup();
+    if (!BodySetup)
+        return false;
+
+    const FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+
+    // Prefer capsules, since they are what characters use, and fit most other moving objects better than spheres.
+    if (AggGeom.SphylElems.Num() > 0)
+    {
+        const FKSphylElem& Elem = AggGeom.SphylElems[0];
+        ShapeType = EProxyOccluderShape::CAPSULE;
+        ShapeTransform = FTransform(Elem.Rotation, Elem.Center);
+        ShapeExtents = FVector(Elem.Radius);
+        ShapeLength = Elem.Length;
+    }
+    else if (AggGeom.BoxElems.Num() > 0)
+    {
+        const FKBoxElem& Elem = AggGeom.BoxElems[0];
+        ShapeType = EProxyOccluderShape::BOX;
+        ShapeTransform = FTransform(Elem.Rotation, Elem.Center);
+        ShapeExtents = 0.5f * FVector(Elem.X, Elem.Y, Elem.Z);
+        ShapeLength = 0.0f;
+    }
+    else if (AggGeom.SphereElems.Num() > 0)
+    {
+        const FKSphereElem& Elem = AggGeom.SphereElems[0];
+        ShapeType = EProxyOccluderShape::SPHERE;
+        ShapeTransform = FTransform(Elem.Center);
+        ShapeExtents = FVector(Elem.Radius);
+        ShapeLength = 0.0f;
+    }
+    else
+    {
+        return false;
+    }
+
+    ShapeComponent = Component;
+    return true;
+}
@@ -0,0 +1,394 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioProxyOccluders.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helper Functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Finds the point at which a ray starting outside a sphere enters it. */
+static bool IntersectSphere(const FVector& Origin, const FVector& Direction, const FVector& Center, float Radius, float& OutDistance)
+{
+    FVector OC = Origin - Center;
+    float B = FVector::DotProduct(OC, Direction);
+    float C = OC.SizeSquared() - Radius * Radius;
+    float H = B * B - C;
+    if (H < 0.0f)
+        return false;
+
+    OutDistance = -B - FMath::Sqrt(H);
+    return OutDistance >= 0.0f;
+}
+
+/** Returns the closest distance between a ray interval and a point. */
+static float RayDistanceToPoint(const FVector& Origin, const FVector& Direction, float MaxDistance, const FVector& Point)
+{
+    float T = FMath::Clamp(FVector::DotProduct(Point - Origin, Direction), 0.0f, MaxDistance);
+    return FVector::Dist(Origin + Direction * T, Point);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioProxyOccluderShape
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool FSteamAudioProxyOccluderShape::Contains(const FVector& Point) const
+{
+    FVector LocalPoint = Transform.InverseTransformPositionNoScale(Point);
+
+    switch (Type)
+    {
+    case EProxyOccluderShape::SPHERE:
+        return LocalPoint.SizeSquared() <= FMath::Square(Extents.X);
+
+    case EProxyOccluderShape::CAPSULE:
+        LocalPoint.Z -= FMath::Clamp(LocalPoint.Z, -HalfLength, HalfLength);
+        return LocalPoint.SizeSquared() <= FMath::Square(Extents.X);
+
+    case EProxyOccluderShape::BOX:
+        return FMath::Abs(LocalPoint.X) <= Extents.X && FMath::Abs(LocalPoint.Y) <= Extents.Y && FMath::Abs(LocalPoint.Z) <= Extents.Z;
+    }
+
+    return false;
+}
+
+bool FSteamAudioProxyOccluderShape::Intersect(const FVector& Origin, const FVector& Direction, float MaxDistance, float& OutDistance, FVector& OutNormal) const
+{
+    if (RayDistanceToPoint(Origin, Direction, MaxDistance, Transform.GetLocation()) > BoundingRadius)
+        return false;
+
+    if (Contains(Origin))
+        return false;
+
+    FVector LocalOrigin = Transform.InverseTransformPositionNoScale(Origin);
+    FVector LocalDirection = Transform.InverseTransformVectorNoScale(Direction);
+    FVector LocalNormal = FVector::ZeroVector;
+    float Distance = 0.0f;
+
+    switch (Type)
+    {
+    case EProxyOccluderShape::SPHERE:
+    {
+        if (!IntersectSphere(LocalOrigin, LocalDirection, FVector::ZeroVector, Extents.X, Distance))
+            return false;
+
+        LocalNormal = LocalOrigin + LocalDirection * Distance;
+        break;
+    }
+
+    case EProxyOccluderShape::CAPSULE:
+    {
+        // Ray against the infinite cylinder around the Z axis, then against the end caps if the entry point is
+        // beyond the ends of the cylinder.
+        float Radius = Extents.X;
+        float A = LocalDirection.X * LocalDirection.X + LocalDirection.Y * LocalDirection.Y;
+        float B = LocalOrigin.X * LocalDirection.X + LocalOrigin.Y * LocalDirection.Y;
+        float C = LocalOrigin.X * LocalOrigin.X + LocalOrigin.Y * LocalOrigin.Y - Radius * Radius;
+
+        bool bHitCylinder = false;
+        if (A > KINDA_SMALL_NUMBER)
+        {
+            float H = B * B - A * C;
+            if (H < 0.0f)
+                return false;
+
+            Distance = (-B - FMath::Sqrt(H)) / A;
+            float Z = LocalOrigin.Z + LocalDirection.Z * Distance;
+            if (Distance >= 0.0f && FMath::Abs(Z) <= HalfLength)
+            {
+                LocalNormal = FVector(LocalOrigin.X + LocalDirection.X * Distance, LocalOrigin.Y + LocalDirection.Y * Distance, 0.0f);
+                bHitCylinder = true;
+            }
+        }
+
+        if (!bHitCylinder)
+        {
+            float CapDistance[2];
+            bool bHitCap[2];
+            for (int i = 0; i < 2; ++i)
+            {
+                bHitCap[i] = IntersectSphere(LocalOrigin, LocalDirection, FVector(0.0f, 0.0f, (i == 0) ? -HalfLength : HalfLength), Radius, CapDistance[i]);
+            }
+
+            if (!bHitCap[0] && !bHitCap[1])
+                return false;
+
+            int Cap = (bHitCap[0] && (!bHitCap[1] || CapDistance[0] < CapDistance[1])) ? 0 : 1;
+            Distance = CapDistance[Cap];
+            LocalNormal = LocalOrigin + LocalDirection * Distance - FVector(0.0f, 0.0f, (Cap == 0) ? -HalfLength : HalfLength);
+        }
+        break;
+    }
+
+    case EProxyOccluderShape::BOX:
+    {
+        // Slab test.
+        float Near = 0.0f;
+        float Far = MaxDistance;
+        int NearAxis = -1;
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            if (FMath::Abs(LocalDirection[Axis]) < KINDA_SMALL_NUMBER)
+            {
+                if (FMath::Abs(LocalOrigin[Axis]) > Extents[Axis])
+                    return false;
+
+                continue;
+            }
+
+            float InvDirection = 1.0f / LocalDirection[Axis];
+            float T0 = (-Extents[Axis] - LocalOrigin[Axis]) * InvDirection;
+            float T1 = (Extents[Axis] - LocalOrigin[Axis]) * InvDirection;
+            if (T0 > T1)
+            {
+                Swap(T0, T1);
+            }
+
+            if (T0 > Near)
+            {
+                Near = T0;
+                NearAxis = Axis;
+            }
+
+            Far = FMath::Min(Far, T1);
+            if (Near > Far)
+                return false;
+        }
+
+        if (NearAxis < 0)
+            return false;
+
+        Distance = Near;
+        LocalNormal[NearAxis] = (LocalDirection[NearAxis] > 0.0f) ? -1.0f : 1.0f;
+        break;
+    }
+    }
+
+    if (Distance > MaxDistance)
+        return false;
+
+    OutDistance = Distance;
+    OutNormal = Transform.TransformVectorNoScale(LocalNormal.GetSafeNormal());
+    return true;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioProxyOccluders
+// ---------------------------------------------------------------------------------------------------------------------
+
+const int32 FSteamAudioProxyOccluders::NumVolumetricSamples = 8;
+
+FSteamAudioProxyOccluders::FSteamAudioProxyOccluders()
+    : Shapes(MakeShared<const FShapeArray, ESPMode::ThreadSafe>())
+    , bEmpty(true)
+{}
+
+void FSteamAudioProxyOccluders::SetShapes(FShapeArray&& NewShapes)
+{
+    check(IsInGameThread());
+
+    // There were no shapes before, and there are none now.
+    if (bEmpty && NewShapes.Num() == 0)
+        return;
+
+    bEmpty = (NewShapes.Num() == 0);
+
+    FShapeSnapshot Snapshot = MakeShared<const FShapeArray, ESPMode::ThreadSafe>(MoveTemp(NewShapes));
+
+    FScopeLock Lock(&CriticalSection);
+    RetiredShapes.Add(MoveTemp(Shapes));
+    Shapes = MoveTemp(Snapshot);
+}
+
+FSteamAudioProxyOccluders::FShapeSnapshot FSteamAudioProxyOccluders::GetShapes() const
+{
+    FScopeLock Lock(&CriticalSection);
+    return Shapes;
+}
+
+void FSteamAudioProxyOccluders::ReleaseRetiredShapes()
+{
+    check(IsInGameThread());
+    RetiredShapes.Reset();
+}
+
+void FSteamAudioProxyOccluders::Reset()
+{
+    FScopeLock Lock(&CriticalSection);
+    Shapes = MakeShared<const FShapeArray, ESPMode::ThreadSafe>();
+    RetiredShapes.Empty();
+    bEmpty = true;
+}
+
+bool FSteamAudioProxyOccluders::ClosestHit(const FShapeArray& Shapes, const FVector& Origin, const FVector& Direction, float MaxDistance, float& OutDistance, FVector& OutNormal, const IPLMaterial*& OutMaterial)
+{
+    bool bHit = false;
+
+    for (const FSteamAudioProxyOccluderShape& Shape : Shapes)
+    {
+        if (Shape.bPortal)
+            continue;
+
+        float Distance;
+        FVector Normal;
+        if (Shape.Intersect(Origin, Direction, MaxDistance, Distance, Normal))
+        {
+            MaxDistance = Distance;
+            OutDistance = Distance;
+            OutNormal = Normal;
+            OutMaterial = &Shape.Material;
+            bHit = true;
+        }
+    }
+
+    return bHit;
+}
+
+bool FSteamAudioProxyOccluders::AnyHit(const FShapeArray& Shapes, const FVector& Start, const FVector& End)
+{
+    FVector Segment = End - Start;
+    float Length = Segment.Size();
+    if (Length <= KINDA_SMALL_NUMBER)
+        return false;
+
+    FVector Direction = Segment / Length;
+
+    for (const FSteamAudioProxyOccluderShape& Shape : Shapes)
+    {
+        if (Shape.bPortal)
+            continue;
+
+        float Distance;
+        FVector Normal;
+        if (Shape.Intersect(Start, Direction, Length, Distance, Normal) && !Shape.Contains(End))
+            return true;
+    }
+
+    return false;
+}
+
+void FSteamAudioProxyOccluders::ApplyToDirectPath(const FShapeArray& Shapes, const FVector& SourcePosition, const FVector& ListenerPosition, float VolumetricRadius, bool bApplyTransmission, bool bPortalsOnly, float& Occlusion, float Transmission[3])
+{
+    if (Shapes.Num() == 0)
+        return;
+
+    // Sample points on a disc around the source, facing the listener.
+    TArray<FVector, TInlineAllocator<16>> SamplePoints;
+    SamplePoints.Add(SourcePosition);
+
+    if (VolumetricRadius > 0.0f)
+    {
+        FVector Axis = (SourcePosition - ListenerPosition).GetSafeNormal();
+        FVector Tangent;
+        FVector Bitangent;
+        Axis.FindBestAxisVectors(Tangent, Bitangent);
+
+        for (int32 i = 0; i < NumVolumetricSamples; ++i)
+        {
+            float Angle = (2.0f * PI * i) / NumVolumetricSamples;
+            SamplePoints.Add(SourcePosition + VolumetricRadius * (FMath::Cos(Angle) * Tangent + FMath::Sin(Angle) * Bitangent));
+        }
+    }
+
+    // Blocked samples are weighted by the opacity of what blocks them, so a half-open door blocks half as much sound
+    // as a closed one.
+    float BlockedWeight = 0.0f;
+    float ProxyTransmission[3] = { 0.0f, 0.0f, 0.0f };
+
+    for (const FVector& SamplePoint : SamplePoints)
+    {
+        FVector Segment = SamplePoint - ListenerPosition;
+        float Length = Segment.Size();
+        if (Length <= KINDA_SMALL_NUMBER)
+            continue;
+
+        FVector Direction = Segment / Length;
+
+        float SampleOpacity = 0.0f;
+        float SampleTransmission[3] = { 1.0f, 1.0f, 1.0f };
+
+        // Sound passing through several proxies is attenuated by each of them.
+        for (const FSteamAudioProxyOccluderShape& Shape : Shapes)
+        {
+            if ((bPortalsOnly && !Shape.bPortal) || Shape.Opacity <= 0.0f)
+                continue;
+
+            float Distance;
+            FVector Normal;
+            if (!Shape.Intersect(ListenerPosition, Direction, Length, Distance, Normal) || Shape.Contains(SamplePoint))
+                continue;
+
+            // The fraction of sound that gets past this shape is (1 - opacity) + opacity * transmission. It is
+            // split into the part that passes around it unoccluded and the part transmitted through it.
+            SampleOpacity = 1.0f - (1.0f - SampleOpacity) * (1.0f - Shape.Opacity);
+            for (int Band = 0; Band < 3; ++Band)
+            {
+                SampleTransmission[Band] *= FMath::Lerp(1.0f, Shape.Material.transmission[Band], Shape.Opacity);
+            }
+        }
+
+        if (SampleOpacity > 0.0f)
+        {
+            BlockedWeight += SampleOpacity;
+            for (int Band = 0; Band < 3; ++Band)
+            {
+                // Only the blocked part of the sample contributes transmission: remove the unoccluded part that
+                // SampleTransmission also includes.
+                float Transmitted = FMath::Max(SampleTransmission[Band] - (1.0f - SampleOpacity), 0.0f) / SampleOpacity;
+                ProxyTransmission[Band] += SampleOpacity * FMath::Min(Transmitted, 1.0f);
+            }
+        }
+    }
+
+    if (BlockedWeight <= 0.0f)
+        return;
+
+    float BlockedFraction = BlockedWeight / SamplePoints.Num();
+    for (int Band = 0; Band < 3; ++Band)
+    {
+        ProxyTransmission[Band] /= BlockedWeight;
+    }
+
+    // The proxies block part of the sound that reached the listener unoccluded so far. Whatever gets through them is
+    // combined with whatever was already transmitted through the scene, so that the total reaching the listener in
+    // each band (occlusion + (1 - occlusion) * transmission) is preserved.
+    float NewOcclusion = Occlusion * (1.0f - BlockedFraction);
+
+    if (bApplyTransmission)
+    {
+        if (NewOcclusion < 1.0f - KINDA_SMALL_NUMBER)
+        {
+            for (int Band = 0; Band < 3; ++Band)
+            {
+                float Transmitted = Occlusion * BlockedFraction * ProxyTransmission[Band] + (1.0f - Occlusion) * Transmission[Band];
+                Transmission[Band] = FMath::Clamp(Transmitted / (1.0f - NewOcclusion), 0.0f, 1.0f);
+            }
+        }
+    }
+    else
+    {
+        float AverageTransmission = (ProxyTransmission[0] + ProxyTransmission[1] + ProxyTransmission[2]) / 3.0f;
+        NewOcclusion += Occlusion * BlockedFraction * AverageTransmission;
+    }
+
+    Occlusion = NewOcclusion;
+}
+
+}
@@ -0,0 +1,133 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+#include "SteamAudioProxyOccluderComponent.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioProxyOccluderShape
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * A sphere, capsule, or box in world space, used as a proxy occluder. All distances are in Unreal units.
+ */
+struct FSteamAudioProxyOccluderShape
+{
+    /** The type of shape. */
+    EProxyOccluderShape Type = EProxyOccluderShape::SPHERE;
+
+    /** Position and orientation of the shape. Capsules are aligned with the local Z axis. Not scaled. */
+    FTransform Transform;
+
+    /** Radius of a sphere or capsule (in X), or half-extents of a box. */
+    FVector Extents = FVector::ZeroVector;
+
+    /** Half the distance between the centers of the end caps of a capsule. */
+    float HalfLength = 0.0f;
+
+    /** Radius of a sphere centered on the shape that contains it, used for early rejection. */
+    float BoundingRadius = 0.0f;
+
+    /** The material of the shape. */
+    IPLMaterial Material{};
+
+    /** Fraction of the sound along the direct path that is blocked by the shape, before transmission. Less than 1 for
+        doors that are partly open. */
+    float Opacity = 1.0f;
+
+    /** True if the shape is a door in a portal. Doors only affect the direct path, and are never hit by rays traced for
+        reflections or pathing, since the doorway is always open in the scene. */
+    bool bPortal = false;
+
+    /** Returns true if the given point is inside the shape. */
+    bool Contains(const FVector& Point) const;
+
+    /** Finds the point at which the given ray enters the shape, within the given distance. Rays that start inside the
+        shape don't hit it. The direction must be normalized. */
+    bool Intersect(const FVector& Origin, const FVector& Direction, float MaxDistance, float& OutDistance, FVector& OutNormal) const;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioProxyOccluders
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * The set of proxy occluders used for simulation. The game thread publishes a new snapshot of the shapes every frame,
+ * which can be read from any thread. Since the shapes are tested analytically, updating them never requires a scene
+ * commit. Snapshots that have been replaced are kept alive until the simulation thread is idle, so material pointers
+ * handed to Steam Audio by a ray tracer stay valid for the rest of the simulation in which they were returned.
+ */
+class FSteamAudioProxyOccluders
+{
+public:
+    typedef TArray<FSteamAudioProxyOccluderShape> FShapeArray;
+    typedef TSharedPtr<const FShapeArray, ESPMode::ThreadSafe> FShapeSnapshot;
+
+    FSteamAudioProxyOccluders();
+
+    /** Publishes a new set of shapes. Call on the game thread. */
+    void SetShapes(FShapeArray&& Shapes);
+
+    /** Returns the most recently published shapes. Can be called from any thread. */
+    FShapeSnapshot GetShapes() const;
+
+    /** Returns true if there are no shapes. Call on the game thread. */
+    bool IsEmpty() const { return bEmpty; }
+
+    /** Releases snapshots that have been replaced. Call on the game thread, while the simulation thread is idle. */
+    void ReleaseRetiredShapes();
+
+    /** Removes all shapes. */
+    void Reset();
+
+    /** Finds the closest proxy hit along the given ray, within the given distance. Doors are ignored. The returned
+        material pointer stays valid until the next call to ReleaseRetiredShapes. */
+    static bool ClosestHit(const FShapeArray& Shapes, const FVector& Origin, const FVector& Direction, float MaxDistance, float& OutDistance, FVector& OutNormal, const IPLMaterial*& OutMaterial);
+
+    /** Returns true if any proxy is hit along the given line segment. Proxies containing either end point are
+        ignored, so a sound source or listener is never occluded by its own proxy. Doors are ignored. */
+    static bool AnyHit(const FShapeArray& Shapes, const FVector& Start, const FVector& End);
+
+    /** Applies occlusion and transmission by the given proxies along the direct path from a source to the listener,
+        on top of the values simulated against the scene. If VolumetricRadius is greater than zero, rays are traced to
+        several points on a disc of that radius around the source (in Unreal units). If bApplyTransmission is false,
+        sound transmitted through the proxies is folded into the occlusion value, using the average over all bands. If
+        bPortalsOnly is true, only doors are applied. Can be called from any thread. */
+    static void ApplyToDirectPath(const FShapeArray& Shapes, const FVector& SourcePosition, const FVector& ListenerPosition, float VolumetricRadius, bool bApplyTransmission, bool bPortalsOnly, float& Occlusion, float Transmission[3]);
+
+private:
+    /** The most recently published shapes. */
+    FShapeSnapshot Shapes;
+
+    /** Snapshots that have been replaced, but may still be in use by the simulation thread. */
+    TArray<FShapeSnapshot> RetiredShapes;
+
+    /** Guards Shapes. */
+    mutable FCriticalSection CriticalSection;
+
+    /** True if the most recently published snapshot is empty. */
+    bool bEmpty;
+
+    /** Number of points on the edge of the disc used for volumetric occlusion, not counting its center. */
+    static const int32 NumVolumetricSamples;
+};
+
+}
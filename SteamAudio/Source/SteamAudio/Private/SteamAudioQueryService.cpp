@@ -0,0 +1,268 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioQueryService.h"
+#include "Async/Async.h"
+#include "SteamAudioCommon.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioQueryService
+// ---------------------------------------------------------------------------------------------------------------------
+
+const int32 FSteamAudioQueryService::MaxQueriesPerRun = 256;
+
+FSteamAudioQueryService::FSteamAudioQueryService()
+    : Simulator(nullptr)
+    , MaxOcclusionSamples(1)
+    , bIdle(true)
+{}
+
+FSteamAudioQueryService::~FSteamAudioQueryService()
+{
+    Shutdown();
+}
+
+bool FSteamAudioQueryService::Initialize(IPLContext Context, const IPLSimulationSettings& SimulationSettings)
+{
+    check(!Simulator);
+
+    IPLSimulationSettings QuerySimulationSettings = SimulationSettings;
+    QuerySimulationSettings.flags = IPL_SIMULATIONFLAGS_DIRECT;
+
+    IPLerror Status = iplSimulatorCreate(Context, &QuerySimulationSettings, &Simulator);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create query simulator. [%d]"), Status);
+        return false;
+    }
+
+    MaxOcclusionSamples = QuerySimulationSettings.maxNumOcclusionSamples;
+    return true;
+}
+
+void FSteamAudioQueryService::Shutdown()
+{
+    while (!bIdle)
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    TArray<FBatch> DroppedBatches = MoveTemp(PendingBatches);
+    PendingBatches.Reset();
+
+    for (IPLSource& Source : Sources)
+    {
+        iplSourceRemove(Source, Simulator);
+        iplSourceRelease(&Source);
+    }
+
+    Sources.Empty();
+    iplSimulatorRelease(&Simulator);
+
+    // Complete queries that never ran with default (unoccluded) results, so nobody is left waiting on them. This is
+    // done last, so any queries submitted by the callbacks are completed straight away.
+    for (FBatch& Batch : DroppedBatches)
+    {
+        Batch.Results.SetNum(Batch.Queries.Num());
+        Batch.OnCompleted(MoveTemp(Batch.Results));
+    }
+}
+
+void FSteamAudioQueryService::SetScene(IPLScene Scene)
+{
+    check(IsInGameThread());
+    check(bIdle);
+
+    if (!Simulator)
+        return;
+
+    iplSimulatorSetScene(Simulator, Scene);
+    iplSimulatorCommit(Simulator);
+}
+
+void FSteamAudioQueryService::Submit(TArray<FSteamAudioOcclusionQuery>&& Queries, const FVector& ListenerPosition, FOnQueryCompleted&& OnCompleted)
+{
+    check(IsInGameThread());
+
+    if (!Simulator)
+    {
+        OnCompleted(TArray<FSteamAudioOcclusionQueryResult>());
+        return;
+    }
+
+    for (FSteamAudioOcclusionQuery& Query : Queries)
+    {
+        if (Query.bEndAtListener)
+        {
+            Query.End = ListenerPosition;
+        }
+    }
+
+    FBatch& Batch = PendingBatches.AddDefaulted_GetRef();
+    Batch.Queries = MoveTemp(Queries);
+    Batch.OnCompleted = MoveTemp(OnCompleted);
+}
+
+void FSteamAudioQueryService::Dispatch(FSteamAudioProxyOccluders::FShapeSnapshot ProxyShapes, bool bPortalsOnly)
+{
+    check(IsInGameThread());
+
+    if (!Simulator || PendingBatches.Num() == 0 || !bIdle)
+        return;
+
+    bIdle = false;
+
+    Async(EAsyncExecution::ThreadPool, [this, Batches = MoveTemp(PendingBatches), ProxyShapes, bPortalsOnly]() mutable
+    {
+        Run(Batches, *ProxyShapes, bPortalsOnly);
+
+        AsyncTask(ENamedThreads::GameThread, [CompletedBatches = MoveTemp(Batches)]() mutable
+        {
+            for (FBatch& Batch : CompletedBatches)
+            {
+                Batch.OnCompleted(MoveTemp(Batch.Results));
+            }
+        });
+
+        bIdle = true;
+    });
+
+    PendingBatches.Reset();
+}
+
+void FSteamAudioQueryService::Run(TArray<FBatch>& Batches, const FSteamAudioProxyOccluders::FShapeArray& ProxyShapes, bool bPortalsOnly)
+{
+    // Group queries by end point, since the end point is the listener, which is shared by all sources in a run.
+    TMap<FVector, TArray<TPair<FBatch*, int32>>> Groups;
+    for (FBatch& Batch : Batches)
+    {
+        Batch.Results.SetNum(Batch.Queries.Num());
+
+        for (int32 i = 0; i < Batch.Queries.Num(); ++i)
+        {
+            Groups.FindOrAdd(Batch.Queries[i].End).Add(TPair<FBatch*, int32>(&Batch, i));
+        }
+    }
+
+    for (const auto& Group : Groups)
+    {
+        IPLSimulationSharedInputs SharedInputs{};
+        SharedInputs.listener.origin = ConvertVector(Group.Key);
+        SharedInputs.listener.ahead = ConvertVector(FVector::ForwardVector, false);
+        SharedInputs.listener.up = ConvertVector(FVector::UpVector, false);
+        SharedInputs.listener.right = ConvertVector(FVector::RightVector, false);
+
+        for (int32 RunStart = 0; RunStart < Group.Value.Num(); RunStart += MaxQueriesPerRun)
+        {
+            int32 NumQueries = FMath::Min(Group.Value.Num() - RunStart, MaxQueriesPerRun);
+            if (!ReserveSources(NumQueries))
+            {
+                // The remaining queries keep their default (unoccluded) results, and their callbacks are still called
+                // once the run is over.
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to run occlusion queries, returning default results."));
+                return;
+            }
+
+            iplSimulatorSetSharedInputs(Simulator, IPL_SIMULATIONFLAGS_DIRECT, &SharedInputs);
+
+            for (int32 i = 0; i < Sources.Num(); ++i)
+            {
+                // Sources left over from bigger runs are disabled.
+                IPLSimulationInputs Inputs{};
+
+                if (i < NumQueries)
+                {
+                    const FSteamAudioOcclusionQuery& Query = Group.Value[RunStart + i].Key->Queries[Group.Value[RunStart + i].Value];
+
+                    Inputs.flags = IPL_SIMULATIONFLAGS_DIRECT;
+                    Inputs.directFlags = IPL_DIRECTSIMULATIONFLAGS_OCCLUSION;
+                    if (Query.bSimulateTransmission)
+                    {
+                        Inputs.directFlags = static_cast<IPLDirectSimulationFlags>(Inputs.directFlags | IPL_DIRECTSIMULATIONFLAGS_TRANSMISSION);
+                    }
+
+                    Inputs.source.origin = ConvertVector(Query.Start);
+                    Inputs.source.ahead = ConvertVector(FVector::ForwardVector, false);
+                    Inputs.source.up = ConvertVector(FVector::UpVector, false);
+                    Inputs.source.right = ConvertVector(FVector::RightVector, false);
+                    Inputs.occlusionType = static_cast<IPLOcclusionType>(Query.OcclusionType);
+                    Inputs.occlusionRadius = Query.OcclusionRadius;
+                    Inputs.numOcclusionSamples = FMath::Clamp(Query.OcclusionSamples, 1, MaxOcclusionSamples);
+                    Inputs.numTransmissionRays = 1;
+                }
+
+                iplSourceSetInputs(Sources[i], IPL_SIMULATIONFLAGS_DIRECT, &Inputs);
+            }
+
+            iplSimulatorRunDirect(Simulator);
+
+            for (int32 i = 0; i < NumQueries; ++i)
+            {
+                const FSteamAudioOcclusionQuery& Query = Group.Value[RunStart + i].Key->Queries[Group.Value[RunStart + i].Value];
+                FSteamAudioOcclusionQueryResult& Result = Group.Value[RunStart + i].Key->Results[Group.Value[RunStart + i].Value];
+
+                IPLSimulationOutputs Outputs{};
+                iplSourceGetOutputs(Sources[i], IPL_SIMULATIONFLAGS_DIRECT, &Outputs);
+
+                float VolumetricRadius = (Query.OcclusionType == EOcclusionType::VOLUMETRIC) ? ConvertSteamAudioDistanceToUnreal(Query.OcclusionRadius) : 0.0f;
+                FSteamAudioProxyOccluders::ApplyToDirectPath(ProxyShapes, Query.Start, Query.End, VolumetricRadius, Query.bSimulateTransmission, bPortalsOnly, Outputs.direct.occlusion, Outputs.direct.transmission);
+
+                Result.Occlusion = Outputs.direct.occlusion;
+                if (Query.bSimulateTransmission)
+                {
+                    Result.TransmissionLow = Outputs.direct.transmission[0];
+                    Result.TransmissionMid = Outputs.direct.transmission[1];
+                    Result.TransmissionHigh = Outputs.direct.transmission[2];
+                }
+
+                // Steam Audio doesn't report the length of the paths it traces for occlusion, so this is the
+                // straight-line distance.
+                Result.PathLength = FVector::Dist(Query.Start, Query.End);
+            }
+        }
+    }
+}
+
+bool FSteamAudioQueryService::ReserveSources(int32 NumSources)
+{
+    if (Sources.Num() >= NumSources)
+        return true;
+
+    while (Sources.Num() < NumSources)
+    {
+        IPLSourceSettings SourceSettings{};
+        SourceSettings.flags = IPL_SIMULATIONFLAGS_DIRECT;
+
+        IPLSource Source = nullptr;
+        IPLerror Status = iplSourceCreate(Simulator, &SourceSettings, &Source);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create source for occlusion query. [%d]"), Status);
+            break;
+        }
+
+        iplSourceAdd(Source, Simulator);
+        Sources.Add(Source);
+    }
+
+    iplSimulatorCommit(Simulator);
+
+    return Sources.Num() >= NumSources;
+}
+
+}
@@ -0,0 +1,102 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+#include "SteamAudioOcclusionQuery.h"
+#include "SteamAudioProxyOccluders.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioQueryService
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Runs occlusion queries between arbitrary points for gameplay code, using a dedicated direct-only simulator that
+ * shares the main scene. Steam Audio doesn't expose ray queries against a scene, so each query is simulated as a
+ * source, and queries that share an end point are simulated in a single run with the end point as the listener. All
+ * queries submitted during a frame are run together on a worker thread, and the results are delivered on the game
+ * thread. The main scene must not be committed while queries are running.
+ */
+class FSteamAudioQueryService
+{
+public:
+    typedef TFunction<void(TArray<FSteamAudioOcclusionQueryResult>&&)> FOnQueryCompleted;
+
+    FSteamAudioQueryService();
+
+    ~FSteamAudioQueryService();
+
+    /** Creates the query simulator. */
+    bool Initialize(IPLContext Context, const IPLSimulationSettings& SimulationSettings);
+
+    /** Waits for any running queries to finish, and releases the query simulator. Queries that haven't started are
+        completed with default results. Call on the game thread. */
+    void Shutdown();
+
+    /** Returns true if no queries are running. */
+    bool IsIdle() const { return bIdle; }
+
+    /** Sets the scene to run queries against, and commits the query simulator. Call on the game thread, only while
+        no queries are running. */
+    void SetScene(IPLScene Scene);
+
+    /** Queues a batch of queries. End points at the listener are resolved using the given listener position. */
+    void Submit(TArray<FSteamAudioOcclusionQuery>&& Queries, const FVector& ListenerPosition, FOnQueryCompleted&& OnCompleted);
+
+    /** Starts running all queued queries on a worker thread, if no queries are running already. Proxy occluders are
+        applied using the given shapes, or only doors if bPortalsOnly is true. Call on the game thread. */
+    void Dispatch(FSteamAudioProxyOccluders::FShapeSnapshot ProxyShapes, bool bPortalsOnly);
+
+private:
+    /** A batch of queries submitted together. */
+    struct FBatch
+    {
+        TArray<FSteamAudioOcclusionQuery> Queries;
+        TArray<FSteamAudioOcclusionQueryResult> Results;
+        FOnQueryCompleted OnCompleted;
+    };
+
+    /** The query simulator. */
+    IPLSimulator Simulator;
+
+    /** Sources used to simulate queries, one per query in a single run. Only accessed by the worker thread while
+        queries are running. */
+    TArray<IPLSource> Sources;
+
+    /** The maximum number of occlusion samples the query simulator was created with. */
+    int32 MaxOcclusionSamples;
+
+    /** Batches waiting to be dispatched. */
+    TArray<FBatch> PendingBatches;
+
+    /** True if no queries are running. */
+    std::atomic<bool> bIdle;
+
+    /** Maximum number of queries simulated in a single run. */
+    static const int32 MaxQueriesPerRun;
+
+    /** Runs the given batches. Queries that can't be run are left with default results. Called on a worker
+        thread. */
+    void Run(TArray<FBatch>& Batches, const FSteamAudioProxyOccluders::FShapeArray& ProxyShapes, bool bPortalsOnly);
+
+    /** Makes sure there are at least the given number of sources. */
+    bool ReserveSources(int32 NumSources);
+};
+
+}
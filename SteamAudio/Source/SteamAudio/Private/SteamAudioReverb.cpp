@@ -526,6 +526,7 @@ FSubmixEffectSteamAudioReverbPlugin::FSubmixEffectSteamAudioReverbPlugin()
     , PrevReflectionEffectType(IPL_REFLECTIONEFFECTTYPE_CONVOLUTION)
     , PrevDuration(0.0f)
     , PrevOrder(-1)
+    , bParametricFastPath(false)
 {
 }
 
@@ -584,6 +585,14 @@ void FSubmixEffectSteamAudioReverbPlugin::LazyInit()
 
     IPLSimulationSettings SimulationSettings = SteamAudio::FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
 
+    // The fast path renders order 0 (i.e., mono) parametric reverb, which needs neither the mixer nor decoding.
+    bParametricFastPath = SteamAudio::FSteamAudioModule::GetManager().GetSteamAudioSettings().bParametricReverbFastPath;
+    if (bParametricFastPath)
+    {
+        SimulationSettings.reflectionType = IPL_REFLECTIONEFFECTTYPE_PARAMETRIC;
+        SimulationSettings.maxOrder = 0;
+    }
+
     if (!ReflectionEffect || PrevReflectionEffectType != SimulationSettings.reflectionType ||
         PrevDuration != SimulationSettings.maxDuration || PrevOrder != SimulationSettings.maxOrder)
     {
@@ -601,7 +610,7 @@ void FSubmixEffectSteamAudioReverbPlugin::LazyInit()
         }
     }
 
-    if ((!AmbisonicsDecodeEffect || PrevOrder != SimulationSettings.maxOrder) && HRTF)
+    if ((!AmbisonicsDecodeEffect || PrevOrder != SimulationSettings.maxOrder) && HRTF && !bParametricFastPath)
     {
         if (AmbisonicsDecodeEffect)
         {
@@ -770,6 +779,12 @@ void FSubmixEffectSteamAudioReverbPlugin::OnProcessAudio(const FSoundEffectSubmi
 
     ClearBuffers();
 
+    if (bParametricFastPath)
+    {
+        ProcessParametricReverb(InBufferData, OutBufferData);
+        return;
+    }
+
     IPLSimulationSettings SimulationSettings = SteamAudio::FSteamAudioModule::GetManager().GetRealTimeSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
 
     if (ReverbPlugin && (SimulationSettings.reflectionType != IPL_REFLECTIONEFFECTTYPE_TAN || SimulationSettings.tanDevice))
@@ -852,6 +867,39 @@ void FSubmixEffectSteamAudioReverbPlugin::OnProcessAudio(const FSoundEffectSubmi
 	}
 }
 
+void FSubmixEffectSteamAudioReverbPlugin::ProcessParametricReverb(float* InBufferData, float* OutBufferData)
+{
+    USubmixEffectSteamAudioReverbPluginPreset* ReverbPreset = Cast<USubmixEffectSteamAudioReverbPluginPreset>(GetPreset());
+    if (!ReverbPreset || !ReverbPreset->Settings.bApplyReverb)
+        return;
+
+    // If a Steam Audio Listener component has not set the current reverb source, stop.
+    IPLSource CurrentReverbSource = GetReverbSource();
+    if (!CurrentReverbSource || !InBuffer.data || !MonoBuffer.data || !IndirectBuffer.data || !OutBuffer.data)
+        return;
+
+    iplAudioBufferDeinterleave(Context, InBufferData, &InBuffer);
+    iplAudioBufferDownmix(Context, &InBuffer, &MonoBuffer);
+
+    // The simulator interpolates the reverb times and EQ between the baked probes around the listener.
+    IPLSimulationOutputs Outputs{};
+    iplSourceGetOutputs(CurrentReverbSource, IPL_SIMULATIONFLAGS_REFLECTIONS, &Outputs);
+
+    IPLReflectionEffectParams ReverbParams = Outputs.reflections;
+    ReverbParams.type = IPL_REFLECTIONEFFECTTYPE_PARAMETRIC;
+    ReverbParams.numChannels = 1;
+
+    iplReflectionEffectApply(ReflectionEffect, &ReverbParams, &MonoBuffer, &IndirectBuffer, nullptr);
+
+    // Order 0 reverb is omnidirectional, so it is the same in both ears.
+    for (int i = 0; i < OutBuffer.numChannels; ++i)
+    {
+        FMemory::Memcpy(OutBuffer.data[i], IndirectBuffer.data[0], OutBuffer.numSamples * sizeof(float));
+    }
+
+    iplAudioBufferInterleave(Context, &OutBuffer, OutBufferData);
+}
+
 IPLSource FSubmixEffectSteamAudioReverbPlugin::GetReverbSource()
 {
     return ReverbSource.load();
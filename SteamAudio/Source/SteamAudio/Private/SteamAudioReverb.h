@@ -240,6 +240,10 @@ private:
     float PrevDuration;
     int PrevOrder;
 
+    /** If true, reverb is rendered using a single mono parametric reverb. See
+        USteamAudioSettings::bParametricReverbFastPath. */
+    bool bParametricFastPath;
+
 	/** Double-buffered reference to the Steam Audio simulation source. */
 	static std::atomic<IPLSource> ReverbSource;
 
@@ -253,6 +257,9 @@ private:
 
 	void ClearBuffers();
 
+    /** Applies mono parametric reverb to the input, and copies it to both output channels. */
+    void ProcessParametricReverb(float* InBufferData, float* OutBufferData);
+
 	FDelegateHandle InitHandle;
 	FDelegateHandle ShutdownHandle;
 };
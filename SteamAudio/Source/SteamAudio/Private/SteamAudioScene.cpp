@@ -25,11 +25,13 @@
 #include "Engine/SimpleConstructionScript.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshActor.h"
+#include "Engine/StreamableManager.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioDynamicObjectComponent.h"
 #include "SteamAudioGeometryComponent.h"
 #include "SteamAudioManager.h"
 #include "SteamAudioMaterial.h"
+#include "SteamAudioPortalComponent.h"
 #include "SteamAudioSerializedObject.h"
 #include "SteamAudioSettings.h"
 #include "SteamAudioStaticMeshActor.h"
@@ -98,17 +100,18 @@ static bool ExportMaterial(FSoftObjectPath MaterialAsset, TArray<IPLMaterial>& M
 }
 
 /**
- * Exports a single Static Mesh component.
+ * Exports a single Static Mesh component. Exports the given LOD, or the lowest-detail LOD if the mesh has fewer LODs.
  */
 static bool ExportStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent, TArray<IPLVector3>& Vertices,
     TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, TArray<IPLMaterial>& Materials,
-    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true)
+    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true, int LOD = 0)
 {
     check(StaticMeshComponent);
     check(StaticMeshComponent->GetStaticMesh());
     check(StaticMeshComponent->GetStaticMesh()->GetRenderData());
 
-    FStaticMeshLODResources& LODModel = StaticMeshComponent->GetStaticMesh()->GetRenderData()->LODResources[0];
+    FStaticMeshRenderData* RenderData = StaticMeshComponent->GetStaticMesh()->GetRenderData();
+    FStaticMeshLODResources& LODModel = RenderData->LODResources[FMath::Clamp(LOD, 0, RenderData->LODResources.Num() - 1)];
     check(LODModel.GetNumVertices() > 0 && LODModel.GetNumTriangles() > 0);
 
     int StartVertexIndex = Vertices.Num();
@@ -177,7 +180,7 @@ static bool ExportStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent,
  */
 static bool ExportStaticMeshComponentsForActor(AStaticMeshActor* StaticMeshActor, TArray<IPLVector3>& Vertices,
     TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, TArray<IPLMaterial>& Materials,
-    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true)
+    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true, int LOD = 0)
 {
     check(StaticMeshActor);
 
@@ -190,17 +193,17 @@ static bool ExportStaticMeshComponentsForActor(AStaticMeshActor* StaticMeshActor
         return false;
 
     return ExportStaticMeshComponent(StaticMeshComponent, Vertices, Triangles, MaterialIndices, Materials,
-        MaterialIndexForAsset, bRelativePositions);
+        MaterialIndexForAsset, bRelativePositions, LOD);
 }
 
 /**
- * Exports a single Landscape (terrain) actor.
+ * Exports a single Landscape (terrain) actor. Every Stride x Stride block of quads is exported as a single quad.
  *
  * todo: non-default materials for terrain
  */
 static bool ExportLandscapeActor(ALandscape* LandscapeActor, TArray<IPLVector3>& Vertices,
     TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, TArray<IPLMaterial>& Materials,
-    TMap<FString, int>& MaterialIndexForAsset)
+    TMap<FString, int>& MaterialIndexForAsset, int Stride = 1)
 {
     check(LandscapeActor);
 
@@ -217,16 +220,20 @@ static bool ExportLandscapeActor(ALandscape* LandscapeActor, TArray<IPLVector3>&
 
         FLandscapeComponentDataInterface CDI(Component);
 
-        for (int y = 0; y < Component->ComponentSizeQuads; ++y)
+        for (int y = 0; y < Component->ComponentSizeQuads; y += Stride)
         {
-            for (int x = 0; x < Component->ComponentSizeQuads; ++x)
+            for (int x = 0; x < Component->ComponentSizeQuads; x += Stride)
             {
                 int StartIndex = Vertices.Num();
 
+                // Clamp to the edge of the component, so neighboring components still line up.
+                int x1 = FMath::Min(x + Stride, Component->ComponentSizeQuads);
+                int y1 = FMath::Min(y + Stride, Component->ComponentSizeQuads);
+
                 Vertices.Add(ConvertVector(CDI.GetWorldVertex(x, y)));
-                Vertices.Add(ConvertVector(CDI.GetWorldVertex(x, y + 1)));
-                Vertices.Add(ConvertVector(CDI.GetWorldVertex(x + 1, y + 1)));
-                Vertices.Add(ConvertVector(CDI.GetWorldVertex(x + 1, y)));
+                Vertices.Add(ConvertVector(CDI.GetWorldVertex(x, y1)));
+                Vertices.Add(ConvertVector(CDI.GetWorldVertex(x1, y1)));
+                Vertices.Add(ConvertVector(CDI.GetWorldVertex(x1, y)));
 
                 IPLTriangle Triangle{};
 
@@ -266,14 +273,14 @@ static bool ExportLandscapeActor(ALandscape* LandscapeActor, TArray<IPLVector3>&
  */
 static bool ExportActors(const TArray<AActor*>& Actors, TArray<IPLVector3>& Vertices,
     TArray<IPLTriangle>& Triangles, TArray<int>& MaterialIndices, TArray<IPLMaterial>& Materials,
-    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true)
+    TMap<FString, int>& MaterialIndexForAsset, bool bRelativePositions = true, int LOD = 0, int LandscapeStride = 1)
 {
     for (AActor* Actor : Actors)
     {
         if (Actor->IsA<AStaticMeshActor>())
         {
             if (!ExportStaticMeshComponentsForActor(Cast<AStaticMeshActor>(Actor), Vertices, Triangles, MaterialIndices,
-                Materials, MaterialIndexForAsset, bRelativePositions))
+                Materials, MaterialIndexForAsset, bRelativePositions, LOD))
             {
                 return false;
             }
@@ -281,7 +288,7 @@ static bool ExportActors(const TArray<AActor*>& Actors, TArray<IPLVector3>& Vert
         else if (Actor->IsA<ALandscape>())
         {
             if (!ExportLandscapeActor(Cast<ALandscape>(Actor), Vertices, Triangles, MaterialIndices, Materials,
-                MaterialIndexForAsset))
+                MaterialIndexForAsset, LandscapeStride))
             {
                 return false;
             }
@@ -404,6 +411,17 @@ static bool IsSteamAudioDynamicObject(AActor* Actor)
     return false;
 }
 
+/**
+ * Returns true if a Steam Audio Portal component is attached to the given actor. The door in a portal is modeled
+ * analytically, so it must not be exported, leaving the doorway open in the scene. Only the actor that owns the portal
+ * is the door; actors attached to it, or that it is attached to, are exported as usual, so that walls attached to a
+ * room or building with a door in it don't leave holes in the scene.
+ */
+static bool IsSteamAudioPortal(AActor* Actor)
+{
+    return Actor->FindComponentByClass<USteamAudioPortalComponent>() != nullptr;
+}
+
 /**
  * Finds all actors in the given (sub)level that are tagged for export as part of the level's static geometry.
  */
@@ -417,7 +435,7 @@ static void GetActorsForStaticGeometryExport(UWorld* World, ULevel* Level, TArra
         if (It->GetLevel() != Level)
             continue;
 
-        if (!IsSteamAudioGeometry(*It) || IsSteamAudioDynamicObject(*It))
+        if (!IsSteamAudioGeometry(*It) || IsSteamAudioDynamicObject(*It) || IsSteamAudioPortal(*It))
             continue;
 
         // Ignore static meshes that are marked as Movable.
@@ -502,6 +520,155 @@ static void GetActorsForDynamicObjectExport(USteamAudioDynamicObjectComponent* D
     }
 }
 
+/** Size (in Unreal units) of the grid cells over which exported geometry is hashed. */
+static const float GeometryCellSize = 400.0f;
+
+/**
+ * Hashes exported geometry over a grid, so that changes to it can be located. Each triangle, along with its material,
+ * contributes to every cell overlapped by its bounding box. Vertices are quantized to millimeters, so that
+ * floating-point noise between exports isn't mistaken for a change, and the hash of a cell doesn't depend on the order
+ * of its triangles.
+ */
+static TMap<FIntVector, uint32> HashGeometryCells(const TArray<IPLVector3>& Vertices, const TArray<IPLTriangle>& Triangles,
+    const TArray<int>& MaterialIndices, const TArray<IPLMaterial>& Materials)
+{
+    TMap<FIntVector, uint32> CellHashes;
+
+    for (int i = 0; i < Triangles.Num(); ++i)
+    {
+        uint32 TriangleHash = 0;
+        FBox Bounds(ForceInit);
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const IPLVector3& Vertex = Vertices[Triangles[i].indices[j]];
+
+            FIntVector QuantizedVertex(FMath::RoundToInt(Vertex.x * 1000.0f), FMath::RoundToInt(Vertex.y * 1000.0f), FMath::RoundToInt(Vertex.z * 1000.0f));
+            TriangleHash = HashCombine(TriangleHash, GetTypeHash(QuantizedVertex));
+
+            Bounds += ConvertVectorInverse(Vertex);
+        }
+
+        if (MaterialIndices.IsValidIndex(i) && Materials.IsValidIndex(MaterialIndices[i]))
+        {
+            TriangleHash = HashCombine(TriangleHash, FCrc::MemCrc32(&Materials[MaterialIndices[i]], sizeof(IPLMaterial)));
+        }
+
+        FIntVector MinCell(FMath::FloorToInt(Bounds.Min.X / GeometryCellSize), FMath::FloorToInt(Bounds.Min.Y / GeometryCellSize), FMath::FloorToInt(Bounds.Min.Z / GeometryCellSize));
+        FIntVector MaxCell(FMath::FloorToInt(Bounds.Max.X / GeometryCellSize), FMath::FloorToInt(Bounds.Max.Y / GeometryCellSize), FMath::FloorToInt(Bounds.Max.Z / GeometryCellSize));
+
+        for (int x = MinCell.X; x <= MaxCell.X; ++x)
+        {
+            for (int y = MinCell.Y; y <= MaxCell.Y; ++y)
+            {
+                for (int z = MinCell.Z; z <= MaxCell.Z; ++z)
+                {
+                    CellHashes.FindOrAdd(FIntVector(x, y, z)) += TriangleHash;
+                }
+            }
+        }
+    }
+
+    return CellHashes;
+}
+
+/**
+ * Exports a simplified copy of the static geometry in the given (sub)level to a .uasset, for use when simulating
+ * reflections and pathing. Call from a worker thread, with Steam Audio initialized for exporting.
+ */
+static USteamAudioSerializedObject* ExportReflectionGeometryForLevel(UWorld* World, ULevel* Level, IPLContext Context,
+    IPLScene Scene, const FString& AssetName, TMap<FIntVector, uint32>& OutCellHashes, int& OutNumTriangles)
+{
+    TArray<IPLVector3> Vertices;
+    TArray<IPLTriangle> Triangles;
+    TArray<int> MaterialIndices;
+    TArray<IPLMaterial> Materials;
+    TMap<FString, int> MaterialIndexForAsset;
+    TArray<AActor*> Actors;
+    bool bExportSucceeded = RunInGameThread<bool>([&]()
+    {
+        const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+
+        GetActorsForStaticGeometryExport(World, Level, Actors);
+        if (!ExportActors(Actors, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset, true,
+            Settings->ReflectionGeometryLOD, FMath::Max(Settings->ReflectionLandscapeStride, 1)))
+        {
+            return false;
+        }
+
+        if (Settings->bExportBSPGeometry)
+        {
+            if (!ExportBSPGeometry(World, Level, Vertices, Triangles, MaterialIndices, Materials, MaterialIndexForAsset))
+                return false;
+        }
+
+        return true;
+    });
+    if (!bExportSucceeded || Triangles.Num() <= 0)
+        return nullptr;
+
+    IPLStaticMeshSettings StaticMeshSettings{};
+    StaticMeshSettings.numVertices = Vertices.Num();
+    StaticMeshSettings.numTriangles = Triangles.Num();
+    StaticMeshSettings.numMaterials = Materials.Num();
+    StaticMeshSettings.vertices = Vertices.GetData();
+    StaticMeshSettings.triangles = Triangles.GetData();
+    StaticMeshSettings.materialIndices = MaterialIndices.GetData();
+    StaticMeshSettings.materials = Materials.GetData();
+
+    IPLStaticMesh StaticMesh = nullptr;
+    IPLerror Status = iplStaticMeshCreate(Scene, &StaticMeshSettings, &StaticMesh);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create Steam Audio static mesh for reflection geometry: %s [%i]"), *AssetName, Status);
+        return nullptr;
+    }
+
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    IPLSerializedObject SerializedObject = nullptr;
+    Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create Steam Audio serialized object for reflection geometry: %s [%i]"), *AssetName, Status);
+        iplStaticMeshRelease(&StaticMesh);
+        return nullptr;
+    }
+
+    iplStaticMeshSave(StaticMesh, SerializedObject);
+
+    USteamAudioSerializedObject* Asset = RunInGameThread<USteamAudioSerializedObject*>([&]()
+    {
+        return USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, AssetName);
+    });
+
+    UE_LOG(LogSteamAudio, Log, TEXT("Exported reflection geometry: %s (%d triangles)"), *AssetName, Triangles.Num());
+
+    if (Asset)
+    {
+        OutCellHashes = HashGeometryCells(Vertices, Triangles, MaterialIndices, Materials);
+        OutNumTriangles = Triangles.Num();
+    }
+
+    iplSerializedObjectRelease(&SerializedObject);
+    iplStaticMeshRelease(&StaticMesh);
+    return Asset;
+}
+
+/**
+ * Returns the name of the .uasset containing reflection geometry, given the name of the .uasset containing the full
+ * static geometry for a level.
+ */
+static FString GetReflectionGeometryAssetName(const FString& AssetName)
+{
+    FString PackageName;
+    FString ObjectName;
+    if (!AssetName.Split(".", &PackageName, &ObjectName))
+        return AssetName + TEXT("_Reflections");
+
+    return FString::Printf(TEXT("%s_Reflections.%s_Reflections"), *PackageName, *ObjectName);
+}
+
 bool DoesLevelHaveStaticGeometryForExport(UWorld* World, ULevel* Level)
 {
     check(World);
@@ -509,7 +676,7 @@ bool DoesLevelHaveStaticGeometryForExport(UWorld* World, ULevel* Level)
 
     for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
     {
-        if (It->GetLevel() == Level && IsSteamAudioGeometry(*It) && !IsSteamAudioDynamicObject(*It))
+        if (It->GetLevel() == Level && IsSteamAudioGeometry(*It) && !IsSteamAudioDynamicObject(*It) && !IsSteamAudioPortal(*It))
             return true;
     }
 
@@ -655,6 +822,29 @@ bool ExportStaticGeometryForLevel(UWorld* World, ULevel* Level, FString FileName
                 return;
             }
 
+            // Hash the geometry that reflections and pathing are baked against, so baked data can later be checked
+            // against it.
+            TMap<FIntVector, uint32> CellHashes;
+            int NumTriangles = 0;
+
+            // Optionally export a simplified copy of the geometry for reflections and pathing. If this fails, the
+            // full geometry is used for everything.
+            USteamAudioSerializedObject* ReflectionAsset = nullptr;
+            if (GetDefault<USteamAudioSettings>()->bUseReflectionGeometry)
+            {
+                ReflectionAsset = ExportReflectionGeometryForLevel(World, Level, Context, Scene, GetReflectionGeometryAssetName(FileName), CellHashes, NumTriangles);
+                if (!ReflectionAsset)
+                {
+                    UE_LOG(LogSteamAudio, Warning, TEXT("Unable to export reflection geometry for level: %s"), *Level->GetOutermostObject()->GetName());
+                }
+            }
+
+            if (!ReflectionAsset)
+            {
+                CellHashes = HashGeometryCells(Vertices, Triangles, MaterialIndices, Materials);
+                NumTriangles = Triangles.Num();
+            }
+
             RunInGameThread<void>([&]()
             {
                 // See if there already is a Steam Audio Static Mesh actor in the level.
@@ -680,6 +870,10 @@ bool ExportStaticGeometryForLevel(UWorld* World, ULevel* Level, FString FileName
                 // Point the Steam Audio Static Mesh actor to the .uasset we just created.
                 check(SteamAudioStaticMeshActor);
                 SteamAudioStaticMeshActor->Asset = Asset;
+                SteamAudioStaticMeshActor->ReflectionAsset = ReflectionAsset;
+                SteamAudioStaticMeshActor->GeometryCellSize = GeometryCellSize;
+                SteamAudioStaticMeshActor->GeometryCellHashes = MoveTemp(CellHashes);
+                SteamAudioStaticMeshActor->NumTriangles = NumTriangles;
                 SteamAudioStaticMeshActor->MarkPackageDirty();
             });
 
@@ -843,6 +1037,99 @@ bool ExportDynamicObject(USteamAudioDynamicObjectComponent* DynamicObject, FStri
 #endif
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Async Loading
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Releases an object created by an async load that is no longer wanted. */
+static void ReleaseLoadedObject(IPLScene& Scene)
+{
+    iplSceneRelease(&Scene);
+}
+
+static void ReleaseLoadedObject(IPLProbeBatch& ProbeBatch)
+{
+    iplProbeBatchRelease(&ProbeBatch);
+}
+
+/**
+ * Loads the given asset without blocking the game thread, then calls Deserialize on a worker thread to create a Steam
+ * Audio object from its data, and finally passes that object to OnLoaded on the game thread. OnLoaded receives
+ * nullptr if anything fails, or if Steam Audio was shut down while loading.
+ */
+template <typename T>
+static void LoadFromAssetAsync(FSoftObjectPath Asset, TFunction<T(const USteamAudioSerializedObject*)> Deserialize,
+    TFunction<void(T)> OnLoaded)
+{
+    check(IsInGameThread());
+
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+    FStreamableManager& StreamableManager = Manager.GetStreamableManager();
+
+    // If Steam Audio is shut down while loading, the object must not be used, since it was created for the scene(s)
+    // and settings that were just released.
+    uint32 ShutdownCount = Manager.GetShutdownCount();
+
+    // The streamable handle keeps the asset from being garbage collected, so we hold on to it until the worker thread
+    // is done reading from the asset. The handle is only ever touched on the game thread.
+    TSharedRef<TSharedPtr<FStreamableHandle>> Handle = MakeShared<TSharedPtr<FStreamableHandle>>();
+
+    auto Finish = [Handle, OnLoaded, ShutdownCount](T Result)
+    {
+        check(IsInGameThread());
+
+        if (Handle->IsValid())
+        {
+            (*Handle)->ReleaseHandle();
+            Handle->Reset();
+        }
+
+        if (Result && FSteamAudioModule::GetManager().GetShutdownCount() != ShutdownCount)
+        {
+            ReleaseLoadedObject(Result);
+        }
+
+        OnLoaded(Result);
+    };
+
+    *Handle = StreamableManager.RequestAsyncLoad(Asset, FStreamableDelegate::CreateLambda([Asset, Deserialize, Finish, ShutdownCount]()
+    {
+        FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+
+        const USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(Asset.ResolveObject());
+        if (!AssetObject || Manager.GetShutdownCount() != ShutdownCount)
+        {
+            if (!AssetObject)
+            {
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to load asset: %s"), *Asset.ToString());
+            }
+
+            // This delegate may be called from within RequestAsyncLoad, so always finish on a later tick.
+            AsyncTask(ENamedThreads::GameThread, [Finish]()
+            {
+                Finish(nullptr);
+            });
+            return;
+        }
+
+        // Shutting down waits for this, so the scene(s) and devices stay alive while deserializing.
+        Manager.BeginAsyncLoad();
+
+        Async(EAsyncExecution::ThreadPool, [&Manager, AssetObject, Deserialize, Finish]()
+        {
+            T Result = Deserialize(AssetObject);
+
+            AsyncTask(ENamedThreads::GameThread, [Finish, Result]()
+            {
+                Finish(Result);
+            });
+
+            Manager.EndAsyncLoad();
+        });
+    }));
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Scene Load/Unload
 // ---------------------------------------------------------------------------------------------------------------------
@@ -857,31 +1144,72 @@ IPLStaticMesh LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLContext Context,
     if (!AssetObject)
         return nullptr;
 
-    IPLSerializedObjectSettings SerializedObjectSettings{};
-    SerializedObjectSettings.size = AssetObject->Data.Num();
-    SerializedObjectSettings.data = AssetObject->Data.GetData();
+    return LoadStaticMeshFromAsset(AssetObject, Context, Scene);
+}
 
-    IPLSerializedObject SerializedObject = nullptr;
-    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
-    if (Status != IPL_STATUS_SUCCESS)
-    {
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+IPLStaticMesh LoadStaticMeshFromAsset(const USteamAudioSerializedObject* AssetObject, IPLContext Context, IPLScene Scene)
+{
+    check(AssetObject);
+    check(Context);
+    check(Scene);
+
+    // The reader keeps the data alive until the Steam Audio object has been created from it, then frees it.
+    FSteamAudioSerializedObjectReader Reader(AssetObject, Context);
+    IPLSerializedObject SerializedObject = Reader.GetSerializedObject();
+    if (!SerializedObject)
         return nullptr;
-    }
 
     IPLStaticMesh StaticMesh = nullptr;
-    Status = iplStaticMeshLoad(Scene, SerializedObject, nullptr, nullptr, &StaticMesh);
+    IPLerror Status = iplStaticMeshLoad(Scene, SerializedObject, nullptr, nullptr, &StaticMesh);
     if (Status != IPL_STATUS_SUCCESS)
     {
         UE_LOG(LogSteamAudio, Error, TEXT("Unable to load static mesh from serialized object. [%d]"), Status);
-        iplSerializedObjectRelease(&SerializedObject);
         return nullptr;
     }
 
-    iplSerializedObjectRelease(&SerializedObject);
     return StaticMesh;
 }
 
+IPLScene CreateSubSceneFromAsset(const USteamAudioSerializedObject* AssetObject, IPLContext Context, const IPLSceneSettings& SceneSettings)
+{
+    check(AssetObject);
+    check(Context);
+
+    IPLSceneSettings SubSceneSettings = SceneSettings;
+
+    IPLScene SubScene = nullptr;
+    IPLerror Status = iplSceneCreate(Context, &SubSceneSettings, &SubScene);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create scene. [%d]"), Status);
+        return nullptr;
+    }
+
+    IPLStaticMesh StaticMesh = LoadStaticMeshFromAsset(AssetObject, Context, SubScene);
+    if (!StaticMesh)
+    {
+        iplSceneRelease(&SubScene);
+        return nullptr;
+    }
+
+    iplStaticMeshAdd(StaticMesh, SubScene);
+    iplSceneCommit(SubScene);
+
+    iplStaticMeshRelease(&StaticMesh);
+    return SubScene;
+}
+
+void LoadSubSceneFromAssetAsync(FSoftObjectPath Asset, IPLContext Context, const IPLSceneSettings& SceneSettings, TFunction<void(IPLScene)> OnLoaded)
+{
+    check(Asset.IsAsset());
+    check(Context);
+
+    LoadFromAssetAsync<IPLScene>(Asset, [Context, SceneSettings](const USteamAudioSerializedObject* AssetObject)
+    {
+        return CreateSubSceneFromAsset(AssetObject, Context, SceneSettings);
+    }, MoveTemp(OnLoaded));
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Baked Data Load/Unload
@@ -896,29 +1224,52 @@ IPLProbeBatch LoadProbeBatchFromAsset(FSoftObjectPath Asset, IPLContext Context)
     if (!AssetObject)
         return nullptr;
 
-    IPLSerializedObjectSettings SerializedObjectSettings{};
-    SerializedObjectSettings.size = AssetObject->Data.Num();
-    SerializedObjectSettings.data = AssetObject->Data.GetData();
+    return LoadProbeBatchFromAsset(AssetObject, Context);
+}
 
-    IPLSerializedObject SerializedObject = nullptr;
-    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
-    if (Status != IPL_STATUS_SUCCESS)
-    {
-        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+IPLProbeBatch LoadProbeBatchFromAsset(const USteamAudioSerializedObject* AssetObject, IPLContext Context)
+{
+    check(AssetObject);
+    check(Context);
+
+    // The reader keeps the data alive until the Steam Audio object has been created from it, then frees it.
+    FSteamAudioSerializedObjectReader Reader(AssetObject, Context);
+    IPLSerializedObject SerializedObject = Reader.GetSerializedObject();
+    if (!SerializedObject)
         return nullptr;
-    }
 
     IPLProbeBatch ProbeBatch = nullptr;
-    Status = iplProbeBatchLoad(Context, SerializedObject, &ProbeBatch);
+    IPLerror Status = iplProbeBatchLoad(Context, SerializedObject, &ProbeBatch);
     if (Status != IPL_STATUS_SUCCESS)
     {
         UE_LOG(LogSteamAudio, Error, TEXT("Unable to load probe batch from serialized object. [%d]"), Status);
-        iplSerializedObjectRelease(&SerializedObject);
         return nullptr;
     }
 
-    iplSerializedObjectRelease(&SerializedObject);
     return ProbeBatch;
 }
 
+void LoadProbeBatchFromAssetAsync(FSoftObjectPath Asset, IPLContext Context, TFunction<void(IPLProbeBatch)> OnLoaded,
+    TArray<IPLBakedDataIdentifier> LayersToRemove /* = TArray<IPLBakedDataIdentifier>() */)
+{
+    check(Asset.IsValid());
+    check(Context);
+
+    LoadFromAssetAsync<IPLProbeBatch>(Asset, [Context, LayersToRemove = MoveTemp(LayersToRemove)](const USteamAudioSerializedObject* AssetObject)
+    {
+        IPLProbeBatch ProbeBatch = LoadProbeBatchFromAsset(AssetObject, Context);
+        if (ProbeBatch)
+        {
+            for (IPLBakedDataIdentifier Identifier : LayersToRemove)
+            {
+                iplProbeBatchRemoveData(ProbeBatch, &Identifier);
+            }
+
+            iplProbeBatchCommit(ProbeBatch);
+        }
+
+        return ProbeBatch;
+    }, MoveTemp(OnLoaded));
+}
+
 }
@@ -19,6 +19,7 @@
 #include "SteamAudioModule.h"
 
 class USteamAudioDynamicObjectComponent;
+class USteamAudioSerializedObject;
 
 namespace SteamAudio {
 
@@ -57,6 +58,26 @@ bool STEAMAUDIO_API ExportDynamicObject(USteamAudioDynamicObjectComponent* Dynam
  */
 IPLStaticMesh STEAMAUDIO_API LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLContext Context, IPLScene Scene);
 
+/**
+ * Creates a Static Mesh object from the geometry and material data in an already-loaded asset. Does not touch any
+ * UObject state other than reading the asset's data, so it can be called from a worker thread as long as the asset
+ * is kept alive by the caller.
+ */
+IPLStaticMesh STEAMAUDIO_API LoadStaticMeshFromAsset(const USteamAudioSerializedObject* AssetObject, IPLContext Context, IPLScene Scene);
+
+/**
+ * Creates a new scene using the given settings, and adds the static mesh in an already-loaded asset to it. The scene
+ * is committed, so it can be instanced right away. Like the function above, this can be called from a worker thread.
+ */
+IPLScene STEAMAUDIO_API CreateSubSceneFromAsset(const USteamAudioSerializedObject* AssetObject, IPLContext Context, const IPLSceneSettings& SceneSettings);
+
+/**
+ * Asynchronous version of CreateSubSceneFromAsset. The asset is loaded in the background, and the scene is created on a
+ * worker thread. OnLoaded is called on the game thread with the new scene (or nullptr on failure), which the caller is
+ * responsible for releasing.
+ */
+void STEAMAUDIO_API LoadSubSceneFromAssetAsync(FSoftObjectPath Asset, IPLContext Context, const IPLSceneSettings& SceneSettings, TFunction<void(IPLScene)> OnLoaded);
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Baked Data Load/Unload
@@ -67,4 +88,19 @@ IPLStaticMesh STEAMAUDIO_API LoadStaticMeshFromAsset(FSoftObjectPath Asset, IPLC
  */
 IPLProbeBatch STEAMAUDIO_API LoadProbeBatchFromAsset(FSoftObjectPath Asset, IPLContext Context);
 
+/**
+ * Creates a Probe Batch object from the data in an already-loaded asset. Can be called from a worker thread as long as
+ * the asset is kept alive by the caller.
+ */
+IPLProbeBatch STEAMAUDIO_API LoadProbeBatchFromAsset(const USteamAudioSerializedObject* AssetObject, IPLContext Context);
+
+/**
+ * Asynchronous version of LoadProbeBatchFromAsset. The probe batch is also committed on the worker thread. OnLoaded is
+ * called on the game thread with the new Probe Batch object (or nullptr on failure), which the caller is responsible
+ * for releasing. The layers of baked data in LayersToRemove are removed before the probe batch is committed, so they
+ * don't stay resident.
+ */
+void STEAMAUDIO_API LoadProbeBatchFromAssetAsync(FSoftObjectPath Asset, IPLContext Context, TFunction<void(IPLProbeBatch)> OnLoaded,
+    TArray<IPLBakedDataIdentifier> LayersToRemove = TArray<IPLBakedDataIdentifier>());
+
 }
@@ -0,0 +1,316 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioSceneStreamer.h"
+#include "Async/Async.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioScene.h"
+#include "SteamAudioSerializedObject.h"
+#include "SteamAudioStaticMeshActor.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSceneStreamer
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioSceneStreamer::FSteamAudioSceneStreamer(FSteamAudioManager& InManager)
+    : Manager(InManager)
+    , NumWorkerTasks(0)
+{}
+
+FSteamAudioSceneStreamer::~FSteamAudioSceneStreamer()
+{
+    check(StreamedGeometry.Num() == 0);
+    check(NumWorkerTasks == 0);
+}
+
+void FSteamAudioSceneStreamer::RequestLoad(ASteamAudioStaticMeshActor* StaticMeshActor)
+{
+    check(IsInGameThread());
+    check(StaticMeshActor);
+
+    if (!StaticMeshActor->Asset.IsAsset())
+        return;
+
+    uint32 ActorId = StaticMeshActor->GetUniqueID();
+    if (const TArray<TSharedPtr<FStreamedGeometry>>* ExistingGeometry = StreamedGeometry.Find(ActorId))
+    {
+        bool bAnyFailed = ExistingGeometry->ContainsByPredicate([](const TSharedPtr<FStreamedGeometry>& Geometry)
+        {
+            return Geometry->bFailed;
+        });
+
+        if (!bAnyFailed)
+            return;
+
+        // Unload whatever did load, so the actor's geometry is loaded again from scratch.
+        RequestUnload(StaticMeshActor);
+    }
+
+    FSteamAudioDoubleBufferedScene* Scene = Manager.GetDoubleBufferedScene().Get();
+    FSteamAudioDoubleBufferedScene* ReflectionScene = Manager.GetDoubleBufferedReflectionScene().Get();
+
+    TArray<TSharedPtr<FStreamedGeometry>>& ActorGeometry = StreamedGeometry.Add(ActorId);
+
+    if (ReflectionScene == Scene)
+    {
+        ActorGeometry.Add(StartLoad(StaticMeshActor->Asset, {Scene}));
+    }
+    else if (StaticMeshActor->ReflectionAsset.IsAsset())
+    {
+        ActorGeometry.Add(StartLoad(StaticMeshActor->Asset, {Scene}));
+        ActorGeometry.Add(StartLoad(StaticMeshActor->ReflectionAsset, {ReflectionScene}));
+    }
+    else
+    {
+        // This level was exported without reflection geometry, so use the full geometry for reflections too.
+        ActorGeometry.Add(StartLoad(StaticMeshActor->Asset, {Scene, ReflectionScene}));
+    }
+}
+
+void FSteamAudioSceneStreamer::RequestUnload(ASteamAudioStaticMeshActor* StaticMeshActor)
+{
+    check(IsInGameThread());
+    check(StaticMeshActor);
+
+    TArray<TSharedPtr<FStreamedGeometry>> ActorGeometry;
+    if (!StreamedGeometry.RemoveAndCopyValue(StaticMeshActor->GetUniqueID(), ActorGeometry))
+        return;
+
+    for (const TSharedPtr<FStreamedGeometry>& Geometry : ActorGeometry)
+    {
+        CancelLoad(Geometry);
+    }
+}
+
+void FSteamAudioSceneStreamer::ApplyPendingChanges()
+{
+    check(IsInGameThread());
+
+    TArray<TSharedPtr<FStreamedGeometry>> FinishedLoads;
+    {
+        FScopeLock Lock(&CompletedLoadsCriticalSection);
+        FinishedLoads = MoveTemp(CompletedLoads);
+        CompletedLoads.Reset();
+    }
+
+    for (const TSharedPtr<FStreamedGeometry>& Geometry : FinishedLoads)
+    {
+        Geometry->bDeserializing = false;
+
+        // The worker thread is done reading from the asset, so it can now be garbage collected.
+        if (Geometry->Handle.IsValid())
+        {
+            Geometry->Handle->ReleaseHandle();
+            Geometry->Handle.Reset();
+        }
+
+        if (!Geometry->SubScene)
+        {
+            Geometry->bFailed = true;
+            continue;
+        }
+
+        if (Geometry->bCancelled)
+        {
+            RetiredGeometry.Add(Geometry);
+            continue;
+        }
+
+        // The geometry was exported in world space, so it is instanced with an identity transform.
+        for (FSteamAudioDoubleBufferedScene* TargetScene : Geometry->TargetScenes)
+        {
+            FSteamAudioDoubleBufferedScene::FInstanceHandle Instance = TargetScene->AddInstance(Geometry->SubScene, ConvertTransform(FTransform::Identity));
+            if (Instance == INDEX_NONE)
+            {
+                UE_LOG(LogSteamAudio, Error, TEXT("Unable to instance static geometry: %s"), *Geometry->Asset.ToString());
+                break;
+            }
+
+            Geometry->Instances.Add(Instance);
+        }
+
+        if (Geometry->Instances.Num() < Geometry->TargetScenes.Num())
+        {
+            for (int i = 0; i < Geometry->Instances.Num(); ++i)
+            {
+                Geometry->TargetScenes[i]->RemoveInstance(Geometry->Instances[i]);
+            }
+
+            Geometry->Instances.Empty();
+            Geometry->bFailed = true;
+            RetiredGeometry.Add(Geometry);
+        }
+    }
+
+    for (const TSharedPtr<FStreamedGeometry>& Geometry : PendingRemovals)
+    {
+        for (int i = 0; i < Geometry->Instances.Num(); ++i)
+        {
+            Geometry->TargetScenes[i]->RemoveInstance(Geometry->Instances[i]);
+        }
+
+        Geometry->Instances.Empty();
+        RetiredGeometry.Add(Geometry);
+    }
+
+    PendingRemovals.Reset();
+}
+
+void FSteamAudioSceneStreamer::ReleaseRetiredGeometry()
+{
+    check(IsInGameThread());
+
+    if (RetiredGeometry.Num() == 0)
+        return;
+
+    // Releasing a sub-scene that never made it into the scene frees its acceleration structures, which can take a
+    // while for large levels.
+    NumWorkerTasks++;
+    Async(EAsyncExecution::ThreadPool, [this, Retired = MoveTemp(RetiredGeometry)]()
+    {
+        for (const TSharedPtr<FStreamedGeometry>& Geometry : Retired)
+        {
+            ReleaseGeometry(Geometry);
+        }
+
+        NumWorkerTasks--;
+    });
+
+    RetiredGeometry.Reset();
+}
+
+void FSteamAudioSceneStreamer::Reset()
+{
+    // The manager is also shut down from worker threads after exporting or baking, in which case nothing was ever
+    // streamed in.
+    if (StreamedGeometry.Num() == 0 && NumWorkerTasks == 0 && CompletedLoads.Num() == 0 && PendingRemovals.Num() == 0 && RetiredGeometry.Num() == 0)
+        return;
+
+    check(IsInGameThread());
+
+    for (auto& Pair : StreamedGeometry)
+    {
+        for (const TSharedPtr<FStreamedGeometry>& Geometry : Pair.Value)
+        {
+            CancelLoad(Geometry);
+        }
+    }
+
+    StreamedGeometry.Empty();
+
+    // Wait for in-flight deserialization and release tasks, since they reference the devices used to create the scene.
+    while (NumWorkerTasks > 0)
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    ApplyPendingChanges();
+
+    for (const TSharedPtr<FStreamedGeometry>& Geometry : RetiredGeometry)
+    {
+        ReleaseGeometry(Geometry);
+    }
+
+    RetiredGeometry.Empty();
+}
+
+TSharedPtr<FSteamAudioSceneStreamer::FStreamedGeometry> FSteamAudioSceneStreamer::StartLoad(const FSoftObjectPath& Asset, TArrayView<FSteamAudioDoubleBufferedScene* const> TargetScenes)
+{
+    TSharedPtr<FStreamedGeometry> Geometry = MakeShared<FStreamedGeometry>();
+    Geometry->Asset = Asset;
+    Geometry->TargetScenes.Append(TargetScenes.GetData(), TargetScenes.Num());
+
+    Geometry->Handle = Manager.GetStreamableManager().RequestAsyncLoad(Geometry->Asset, FStreamableDelegate::CreateLambda([this, Geometry]()
+    {
+        OnAssetLoaded(Geometry);
+    }));
+
+    return Geometry;
+}
+
+void FSteamAudioSceneStreamer::CancelLoad(const TSharedPtr<FStreamedGeometry>& Geometry)
+{
+    Geometry->bCancelled = true;
+
+    if (Geometry->Instances.Num() > 0)
+    {
+        // The geometry is part of the scene, so remove it at the next commit.
+        PendingRemovals.Add(Geometry);
+    }
+    else if (Geometry->Handle.IsValid() && !Geometry->bDeserializing)
+    {
+        // The asset is still loading, so just stop loading it.
+        Geometry->Handle->CancelHandle();
+        Geometry->Handle.Reset();
+    }
+
+    // Otherwise, the geometry is being deserialized on a worker thread, and will be released once that finishes.
+}
+
+void FSteamAudioSceneStreamer::ReleaseGeometry(const TSharedPtr<FStreamedGeometry>& Geometry)
+{
+    iplSceneRelease(&Geometry->SubScene);
+}
+
+void FSteamAudioSceneStreamer::OnAssetLoaded(TSharedPtr<FStreamedGeometry> Geometry)
+{
+    check(IsInGameThread());
+
+    if (Geometry->bCancelled)
+        return;
+
+    const USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(Geometry->Asset.ResolveObject());
+    if (!AssetObject)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to load static geometry asset: %s"), *Geometry->Asset.ToString());
+
+        // Nothing was loaded, so there's nothing to keep alive. The geometry is loaded again if the actor requests it.
+        if (Geometry->Handle.IsValid())
+        {
+            Geometry->Handle->ReleaseHandle();
+            Geometry->Handle.Reset();
+        }
+
+        Geometry->bFailed = true;
+        return;
+    }
+
+    IPLContext Context = Manager.GetContext();
+    IPLSceneSettings SceneSettings = Manager.GetSceneSettings();
+
+    Geometry->bDeserializing = true;
+
+    NumWorkerTasks++;
+    Async(EAsyncExecution::ThreadPool, [this, Geometry, AssetObject, Context, SceneSettings]()
+    {
+        if (!Geometry->bCancelled)
+        {
+            Geometry->SubScene = CreateSubSceneFromAsset(AssetObject, Context, SceneSettings);
+        }
+
+        {
+            FScopeLock Lock(&CompletedLoadsCriticalSection);
+            CompletedLoads.Add(Geometry);
+        }
+
+        NumWorkerTasks--;
+    });
+}
+
+}
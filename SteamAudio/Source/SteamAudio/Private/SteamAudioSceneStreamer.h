@@ -0,0 +1,131 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+#include "Engine/StreamableManager.h"
+#include "SteamAudioDoubleBufferedScene.h"
+
+class ASteamAudioStaticMeshActor;
+
+namespace SteamAudio {
+
+class FSteamAudioManager;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSceneStreamer
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Streams the static geometry of (sub)levels in and out of the main scene without blocking the game thread. Each
+ * level's geometry is loaded asynchronously, deserialized into its own sub-scene on a worker thread, and instanced
+ * into the main scene the next time the manager commits it. Since requests are driven by the Begin/EndPlay of each
+ * level's Steam Audio Static Mesh actor, acoustic geometry follows level streaming and World Partition cells. If the
+ * manager uses a separate scene for reflections, each level's reflection geometry is streamed into that scene (or its
+ * full geometry is instanced into both scenes, if it has no reflection geometry).
+ */
+class FSteamAudioSceneStreamer
+{
+public:
+    FSteamAudioSceneStreamer(FSteamAudioManager& InManager);
+
+    ~FSteamAudioSceneStreamer();
+
+    /** Starts loading the static geometry referenced by the given actor. Returns immediately. If an earlier load for
+        the same actor failed, it is tried again. */
+    void RequestLoad(ASteamAudioStaticMeshActor* StaticMeshActor);
+
+    /** Stops using the static geometry referenced by the given actor. Returns immediately; any in-flight load is
+        cancelled, and the geometry is released on a worker thread once it is no longer part of the committed scene. */
+    void RequestUnload(ASteamAudioStaticMeshActor* StaticMeshActor);
+
+    /** Adds geometry that has finished loading to the scene(s), and removes geometry that has been unloaded. The
+        changes take effect once the scene(s) have been committed and swapped in. Call on the game thread. */
+    void ApplyPendingChanges();
+
+    /** Releases geometry that was removed from the scene by the last call to ApplyPendingChanges, on a worker thread.
+        The scene(s) keep their own references to geometry that is still in use. */
+    void ReleaseRetiredGeometry();
+
+    /** Cancels all in-flight loads and releases all geometry. Blocks until worker threads are done. Call before
+        releasing the scene(s). */
+    void Reset();
+
+private:
+    /** State of a single geometry asset referenced by a Steam Audio Static Mesh actor. */
+    struct FStreamedGeometry
+    {
+        /** The asset containing the serialized geometry. */
+        FSoftObjectPath Asset;
+
+        /** Handle to the async load request for the asset. Only accessed on the game thread. */
+        TSharedPtr<FStreamableHandle> Handle;
+
+        /** The sub-scene containing the deserialized geometry. Written by the worker thread. */
+        IPLScene SubScene = nullptr;
+
+        /** The scenes into which the sub-scene should be instanced. */
+        TArray<FSteamAudioDoubleBufferedScene*, TInlineAllocator<2>> TargetScenes;
+
+        /** The instances of the sub-scene in each target scene. Empty until the geometry is added. */
+        TArray<FSteamAudioDoubleBufferedScene::FInstanceHandle, TInlineAllocator<2>> Instances;
+
+        /** True if the geometry was unloaded before the load finished. */
+        std::atomic<bool> bCancelled{ false };
+
+        /** True while a worker thread is deserializing the geometry. */
+        bool bDeserializing = false;
+
+        /** True if the asset couldn't be loaded or deserialized. Only accessed on the game thread. */
+        bool bFailed = false;
+    };
+
+    /** Starts loading the given asset, to be instanced into the given scenes. */
+    TSharedPtr<FStreamedGeometry> StartLoad(const FSoftObjectPath& Asset, TArrayView<FSteamAudioDoubleBufferedScene* const> TargetScenes);
+
+    /** Cancels any in-flight load for the given geometry, and schedules it for removal if it has been added. */
+    void CancelLoad(const TSharedPtr<FStreamedGeometry>& Geometry);
+
+    /** Releases the sub-scene for the given geometry. */
+    static void ReleaseGeometry(const TSharedPtr<FStreamedGeometry>& Geometry);
+
+    /** Called on the game thread once the asset for the given geometry has been loaded. */
+    void OnAssetLoaded(TSharedPtr<FStreamedGeometry> Geometry);
+
+    /** The manager that owns this object. */
+    FSteamAudioManager& Manager;
+
+    /** Geometry for each Steam Audio Static Mesh actor that has requested a load, indexed by actor id. */
+    TMap<uint32, TArray<TSharedPtr<FStreamedGeometry>>> StreamedGeometry;
+
+    /** Geometry whose deserialization has finished (successfully or not), waiting to be added to the scene. */
+    TArray<TSharedPtr<FStreamedGeometry>> CompletedLoads;
+
+    /** Guards CompletedLoads, which is written to by worker threads. */
+    FCriticalSection CompletedLoadsCriticalSection;
+
+    /** Geometry that has been unloaded, and must be removed from the scene at the next commit. */
+    TArray<TSharedPtr<FStreamedGeometry>> PendingRemovals;
+
+    /** Geometry that has been removed from the scene (or never added), and must be released. */
+    TArray<TSharedPtr<FStreamedGeometry>> RetiredGeometry;
+
+    /** Number of tasks currently running on worker threads. */
+    std::atomic<int32> NumWorkerTasks;
+};
+
+}
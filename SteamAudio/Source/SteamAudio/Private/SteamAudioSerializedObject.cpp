@@ -20,12 +20,238 @@
 #include "UObject/SavePackage.h"
 #endif
 #include "UObject/UObjectGlobals.h"
+#include "Serialization/CustomVersion.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioScene.h"
+#include "SteamAudioSettings.h"
+#if WITH_EDITOR
+#include "Interfaces/ITargetPlatform.h"
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSerializedObjectVersion
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Versions of the serialized representation of USteamAudioSerializedObject.
+ */
+struct FSteamAudioSerializedObjectVersion
+{
+    enum Type
+    {
+        /** Data is stored in a UPROPERTY array. */
+        BeforeCustomVersionWasAdded = 0,
+
+        /** Data is stored as bulk data. */
+        BulkData,
+
+        VersionPlusOne,
+        LatestVersion = VersionPlusOne - 1
+    };
+
+    static const FGuid GUID;
+};
+
+const FGuid FSteamAudioSerializedObjectVersion::GUID(0x5A3C8E21, 0x7F4B4D92, 0xB6E01C3D, 0x94A2F857);
+
+static FCustomVersionRegistration GRegisterSteamAudioSerializedObjectVersion(FSteamAudioSerializedObjectVersion::GUID, FSteamAudioSerializedObjectVersion::LatestVersion, TEXT("SteamAudioSerializedObjectVer"));
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioBakedDataInfo
+// ---------------------------------------------------------------------------------------------------------------------
+
+IPLBakedDataIdentifier FSteamAudioBakedDataInfo::GetIdentifier() const
+{
+    IPLBakedDataIdentifier Identifier{};
+    Identifier.type = static_cast<IPLBakedDataType>(Type);
+    Identifier.variation = static_cast<IPLBakedDataVariation>(Variation);
+    Identifier.endpointInfluence.center = SteamAudio::ConvertVector(EndpointCenter);
+    Identifier.endpointInfluence.radius = EndpointRadius;
+    return Identifier;
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // USteamAudioSerializedObject
 // ---------------------------------------------------------------------------------------------------------------------
 
-USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName)
+void USteamAudioSerializedObject::Serialize(FArchive& Ar)
+{
+    Ar.UsingCustomVersion(FSteamAudioSerializedObjectVersion::GUID);
+
+    if (Ar.IsSaving() && Data.Num() > 0)
+    {
+        MoveDataToBulkData();
+    }
+
+    Super::Serialize(Ar);
+
+    if (Ar.CustomVer(FSteamAudioSerializedObjectVersion::GUID) >= FSteamAudioSerializedObjectVersion::BulkData)
+    {
+#if WITH_EDITOR
+        // Layers of baked data that aren't used on the target platform are left out of the cooked data. The stripped
+        // data is written from its own bulk data, so the asset in the editor keeps all of its layers.
+        TArray<uint8> StrippedData;
+        if (Ar.IsSaving() && Ar.IsCooking() && GetStrippedData(Ar.CookingTarget(), StrippedData))
+        {
+            SetBulkData(CookedBulkData, StrippedData.GetData(), StrippedData.Num());
+            CookedBulkData.Serialize(Ar, this, INDEX_NONE, false);
+            return;
+        }
+#endif
+
+        // The data isn't memory-mapped, since a mapping would stay resident for as long as the asset is loaded, on top
+        // of the copy Steam Audio makes when the object is created from it.
+        BulkData.Serialize(Ar, this, INDEX_NONE, false);
+    }
+}
+
+int64 USteamAudioSerializedObject::GetDataSize() const
+{
+    if (Data.Num() > 0)
+        return Data.Num();
+
+    return BulkData.GetBulkDataSize();
+}
+
+void USteamAudioSerializedObject::MoveDataToBulkData()
+{
+    SetBulkData(Data.GetData(), Data.Num());
+    Data.Empty();
+}
+
+void USteamAudioSerializedObject::SetBulkData(const uint8* Buffer, int64 Size)
+{
+    SetBulkData(BulkData, Buffer, Size);
+}
+
+void USteamAudioSerializedObject::SetBulkData(FByteBulkData& Target, const uint8* Buffer, int64 Size)
+{
+    FScopeLock Lock(&BulkDataCriticalSection);
+
+    Target.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(Target.Realloc(Size), Buffer, Size);
+    Target.Unlock();
+
+    // Never store the data inline with the object, so it isn't loaded until it is needed.
+    uint32 BulkDataFlags = BULKDATA_Force_NOT_InlinePayload;
+
+    switch (GetDefault<USteamAudioSettings>()->SerializedDataCompression)
+    {
+    case ESerializedDataCompression::ZLIB:
+        Target.StoreCompressedOnDisk(NAME_Zlib);
+        break;
+    case ESerializedDataCompression::OODLE:
+#if ((ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 0) || (ENGINE_MAJOR_VERSION > 5))
+        Target.StoreCompressedOnDisk(NAME_Oodle);
+#else
+        Target.StoreCompressedOnDisk(NAME_Zlib);
+#endif
+        break;
+    default:
+        Target.StoreCompressedOnDisk(NAME_None);
+        break;
+    }
+
+    Target.SetBulkDataFlags(BulkDataFlags);
+}
+
+#if WITH_EDITOR
+bool USteamAudioSerializedObject::GetStrippedData(const ITargetPlatform* TargetPlatform, TArray<uint8>& OutData)
+{
+    if (!TargetPlatform || BakedLayers.Num() == 0)
+        return false;
+
+    const FSteamAudioBakedDataPlatformRule* Rule = GetDefault<USteamAudioSettings>()->BakedDataPlatformRules.Find(TargetPlatform->IniPlatformName());
+    if (!Rule)
+        return false;
+
+    TArray<const FSteamAudioBakedDataInfo*> StrippedLayers;
+    for (const FSteamAudioBakedDataInfo& Layer : BakedLayers)
+    {
+        if (Rule->ShouldStrip(static_cast<IPLBakedDataType>(Layer.Type), static_cast<IPLBakedDataVariation>(Layer.Variation)))
+        {
+            StrippedLayers.Add(&Layer);
+        }
+    }
+
+    if (StrippedLayers.Num() == 0)
+        return false;
+
+    IPLContext Context = SteamAudio::FSteamAudioModule::GetManager().GetContext();
+    IPLProbeBatch ProbeBatch = SteamAudio::LoadProbeBatchFromAsset(this, Context);
+    if (!ProbeBatch)
+    {
+        UE_LOG(LogSteamAudio, Warning, TEXT("Unable to load probe batch to strip baked data: %s"), *GetPathName());
+        return false;
+    }
+
+    for (const FSteamAudioBakedDataInfo* Layer : StrippedLayers)
+    {
+        IPLBakedDataIdentifier Identifier = Layer->GetIdentifier();
+        iplProbeBatchRemoveData(ProbeBatch, &Identifier);
+    }
+
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    IPLSerializedObject SerializedObject = nullptr;
+    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Warning, TEXT("Unable to create serialized object. [%d]"), Status);
+        iplProbeBatchRelease(&ProbeBatch);
+        return false;
+    }
+
+    iplProbeBatchSave(ProbeBatch, SerializedObject);
+    OutData.Append(iplSerializedObjectGetData(SerializedObject), iplSerializedObjectGetSize(SerializedObject));
+
+    iplSerializedObjectRelease(&SerializedObject);
+    iplProbeBatchRelease(&ProbeBatch);
+
+    UE_LOG(LogSteamAudio, Log, TEXT("Stripped %d of %d baked data layers from %s for %s (%lld -> %d bytes)."), StrippedLayers.Num(),
+        BakedLayers.Num(), *GetPathName(), *TargetPlatform->IniPlatformName(), GetDataSize(), OutData.Num());
+
+    return true;
+}
+
+#if ((ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 0) || (ENGINE_MAJOR_VERSION > 5))
+void USteamAudioSerializedObject::PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext)
+{
+    Super::PostSaveRoot(ObjectSaveContext);
+    FinishCooking();
+}
+#else
+void USteamAudioSerializedObject::PostSaveRoot(bool bCleanupIsRequired)
+{
+    Super::PostSaveRoot(bCleanupIsRequired);
+    FinishCooking();
+}
+#endif
+
+void USteamAudioSerializedObject::FinishCooking()
+{
+    int64 CookedSize = CookedBulkData.GetBulkDataSize();
+    if (CookedSize == 0)
+        return;
+
+    // The payload written for the package comes from CookedBulkData, so this is the size of the cooked data. Logged as
+    // an error so the cook fails if stripping didn't make the data smaller.
+    int64 FullSize = BulkData.GetBulkDataSize();
+    if (CookedSize >= FullSize)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Cooked data for %s is not smaller than the full data after stripping baked data layers (%lld >= %lld bytes)."),
+            *GetPathName(), CookedSize, FullSize);
+    }
+
+    CookedBulkData.RemoveBulkData();
+}
+#endif
+
+USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName,
+    const TArray<FSteamAudioBakedDataInfo>& BakedLayers /* = TArray<FSteamAudioBakedDataInfo>() */)
 {
     int DataSize = iplSerializedObjectGetSize(SerializedObject);
     uint8* DataBuffer = iplSerializedObjectGetData(SerializedObject);
@@ -48,8 +274,8 @@ USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPacka
         return nullptr;
 
     // Copy the data into the UObject.
-    Object->Data.SetNum(DataSize);
-    FMemory::Memcpy(Object->Data.GetData(), DataBuffer, DataSize);
+    Object->SetBulkData(DataBuffer, DataSize);
+    Object->BakedLayers = BakedLayers;
 
     // Save the package.
     Package->MarkPackageDirty();
@@ -67,3 +293,83 @@ USteamAudioSerializedObject* USteamAudioSerializedObject::SerializeObjectToPacka
 
     return Object;
 }
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSerializedObjectReader
+// ---------------------------------------------------------------------------------------------------------------------
+
+FSteamAudioSerializedObjectReader::FSteamAudioSerializedObjectReader(const USteamAudioSerializedObject* InAsset, IPLContext Context)
+    : Asset(InAsset)
+    , Buffer(nullptr)
+    , bBulkDataLocked(false)
+    , SerializedObject(nullptr)
+{
+    check(Asset);
+    check(Context);
+
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    if (Asset->Data.Num() > 0)
+    {
+        // Assets saved by older versions of the plugin keep their data in memory.
+        SerializedObjectSettings.size = Asset->Data.Num();
+        SerializedObjectSettings.data = const_cast<uint8*>(Asset->Data.GetData());
+    }
+    else
+    {
+        FByteBulkData& BulkData = const_cast<FByteBulkData&>(Asset->BulkData);
+
+        // Held until the reader is destroyed if the bulk data is locked, since it can only be locked once at a time.
+        Asset->BulkDataCriticalSection.Lock();
+
+        SerializedObjectSettings.size = BulkData.GetBulkDataSize();
+
+        bool bCookedData = FPlatformProperties::RequiresCookedData();
+
+        if ((BulkData.IsBulkDataLoaded() && !bCookedData) || !BulkData.CanLoadFromDisk())
+        {
+            // The data is being edited, or was just created in the editor, so it can be used in place.
+            SerializedObjectSettings.data = static_cast<IPLbyte*>(const_cast<void*>(BulkData.LockReadOnly()));
+            bBulkDataLocked = true;
+        }
+        else
+        {
+            // Read (and if needed, decompress) the data directly into a temporary buffer, so no copy is kept in the
+            // asset once the Steam Audio object has been created from it. In cooked builds, a copy that is already
+            // loaded is handed over and released from the asset; it can be read from disk again if needed.
+            BulkData.GetCopy(&Buffer, bCookedData);
+            SerializedObjectSettings.data = static_cast<IPLbyte*>(Buffer);
+            Asset->BulkDataCriticalSection.Unlock();
+        }
+    }
+
+    if (!SerializedObjectSettings.data || SerializedObjectSettings.size == 0)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to read data from asset: %s"), *Asset->GetPathName());
+        return;
+    }
+
+    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudio, Error, TEXT("Unable to create serialized object. [%d]"), Status);
+        SerializedObject = nullptr;
+    }
+}
+
+FSteamAudioSerializedObjectReader::~FSteamAudioSerializedObjectReader()
+{
+    iplSerializedObjectRelease(&SerializedObject);
+
+    if (Buffer)
+    {
+        FMemory::Free(Buffer);
+    }
+
+    if (bBulkDataLocked)
+    {
+        const_cast<FByteBulkData&>(Asset->BulkData).Unlock();
+        Asset->BulkDataCriticalSection.Unlock();
+    }
+}
@@ -16,8 +16,33 @@
 
 #include "SteamAudioSettings.h"
 #include "SteamAudioMaterial.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Engine/CollisionProfile.h"
 #include "SOFAFile.h"
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioBakedDataPlatformRule
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool FSteamAudioBakedDataPlatformRule::ShouldStrip(IPLBakedDataType Type, IPLBakedDataVariation Variation) const
+{
+    if (Type == IPL_BAKEDDATATYPE_PATHING)
+        return bStripPathing;
+
+    switch (Variation)
+    {
+    case IPL_BAKEDDATAVARIATION_REVERB:
+        return bStripReverb;
+    case IPL_BAKEDDATAVARIATION_STATICSOURCE:
+        return bStripStaticSourceReflections;
+    case IPL_BAKEDDATAVARIATION_STATICLISTENER:
+        return bStripStaticListenerReflections;
+    default:
+        return false;
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // USteamAudioSettings
 // ---------------------------------------------------------------------------------------------------------------------
@@ -29,7 +54,11 @@ USteamAudioSettings::USteamAudioSettings()
     , DefaultMeshMaterial("/SteamAudio/Materials/Default.Default")
     , DefaultLandscapeMaterial("/SteamAudio/Materials/Default.Default")
     , DefaultBSPMaterial("/SteamAudio/Materials/Default.Default")
+    , bUseReflectionGeometry(false)
+    , ReflectionGeometryLOD(2)
+    , ReflectionLandscapeStride(4)
     , SceneType(ESceneType::DEFAULT)
+    , PhysicsTraceChannel(ECC_GameTraceChannel1)
     , MaxOcclusionSamples(16)
     , RealTimeRays(4096)
     , RealTimeBounces(4)
@@ -46,6 +75,11 @@ USteamAudioSettings::USteamAudioSettings()
     , BakingAmbisonicOrder(1)
     , BakingCPUCoresPercentage(50)
     , BakingIrradianceMinDistance(1.0f)
+    , BakingMaxParallelProbeVolumes(0)
+    , BakingCheckpointInterval(300.0f)
+    , BakingGeometryInfluenceDistance(20.0f)
+    , BakingSavedDuration(0.0f)
+    , BakingReverbAmbisonicOrder(-1)
     , ReverbSubmix(nullptr)
     , BakingVisibilitySamples(4)
     , BakingVisibilityRadius(1.0f)
@@ -53,8 +87,17 @@ USteamAudioSettings::USteamAudioSettings()
     , BakingVisibilityRange(1000.0f)
     , BakingPathRange(1000.0f)
     , BakedPathingCPUCoresPercentage(50)
+    , bEnableBakeCache(false)
     , SimulationUpdateInterval(0.1f)
+    , DynamicObjectTranslationThreshold(5.0f)
+    , DynamicObjectRotationThreshold(1.0f)
+    , bEnableProbeStreaming(false)
+    , ProbeStreamingDistance(50.0f)
+    , ProbeStreamingMemoryBudget(0)
+    , ProbeStreamingChunkSize(50.0f)
+    , bLoadOnlyReferencedBakedLayers(false)
     , ReflectionEffectType(EReflectionEffectType::CONVOLUTION)
+    , bParametricReverbFastPath(false)
     , HybridReverbTransitionTime(1.0f)
     , HybridReverbOverlapPercent(25)
     , DeviceType(EOpenCLDeviceType::ANY)
@@ -67,6 +110,7 @@ USteamAudioSettings::USteamAudioSettings()
     , HRTFVolume(0.0f)
     , HRTFNormalizationType(EHRTFNormType::NONE)
     , SOFAFile(nullptr)
+    , SerializedDataCompression(ESerializedDataCompression::NONE)
     , EnableValidation(false)
 {}
 
@@ -79,7 +123,23 @@ FSteamAudioSettings USteamAudioSettings::GetSettings() const
     Settings.DefaultMeshMaterial = GetMaterialForAsset(DefaultMeshMaterial);
     Settings.DefaultLandscapeMaterial = GetMaterialForAsset(DefaultLandscapeMaterial);
     Settings.DefaultBSPMaterial = GetMaterialForAsset(DefaultBSPMaterial);
+    Settings.bUseReflectionGeometry = bUseReflectionGeometry;
     Settings.SceneType = static_cast<IPLSceneType>(SceneType);
+    Settings.PhysicsTraceChannel = PhysicsTraceChannel;
+    if (SceneType == ESceneType::PHYSICS && UCollisionProfile::Get()->ConvertToTraceType(PhysicsTraceChannel) == TraceTypeQuery_MAX)
+    {
+        UE_LOG(LogSteamAudio, Warning, TEXT("Physics trace channel %d is not a trace channel defined in this project, tracing on Visibility instead."),
+            static_cast<int32>(PhysicsTraceChannel.GetValue()));
+        Settings.PhysicsTraceChannel = ECC_Visibility;
+    }
+    for (const FSteamAudioPhysicalMaterialMapping& Mapping : PhysicalMaterialMappings)
+    {
+        const UPhysicalMaterial* PhysicalMaterial = Cast<UPhysicalMaterial>(Mapping.PhysicalMaterial.TryLoad());
+        if (PhysicalMaterial)
+        {
+            Settings.PhysicalMaterials.Add(PhysicalMaterial, GetMaterialForAsset(Mapping.Material));
+        }
+    }
     Settings.MaxOcclusionSamples = MaxOcclusionSamples;
     Settings.RealTimeRays = RealTimeRays;
     Settings.RealTimeBounces = RealTimeBounces;
@@ -96,6 +156,11 @@ FSteamAudioSettings USteamAudioSettings::GetSettings() const
     Settings.BakingAmbisonicOrder = BakingAmbisonicOrder;
     Settings.BakingCPUCoresPercentage = BakingCPUCoresPercentage;
     Settings.BakedPathingCPUCoresPercentage = BakedPathingCPUCoresPercentage;
+    Settings.BakingMaxParallelProbeVolumes = BakingMaxParallelProbeVolumes;
+    Settings.BakingCheckpointInterval = BakingCheckpointInterval;
+    Settings.BakingGeometryInfluenceDistance = BakingGeometryInfluenceDistance;
+    Settings.BakingSavedDuration = BakingSavedDuration;
+    Settings.BakingReverbAmbisonicOrder = BakingReverbAmbisonicOrder;
     Settings.ReverbSubmix = nullptr;
     Settings.BakingVisibilitySamples = BakingVisibilitySamples;
     Settings.BakingVisibilityRadius = BakingVisibilityRadius;
@@ -103,8 +168,22 @@ FSteamAudioSettings USteamAudioSettings::GetSettings() const
     Settings.BakingVisibilityRange = BakingVisibilityRange;
     Settings.BakingPathRange = BakingPathRange;
     Settings.BakedPathingCPUCoresPercentage = BakedPathingCPUCoresPercentage;
+    Settings.bEnableBakeCache = bEnableBakeCache;
+    Settings.BakeCacheDirectory = BakeCacheDirectory;
     Settings.SimulationUpdateInterval = SimulationUpdateInterval;
+    Settings.DynamicObjectTranslationThreshold = DynamicObjectTranslationThreshold;
+    Settings.DynamicObjectRotationThreshold = DynamicObjectRotationThreshold;
+    Settings.bEnableProbeStreaming = bEnableProbeStreaming;
+    Settings.ProbeStreamingDistance = ProbeStreamingDistance;
+    Settings.ProbeStreamingMemoryBudget = ProbeStreamingMemoryBudget;
+    Settings.ProbeStreamingChunkSize = ProbeStreamingChunkSize;
+    if (const FSteamAudioBakedDataPlatformRule* Rule = BakedDataPlatformRules.Find(FPlatformProperties::IniPlatformName()))
+    {
+        Settings.BakedDataPlatformRule = *Rule;
+    }
+    Settings.bLoadOnlyReferencedBakedLayers = bLoadOnlyReferencedBakedLayers;
     Settings.ReflectionEffectType = static_cast<IPLReflectionEffectType>(ReflectionEffectType);
+    Settings.bParametricReverbFastPath = bParametricReverbFastPath;
     Settings.HybridReverbTransitionTime = HybridReverbTransitionTime;
     Settings.HybridReverbOverlapPercent = HybridReverbOverlapPercent;
     Settings.OpenCLDeviceType = static_cast<IPLOpenCLDeviceType>(DeviceType);
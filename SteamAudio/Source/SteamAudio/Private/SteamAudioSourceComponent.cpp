@@ -22,6 +22,7 @@
 #include "SteamAudioListenerComponent.h"
 #include "SteamAudioManager.h"
 #include "SteamAudioProbeVolume.h"
+#include "SteamAudioProxyOccluders.h"
 #include "SteamAudioSettings.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -48,6 +49,8 @@ USteamAudioSourceComponent::USteamAudioSourceComponent()
     , bFindAlternatePaths(true)
     , Source(nullptr)
     , Simulator(nullptr)
+    , ReflectionSource(nullptr)
+    , ReflectionSimulator(nullptr)
     , AudioEngineSource(nullptr)
 {
     bAutoActivate = true;
@@ -67,7 +70,8 @@ void USteamAudioSourceComponent::SetInputs(IPLSimulationFlags Flags)
     {
         Inputs.flags = static_cast<IPLSimulationFlags>(Inputs.flags | IPL_SIMULATIONFLAGS_REFLECTIONS);
     }
-    if (bSimulatePathing && PathingProbeBatch)
+    // The pathing probe batch may not be loaded yet, or may have been unloaded by probe streaming.
+    if (bSimulatePathing && PathingProbeBatch && PathingProbeBatch->GetProbeBatch())
     {
         Inputs.flags = static_cast<IPLSimulationFlags>(Inputs.flags | IPL_SIMULATIONFLAGS_PATHING);
     }
@@ -111,6 +115,26 @@ void USteamAudioSourceComponent::SetInputs(IPLSimulationFlags Flags)
 
     Inputs.bakedDataIdentifier = GetBakedDataIdentifier();
 
+    if (ReflectionSource)
+    {
+        const IPLSimulationFlags ReflectionFlags = static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING);
+        const IPLSimulationFlags InputFlags = Inputs.flags;
+
+        if (Flags & IPL_SIMULATIONFLAGS_DIRECT)
+        {
+            Inputs.flags = static_cast<IPLSimulationFlags>(InputFlags & IPL_SIMULATIONFLAGS_DIRECT);
+            iplSourceSetInputs(Source, IPL_SIMULATIONFLAGS_DIRECT, &Inputs);
+        }
+
+        if (Flags & ReflectionFlags)
+        {
+            Inputs.flags = static_cast<IPLSimulationFlags>(InputFlags & ReflectionFlags);
+            iplSourceSetInputs(ReflectionSource, static_cast<IPLSimulationFlags>(Flags & ReflectionFlags), &Inputs);
+        }
+
+        return;
+    }
+
     iplSourceSetInputs(Source, Flags, &Inputs);
 }
 
@@ -118,7 +142,25 @@ IPLSimulationOutputs USteamAudioSourceComponent::GetOutputs(IPLSimulationFlags F
 {
     IPLSimulationOutputs Outputs{};
 
-    if (Source)
+    if (ReflectionSource)
+    {
+        // Direct outputs come from the main simulator, and reflection and pathing outputs from the reflection simulator.
+        if (Flags & IPL_SIMULATIONFLAGS_DIRECT)
+        {
+            iplSourceGetOutputs(Source, IPL_SIMULATIONFLAGS_DIRECT, &Outputs);
+        }
+
+        const IPLSimulationFlags ReflectionFlags = static_cast<IPLSimulationFlags>(Flags & (IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+        if (ReflectionFlags)
+        {
+            IPLSimulationOutputs ReflectionOutputs{};
+            iplSourceGetOutputs(ReflectionSource, ReflectionFlags, &ReflectionOutputs);
+
+            Outputs.reflections = ReflectionOutputs.reflections;
+            Outputs.pathing = ReflectionOutputs.pathing;
+        }
+    }
+    else if (Source)
     {
         iplSourceGetOutputs(Source, Flags, &Outputs);
     }
@@ -134,6 +176,16 @@ void USteamAudioSourceComponent::UpdateOutputs(IPLSimulationFlags Flags)
     {
         if (bSimulateOcclusion)
         {
+            SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
+
+            // Proxy occluders and doors are layered on top of the simulated values here. When tracing against the
+            // physics scene, proxy occluders were already hit by the occlusion rays, so only doors are applied.
+            FVector SourcePosition = GetOwner()->GetActorLocation();
+            FVector ListenerPosition = SteamAudio::ConvertVectorInverse(Manager.GetListenerCoordinates().origin);
+            float VolumetricRadius = (OcclusionType == EOcclusionType::VOLUMETRIC) ? SteamAudio::ConvertSteamAudioDistanceToUnreal(OcclusionRadius) : 0.0f;
+
+            SteamAudio::FSteamAudioProxyOccluders::ApplyToDirectPath(*Manager.GetProxyOccluders().GetShapes(), SourcePosition, ListenerPosition, VolumetricRadius, bSimulateTransmission, Manager.IsUsingPhysicsScene(), Outputs.direct.occlusion, Outputs.direct.transmission);
+
             OcclusionValue = Outputs.direct.occlusion;
             if (bSimulateTransmission)
             {
@@ -216,6 +268,13 @@ void USteamAudioSourceComponent::Shutdown(SteamAudio::FSteamAudioManager& Manage
 		iplSourceRelease(&Source);
 		iplSimulatorRelease(&Simulator);
 	}
+
+	if (ReflectionSimulator && ReflectionSource)
+	{
+		iplSourceRemove(ReflectionSource, ReflectionSimulator);
+		iplSourceRelease(&ReflectionSource);
+		iplSimulatorRelease(&ReflectionSimulator);
+	}
 }
 
 #if WITH_EDITOR
@@ -268,6 +327,10 @@ void USteamAudioSourceComponent::BeginPlay()
 
     IPLSourceSettings SourceSettings{};
     SourceSettings.flags = static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_DIRECT | IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING);
+    if (Manager.HasSeparateReflectionScene())
+    {
+        SourceSettings.flags = IPL_SIMULATIONFLAGS_DIRECT;
+    }
 
     IPLerror Status = iplSourceCreate(Simulator, &SourceSettings, &Source);
     if (Status != IPL_STATUS_SUCCESS)
@@ -277,6 +340,26 @@ void USteamAudioSourceComponent::BeginPlay()
         return;
     }
 	
+    if (Manager.HasSeparateReflectionScene())
+    {
+        ReflectionSimulator = iplSimulatorRetain(Manager.GetReflectionSimulator());
+
+        IPLSourceSettings ReflectionSourceSettings{};
+        ReflectionSourceSettings.flags = static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING);
+
+        Status = iplSourceCreate(ReflectionSimulator, &ReflectionSourceSettings, &ReflectionSource);
+        if (Status != IPL_STATUS_SUCCESS)
+        {
+            UE_LOG(LogSteamAudio, Error, TEXT("Unable to create source. [%d]"), Status);
+            iplSourceRelease(&Source);
+            iplSimulatorRelease(&Simulator);
+            iplSimulatorRelease(&ReflectionSimulator);
+            return;
+        }
+
+        iplSourceAdd(ReflectionSource, ReflectionSimulator);
+    }
+
 	bIsStarted = true;
 
     iplSourceAdd(Source, Simulator);
@@ -17,7 +17,7 @@
 #include "SteamAudioStaticMeshActor.h"
 #include "EngineUtils.h"
 #include "SteamAudioManager.h"
-#include "SteamAudioScene.h"
+#include "SteamAudioSceneStreamer.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 // ASteamAudioStaticMeshActor
@@ -25,8 +25,9 @@
 
 ASteamAudioStaticMeshActor::ASteamAudioStaticMeshActor()
     : Asset()
-    , Scene(nullptr)
-    , StaticMesh(nullptr)
+    , ReflectionAsset()
+    , GeometryCellSize(0.0f)
+    , NumTriangles(0)
 {}
 
 void ASteamAudioStaticMeshActor::BeginPlay()
@@ -42,30 +43,20 @@ void ASteamAudioStaticMeshActor::BeginPlay()
     if (Manager.InitializedType() != SteamAudio::EManagerInitReason::PLAYING)
         return;
 
-    Scene = iplSceneRetain(Manager.GetScene());
-    if (!Scene)
+    // When tracing against the physics scene, the exported geometry isn't needed.
+    if (Manager.IsUsingPhysicsScene())
         return;
 
-    StaticMesh = SteamAudio::LoadStaticMeshFromAsset(Asset, Manager.GetContext(), Scene);
-    if (!StaticMesh)
-    {
-        iplSceneRelease(&Scene);
-        return;
-    }
-
-    iplStaticMeshAdd(StaticMesh, Scene);
+    // The geometry is loaded in the background, and added to the scene once it's ready. This way, streaming in a
+    // (sub)level or World Partition cell never stalls the game thread on acoustic geometry.
+    Manager.GetSceneStreamer().RequestLoad(this);
 }
 
 void ASteamAudioStaticMeshActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
 
-    if (Scene && StaticMesh)
-    {
-        iplStaticMeshRemove(StaticMesh, Scene);
-        iplStaticMeshRelease(&StaticMesh);
-        iplSceneRelease(&Scene);
-    }
+    Manager.GetSceneStreamer().RequestUnload(this);
 
     Super::EndPlay(EndPlayReason);
 }
@@ -83,3 +74,25 @@ ASteamAudioStaticMeshActor* ASteamAudioStaticMeshActor::FindInLevel(UWorld* Worl
 
     return nullptr;
 }
+
+uint32 ASteamAudioStaticMeshActor::GetGeometryHash(const FBox& Bounds) const
+{
+    if (GeometryCellSize <= 0.0f || GeometryCellHashes.Num() == 0)
+        return 0;
+
+    FIntVector MinCell(FMath::FloorToInt(Bounds.Min.X / GeometryCellSize), FMath::FloorToInt(Bounds.Min.Y / GeometryCellSize), FMath::FloorToInt(Bounds.Min.Z / GeometryCellSize));
+    FIntVector MaxCell(FMath::FloorToInt(Bounds.Max.X / GeometryCellSize), FMath::FloorToInt(Bounds.Max.Y / GeometryCellSize), FMath::FloorToInt(Bounds.Max.Z / GeometryCellSize));
+
+    // Cells are visited in no particular order, so their hashes are combined with a sum.
+    uint32 Hash = 1;
+    for (const TPair<FIntVector, uint32>& Cell : GeometryCellHashes)
+    {
+        const FIntVector& Index = Cell.Key;
+        if (Index.X < MinCell.X || Index.Y < MinCell.Y || Index.Z < MinCell.Z || Index.X > MaxCell.X || Index.Y > MaxCell.Y || Index.Z > MaxCell.Z)
+            continue;
+
+        Hash += HashCombine(GetTypeHash(Index), Cell.Value);
+    }
+
+    return (Hash != 0) ? Hash : 1;
+}
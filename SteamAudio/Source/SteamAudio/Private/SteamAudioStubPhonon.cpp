@@ -0,0 +1,667 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioStubPhonon.h"
+
+#if STEAMAUDIO_STUB_PHONON
+
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Stub Objects
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Base class for every object created through the stub API. Handles are pointers to these. */
+struct FStubObject
+{
+    std::atomic<int32> RefCount{ 1 };
+
+    virtual ~FStubObject() {}
+};
+
+struct FStubSerializedObject : public FStubObject
+{
+    TArray<uint8> Data;
+};
+
+struct FStubProbeSet : public FStubObject
+{
+    TArray<IPLSphere> Probes;
+};
+
+struct FStubSource : public FStubObject
+{
+    /** The most recent inputs for direct simulation. */
+    IPLSimulationInputs DirectInputs{};
+
+    /** The most recent inputs for reflections and pathing simulation. */
+    IPLSimulationInputs ReflectionInputs{};
+};
+
+struct FStubSimulator : public FStubObject
+{
+    FCriticalSection CriticalSection;
+
+    /** Sources that have been added, and committed. */
+    TArray<FStubSource*> Sources;
+
+    /** Sources that have been added or removed since the last commit. */
+    TArray<FStubSource*> SourcesToAdd;
+    TArray<FStubSource*> SourcesToRemove;
+
+    IPLSimulationSharedInputs ReflectionSharedInputs{};
+
+    ~FStubSimulator()
+    {
+        for (FStubSource* Source : Sources)
+        {
+            if (--Source->RefCount == 0)
+            {
+                delete Source;
+            }
+        }
+    }
+};
+
+template <typename T, typename THandle>
+static IPLerror CreateObject(THandle* Handle)
+{
+    *Handle = reinterpret_cast<THandle>(new T());
+    return IPL_STATUS_SUCCESS;
+}
+
+template <typename THandle>
+static THandle RetainObject(THandle Handle)
+{
+    if (Handle)
+    {
+        reinterpret_cast<FStubObject*>(Handle)->RefCount++;
+    }
+
+    return Handle;
+}
+
+template <typename THandle>
+static void ReleaseObject(THandle* Handle)
+{
+    if (!Handle || !*Handle)
+        return;
+
+    FStubObject* Object = reinterpret_cast<FStubObject*>(*Handle);
+    if (--Object->RefCount == 0)
+    {
+        delete Object;
+    }
+
+    *Handle = nullptr;
+}
+
+template <typename T, typename THandle>
+static T* GetStubObject(THandle Handle)
+{
+    return static_cast<T*>(reinterpret_cast<FStubObject*>(Handle));
+}
+
+static void ClearAudioBuffer(IPLAudioBuffer* Buffer)
+{
+    if (!Buffer || !Buffer->data)
+        return;
+
+    for (int i = 0; i < Buffer->numChannels; ++i)
+    {
+        FMemory::Memzero(Buffer->data[i], Buffer->numSamples * sizeof(IPLfloat32));
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Cost Model
+// ---------------------------------------------------------------------------------------------------------------------
+
+static std::atomic<double> GNanosecondsPerRay{ 0.0 };
+
+static std::atomic<int32> GNumDirectRuns{ 0 };
+static std::atomic<int32> GNumReflectionsRuns{ 0 };
+static std::atomic<int32> GNumPathingRuns{ 0 };
+static std::atomic<int64> GNumDirectRays{ 0 };
+static std::atomic<int64> GNumReflectionRays{ 0 };
+static std::atomic<int64> GNumPathingProbes{ 0 };
+
+/** Spins for the time modeled for the given number of rays. */
+static void SpendTime(int64 NumRays)
+{
+    double Nanoseconds = GNanosecondsPerRay;
+    if (NumRays <= 0 || Nanoseconds <= 0.0)
+        return;
+
+    double EndTime = FPlatformTime::Seconds() + NumRays * Nanoseconds * 1e-9;
+    while (FPlatformTime::Seconds() < EndTime)
+    {
+    }
+}
+
+void SetStubPhononNanosecondsPerRay(double Nanoseconds)
+{
+    GNanosecondsPerRay = FMath::Max(Nanoseconds, 0.0);
+}
+
+FStubPhononStats GetStubPhononStats()
+{
+    FStubPhononStats Stats;
+    Stats.NumDirectRuns = GNumDirectRuns;
+    Stats.NumReflectionsRuns = GNumReflectionsRuns;
+    Stats.NumPathingRuns = GNumPathingRuns;
+    Stats.NumDirectRays = GNumDirectRays;
+    Stats.NumReflectionRays = GNumReflectionRays;
+    Stats.NumPathingProbes = GNumPathingProbes;
+    return Stats;
+}
+
+void ResetStubPhononStats()
+{
+    GNumDirectRuns = 0;
+    GNumReflectionsRuns = 0;
+    GNumPathingRuns = 0;
+    GNumDirectRays = 0;
+    GNumReflectionRays = 0;
+    GNumPathingProbes = 0;
+}
+
+}
+
+using namespace SteamAudio;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Context, Serialization, and Devices
+// ---------------------------------------------------------------------------------------------------------------------
+
+IPLerror IPLCALL iplContextCreate(IPLContextSettings* settings, IPLContext* context) { return CreateObject<FStubObject>(context); }
+IPLContext IPLCALL iplContextRetain(IPLContext context) { return RetainObject(context); }
+void IPLCALL iplContextRelease(IPLContext* context) { ReleaseObject(context); }
+
+IPLVector3 IPLCALL iplCalculateRelativeDirection(IPLContext context, IPLVector3 sourcePosition, IPLVector3 listenerPosition, IPLVector3 listenerAhead, IPLVector3 listenerUp)
+{
+    FVector Direction = FVector(sourcePosition.x - listenerPosition.x, sourcePosition.y - listenerPosition.y, sourcePosition.z - listenerPosition.z).GetSafeNormal();
+    FVector Ahead(listenerAhead.x, listenerAhead.y, listenerAhead.z);
+    FVector Up(listenerUp.x, listenerUp.y, listenerUp.z);
+    FVector Right = FVector::CrossProduct(Ahead, Up);
+
+    return IPLVector3{ static_cast<IPLfloat32>(FVector::DotProduct(Direction, Right)), static_cast<IPLfloat32>(FVector::DotProduct(Direction, Up)),
+        static_cast<IPLfloat32>(-FVector::DotProduct(Direction, Ahead)) };
+}
+
+IPLerror IPLCALL iplSerializedObjectCreate(IPLContext context, IPLSerializedObjectSettings* settings, IPLSerializedObject* serializedObject)
+{
+    CreateObject<FStubSerializedObject>(serializedObject);
+
+    if (settings && settings->data && settings->size > 0)
+    {
+        GetStubObject<FStubSerializedObject>(*serializedObject)->Data.Append(settings->data, settings->size);
+    }
+
+    return IPL_STATUS_SUCCESS;
+}
+
+IPLSerializedObject IPLCALL iplSerializedObjectRetain(IPLSerializedObject serializedObject) { return RetainObject(serializedObject); }
+void IPLCALL iplSerializedObjectRelease(IPLSerializedObject* serializedObject) { ReleaseObject(serializedObject); }
+IPLsize IPLCALL iplSerializedObjectGetSize(IPLSerializedObject serializedObject) { return GetStubObject<FStubSerializedObject>(serializedObject)->Data.Num(); }
+IPLbyte* IPLCALL iplSerializedObjectGetData(IPLSerializedObject serializedObject) { return GetStubObject<FStubSerializedObject>(serializedObject)->Data.GetData(); }
+
+IPLerror IPLCALL iplEmbreeDeviceCreate(IPLContext context, IPLEmbreeDeviceSettings* settings, IPLEmbreeDevice* device) { return CreateObject<FStubObject>(device); }
+IPLEmbreeDevice IPLCALL iplEmbreeDeviceRetain(IPLEmbreeDevice device) { return RetainObject(device); }
+void IPLCALL iplEmbreeDeviceRelease(IPLEmbreeDevice* device) { ReleaseObject(device); }
+
+// The stub has no GPU devices, so the plugin falls back to the CPU.
+IPLerror IPLCALL iplOpenCLDeviceListCreate(IPLContext context, IPLOpenCLDeviceSettings* settings, IPLOpenCLDeviceList* deviceList) { return CreateObject<FStubObject>(deviceList); }
+IPLOpenCLDeviceList IPLCALL iplOpenCLDeviceListRetain(IPLOpenCLDeviceList deviceList) { return RetainObject(deviceList); }
+void IPLCALL iplOpenCLDeviceListRelease(IPLOpenCLDeviceList* deviceList) { ReleaseObject(deviceList); }
+IPLint32 IPLCALL iplOpenCLDeviceListGetNumDevices(IPLOpenCLDeviceList deviceList) { return 0; }
+void IPLCALL iplOpenCLDeviceListGetDeviceDesc(IPLOpenCLDeviceList deviceList, IPLint32 index, IPLOpenCLDeviceDesc* deviceDesc) { *deviceDesc = IPLOpenCLDeviceDesc{}; }
+IPLerror IPLCALL iplOpenCLDeviceCreate(IPLContext context, IPLOpenCLDeviceList deviceList, IPLint32 index, IPLOpenCLDevice* device) { return IPL_STATUS_INITIALIZATION; }
+IPLerror IPLCALL iplOpenCLDeviceCreateFromExisting(IPLContext context, void* convolutionQueue, void* irUpdateQueue, IPLOpenCLDevice* device) { return IPL_STATUS_INITIALIZATION; }
+IPLOpenCLDevice IPLCALL iplOpenCLDeviceRetain(IPLOpenCLDevice device) { return RetainObject(device); }
+void IPLCALL iplOpenCLDeviceRelease(IPLOpenCLDevice* device) { ReleaseObject(device); }
+
+IPLerror IPLCALL iplRadeonRaysDeviceCreate(IPLOpenCLDevice openCLDevice, IPLRadeonRaysDeviceSettings* settings, IPLRadeonRaysDevice* rrDevice) { return IPL_STATUS_INITIALIZATION; }
+IPLRadeonRaysDevice IPLCALL iplRadeonRaysDeviceRetain(IPLRadeonRaysDevice device) { return RetainObject(device); }
+void IPLCALL iplRadeonRaysDeviceRelease(IPLRadeonRaysDevice* device) { ReleaseObject(device); }
+
+IPLerror IPLCALL iplTrueAudioNextDeviceCreate(IPLOpenCLDevice openCLDevice, IPLTrueAudioNextDeviceSettings* settings, IPLTrueAudioNextDevice* tanDevice) { return IPL_STATUS_INITIALIZATION; }
+IPLTrueAudioNextDevice IPLCALL iplTrueAudioNextDeviceRetain(IPLTrueAudioNextDevice device) { return RetainObject(device); }
+void IPLCALL iplTrueAudioNextDeviceRelease(IPLTrueAudioNextDevice* device) { ReleaseObject(device); }
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Geometry
+// ---------------------------------------------------------------------------------------------------------------------
+
+IPLerror IPLCALL iplSceneCreate(IPLContext context, IPLSceneSettings* settings, IPLScene* scene) { return CreateObject<FStubObject>(scene); }
+IPLScene IPLCALL iplSceneRetain(IPLScene scene) { return RetainObject(scene); }
+void IPLCALL iplSceneRelease(IPLScene* scene) { ReleaseObject(scene); }
+IPLerror IPLCALL iplSceneLoad(IPLContext context, IPLSceneSettings* settings, IPLSerializedObject serializedObject, IPLProgressCallback progressCallback, void* progressCallbackUserData, IPLScene* scene) { return CreateObject<FStubObject>(scene); }
+void IPLCALL iplSceneSave(IPLScene scene, IPLSerializedObject serializedObject) {}
+void IPLCALL iplSceneSaveOBJ(IPLScene scene, IPLstring fileBaseName) {}
+void IPLCALL iplSceneCommit(IPLScene scene) {}
+
+IPLerror IPLCALL iplStaticMeshCreate(IPLScene scene, IPLStaticMeshSettings* settings, IPLStaticMesh* staticMesh) { return CreateObject<FStubObject>(staticMesh); }
+IPLStaticMesh IPLCALL iplStaticMeshRetain(IPLStaticMesh staticMesh) { return RetainObject(staticMesh); }
+void IPLCALL iplStaticMeshRelease(IPLStaticMesh* staticMesh) { ReleaseObject(staticMesh); }
+IPLerror IPLCALL iplStaticMeshLoad(IPLScene scene, IPLSerializedObject serializedObject, IPLProgressCallback progressCallback, void* progressCallbackUserData, IPLStaticMesh* staticMesh) { return CreateObject<FStubObject>(staticMesh); }
+void IPLCALL iplStaticMeshSave(IPLStaticMesh staticMesh, IPLSerializedObject serializedObject) {}
+void IPLCALL iplStaticMeshAdd(IPLStaticMesh staticMesh, IPLScene scene) {}
+void IPLCALL iplStaticMeshRemove(IPLStaticMesh staticMesh, IPLScene scene) {}
+
+IPLerror IPLCALL iplInstancedMeshCreate(IPLScene scene, IPLInstancedMeshSettings* settings, IPLInstancedMesh* instancedMesh) { return CreateObject<FStubObject>(instancedMesh); }
+IPLInstancedMesh IPLCALL iplInstancedMeshRetain(IPLInstancedMesh instancedMesh) { return RetainObject(instancedMesh); }
+void IPLCALL iplInstancedMeshRelease(IPLInstancedMesh* instancedMesh) { ReleaseObject(instancedMesh); }
+void IPLCALL iplInstancedMeshAdd(IPLInstancedMesh instancedMesh, IPLScene scene) {}
+void IPLCALL iplInstancedMeshRemove(IPLInstancedMesh instancedMesh, IPLScene scene) {}
+void IPLCALL iplInstancedMeshUpdateTransform(IPLInstancedMesh instancedMesh, IPLScene scene, IPLMatrix4x4 transform) {}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Audio Buffers and Effects
+// ---------------------------------------------------------------------------------------------------------------------
+
+IPLerror IPLCALL iplAudioBufferAllocate(IPLContext context, IPLint32 numChannels, IPLint32 numSamples, IPLAudioBuffer* audioBuffer)
+{
+    audioBuffer->numChannels = numChannels;
+    audioBuffer->numSamples = numSamples;
+    audioBuffer->data = new IPLfloat32*[numChannels];
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        audioBuffer->data[i] = new IPLfloat32[numSamples]();
+    }
+
+    return IPL_STATUS_SUCCESS;
+}
+
+void IPLCALL iplAudioBufferFree(IPLContext context, IPLAudioBuffer* audioBuffer)
+{
+    if (!audioBuffer->data)
+        return;
+
+    for (int i = 0; i < audioBuffer->numChannels; ++i)
+    {
+        delete[] audioBuffer->data[i];
+    }
+
+    delete[] audioBuffer->data;
+    audioBuffer->data = nullptr;
+}
+
+void IPLCALL iplAudioBufferInterleave(IPLContext context, IPLAudioBuffer* src, IPLfloat32* dst)
+{
+    for (int i = 0; i < src->numSamples; ++i)
+    {
+        for (int j = 0; j < src->numChannels; ++j)
+        {
+            dst[i * src->numChannels + j] = src->data[j][i];
+        }
+    }
+}
+
+void IPLCALL iplAudioBufferDeinterleave(IPLContext context, IPLfloat32* src, IPLAudioBuffer* dst)
+{
+    for (int i = 0; i < dst->numSamples; ++i)
+    {
+        for (int j = 0; j < dst->numChannels; ++j)
+        {
+            dst->data[j][i] = src[i * dst->numChannels + j];
+        }
+    }
+}
+
+void IPLCALL iplAudioBufferMix(IPLContext context, IPLAudioBuffer* in, IPLAudioBuffer* mix)
+{
+    int NumChannels = FMath::Min(in->numChannels, mix->numChannels);
+    int NumSamples = FMath::Min(in->numSamples, mix->numSamples);
+
+    for (int j = 0; j < NumChannels; ++j)
+    {
+        for (int i = 0; i < NumSamples; ++i)
+        {
+            mix->data[j][i] += in->data[j][i];
+        }
+    }
+}
+
+void IPLCALL iplAudioBufferDownmix(IPLContext context, IPLAudioBuffer* in, IPLAudioBuffer* out)
+{
+    int NumSamples = FMath::Min(in->numSamples, out->numSamples);
+
+    for (int i = 0; i < NumSamples; ++i)
+    {
+        IPLfloat32 Sum = 0.0f;
+        for (int j = 0; j < in->numChannels; ++j)
+        {
+            Sum += in->data[j][i];
+        }
+
+        out->data[0][i] = (in->numChannels > 0) ? Sum / in->numChannels : 0.0f;
+    }
+}
+
+void IPLCALL iplAudioBufferConvertAmbisonics(IPLContext context, IPLAmbisonicsType inType, IPLAmbisonicsType outType, IPLAudioBuffer* in, IPLAudioBuffer* out)
+{
+    int NumChannels = FMath::Min(in->numChannels, out->numChannels);
+    int NumSamples = FMath::Min(in->numSamples, out->numSamples);
+
+    for (int j = 0; j < NumChannels; ++j)
+    {
+        FMemory::Memcpy(out->data[j], in->data[j], NumSamples * sizeof(IPLfloat32));
+    }
+}
+
+IPLerror IPLCALL iplHRTFCreate(IPLContext context, IPLAudioSettings* audioSettings, IPLHRTFSettings* hrtfSettings, IPLHRTF* hrtf) { return CreateObject<FStubObject>(hrtf); }
+IPLHRTF IPLCALL iplHRTFRetain(IPLHRTF hrtf) { return RetainObject(hrtf); }
+void IPLCALL iplHRTFRelease(IPLHRTF* hrtf) { ReleaseObject(hrtf); }
+
+// Every effect outputs silence.
+#define STUB_AUDIO_EFFECT(Name) \
+    IPLerror IPLCALL ipl##Name##Create(IPLContext context, IPLAudioSettings* audioSettings, IPL##Name##Settings* effectSettings, IPL##Name* effect) { return CreateObject<FStubObject>(effect); } \
+    IPL##Name IPLCALL ipl##Name##Retain(IPL##Name effect) { return RetainObject(effect); } \
+    void IPLCALL ipl##Name##Release(IPL##Name* effect) { ReleaseObject(effect); } \
+    void IPLCALL ipl##Name##Reset(IPL##Name effect) {} \
+    IPLAudioEffectState IPLCALL ipl##Name##Apply(IPL##Name effect, IPL##Name##Params* params, IPLAudioBuffer* in, IPLAudioBuffer* out) \
+    { \
+        ClearAudioBuffer(out); \
+        return IPL_AUDIOEFFECTSTATE_TAILCOMPLETE; \
+    }
+
+STUB_AUDIO_EFFECT(PanningEffect)
+STUB_AUDIO_EFFECT(BinauralEffect)
+STUB_AUDIO_EFFECT(VirtualSurroundEffect)
+STUB_AUDIO_EFFECT(AmbisonicsEncodeEffect)
+STUB_AUDIO_EFFECT(AmbisonicsPanningEffect)
+STUB_AUDIO_EFFECT(AmbisonicsBinauralEffect)
+STUB_AUDIO_EFFECT(AmbisonicsRotationEffect)
+STUB_AUDIO_EFFECT(AmbisonicsDecodeEffect)
+STUB_AUDIO_EFFECT(DirectEffect)
+STUB_AUDIO_EFFECT(PathEffect)
+
+#undef STUB_AUDIO_EFFECT
+
+IPLerror IPLCALL iplReflectionEffectCreate(IPLContext context, IPLAudioSettings* audioSettings, IPLReflectionEffectSettings* effectSettings, IPLReflectionEffect* effect) { return CreateObject<FStubObject>(effect); }
+IPLReflectionEffect IPLCALL iplReflectionEffectRetain(IPLReflectionEffect effect) { return RetainObject(effect); }
+void IPLCALL iplReflectionEffectRelease(IPLReflectionEffect* effect) { ReleaseObject(effect); }
+void IPLCALL iplReflectionEffectReset(IPLReflectionEffect effect) {}
+
+IPLAudioEffectState IPLCALL iplReflectionEffectApply(IPLReflectionEffect effect, IPLReflectionEffectParams* params, IPLAudioBuffer* in, IPLAudioBuffer* out, IPLReflectionMixer mixer)
+{
+    // With a mixer, the output is left untouched, as with the real effect.
+    if (!mixer)
+    {
+        ClearAudioBuffer(out);
+    }
+
+    return IPL_AUDIOEFFECTSTATE_TAILCOMPLETE;
+}
+
+IPLerror IPLCALL iplReflectionMixerCreate(IPLContext context, IPLAudioSettings* audioSettings, IPLReflectionEffectSettings* effectSettings, IPLReflectionMixer* mixer) { return CreateObject<FStubObject>(mixer); }
+IPLReflectionMixer IPLCALL iplReflectionMixerRetain(IPLReflectionMixer mixer) { return RetainObject(mixer); }
+void IPLCALL iplReflectionMixerRelease(IPLReflectionMixer* mixer) { ReleaseObject(mixer); }
+void IPLCALL iplReflectionMixerReset(IPLReflectionMixer mixer) {}
+
+IPLAudioEffectState IPLCALL iplReflectionMixerApply(IPLReflectionMixer mixer, IPLReflectionEffectParams* params, IPLAudioBuffer* out)
+{
+    ClearAudioBuffer(out);
+    return IPL_AUDIOEFFECTSTATE_TAILCOMPLETE;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Probes and Baking
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Probe generation needs ray tracing, so the stub generates no probes.
+IPLerror IPLCALL iplProbeArrayCreate(IPLContext context, IPLProbeArray* probeArray) { return CreateObject<FStubProbeSet>(probeArray); }
+IPLProbeArray IPLCALL iplProbeArrayRetain(IPLProbeArray probeArray) { return RetainObject(probeArray); }
+void IPLCALL iplProbeArrayRelease(IPLProbeArray* probeArray) { ReleaseObject(probeArray); }
+void IPLCALL iplProbeArrayGenerateProbes(IPLProbeArray probeArray, IPLScene scene, IPLProbeGenerationParams* params) {}
+IPLint32 IPLCALL iplProbeArrayGetNumProbes(IPLProbeArray probeArray) { return GetStubObject<FStubProbeSet>(probeArray)->Probes.Num(); }
+IPLSphere IPLCALL iplProbeArrayGetProbe(IPLProbeArray probeArray, IPLint32 index) { return GetStubObject<FStubProbeSet>(probeArray)->Probes[index]; }
+
+IPLerror IPLCALL iplProbeBatchCreate(IPLContext context, IPLProbeBatch* probeBatch) { return CreateObject<FStubProbeSet>(probeBatch); }
+IPLProbeBatch IPLCALL iplProbeBatchRetain(IPLProbeBatch probeBatch) { return RetainObject(probeBatch); }
+void IPLCALL iplProbeBatchRelease(IPLProbeBatch* probeBatch) { ReleaseObject(probeBatch); }
+IPLerror IPLCALL iplProbeBatchLoad(IPLContext context, IPLSerializedObject serializedObject, IPLProbeBatch* probeBatch) { return CreateObject<FStubProbeSet>(probeBatch); }
+void IPLCALL iplProbeBatchSave(IPLProbeBatch probeBatch, IPLSerializedObject serializedObject) {}
+IPLint32 IPLCALL iplProbeBatchGetNumProbes(IPLProbeBatch probeBatch) { return GetStubObject<FStubProbeSet>(probeBatch)->Probes.Num(); }
+void IPLCALL iplProbeBatchAddProbe(IPLProbeBatch probeBatch, IPLSphere probe) { GetStubObject<FStubProbeSet>(probeBatch)->Probes.Add(probe); }
+void IPLCALL iplProbeBatchAddProbeArray(IPLProbeBatch probeBatch, IPLProbeArray probeArray) { GetStubObject<FStubProbeSet>(probeBatch)->Probes.Append(GetStubObject<FStubProbeSet>(probeArray)->Probes); }
+void IPLCALL iplProbeBatchRemoveProbe(IPLProbeBatch probeBatch, IPLint32 index) { GetStubObject<FStubProbeSet>(probeBatch)->Probes.RemoveAt(index); }
+void IPLCALL iplProbeBatchCommit(IPLProbeBatch probeBatch) {}
+void IPLCALL iplProbeBatchRemoveData(IPLProbeBatch probeBatch, IPLBakedDataIdentifier* identifier) {}
+IPLsize IPLCALL iplProbeBatchGetDataSize(IPLProbeBatch probeBatch, IPLBakedDataIdentifier* identifier) { return 0; }
+
+// Bakes finish immediately, without adding any data.
+void IPLCALL iplReflectionsBakerBake(IPLContext context, IPLReflectionsBakeParams* params, IPLProgressCallback progressCallback, void* userData)
+{
+    if (progressCallback)
+    {
+        progressCallback(1.0f, userData);
+    }
+}
+
+void IPLCALL iplReflectionsBakerCancelBake(IPLContext context) {}
+
+void IPLCALL iplPathBakerBake(IPLContext context, IPLPathBakeParams* params, IPLProgressCallback progressCallback, void* userData)
+{
+    if (progressCallback)
+    {
+        progressCallback(1.0f, userData);
+    }
+}
+
+void IPLCALL iplPathBakerCancelBake(IPLContext context) {}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Simulation
+// ---------------------------------------------------------------------------------------------------------------------
+
+IPLerror IPLCALL iplSimulatorCreate(IPLContext context, IPLSimulationSettings* settings, IPLSimulator* simulator) { return CreateObject<FStubSimulator>(simulator); }
+IPLSimulator IPLCALL iplSimulatorRetain(IPLSimulator simulator) { return RetainObject(simulator); }
+void IPLCALL iplSimulatorRelease(IPLSimulator* simulator) { ReleaseObject(simulator); }
+void IPLCALL iplSimulatorSetScene(IPLSimulator simulator, IPLScene scene) {}
+void IPLCALL iplSimulatorAddProbeBatch(IPLSimulator simulator, IPLProbeBatch probeBatch) {}
+void IPLCALL iplSimulatorRemoveProbeBatch(IPLSimulator simulator, IPLProbeBatch probeBatch) {}
+
+void IPLCALL iplSimulatorSetSharedInputs(IPLSimulator simulator, IPLSimulationFlags flags, IPLSimulationSharedInputs* sharedInputs)
+{
+    if (flags & (IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING))
+    {
+        GetStubObject<FStubSimulator>(simulator)->ReflectionSharedInputs = *sharedInputs;
+    }
+}
+
+void IPLCALL iplSimulatorCommit(IPLSimulator simulator)
+{
+    FStubSimulator* Simulator = GetStubObject<FStubSimulator>(simulator);
+    FScopeLock Lock(&Simulator->CriticalSection);
+
+    for (FStubSource* Source : Simulator->SourcesToAdd)
+    {
+        Simulator->Sources.Add(Source);
+    }
+
+    for (FStubSource* Source : Simulator->SourcesToRemove)
+    {
+        if (Simulator->Sources.Remove(Source) > 0 && --Source->RefCount == 0)
+        {
+            delete Source;
+        }
+    }
+
+    Simulator->SourcesToAdd.Empty();
+    Simulator->SourcesToRemove.Empty();
+}
+
+void IPLCALL iplSimulatorRunDirect(IPLSimulator simulator)
+{
+    FStubSimulator* Simulator = GetStubObject<FStubSimulator>(simulator);
+
+    int64 NumRays = 0;
+    {
+        FScopeLock Lock(&Simulator->CriticalSection);
+
+        for (const FStubSource* Source : Simulator->Sources)
+        {
+            const IPLSimulationInputs& Inputs = Source->DirectInputs;
+            if (Inputs.directFlags & IPL_DIRECTSIMULATIONFLAGS_OCCLUSION)
+            {
+                NumRays += (Inputs.occlusionType == IPL_OCCLUSIONTYPE_VOLUMETRIC) ? Inputs.numOcclusionSamples : 1;
+            }
+            if (Inputs.directFlags & IPL_DIRECTSIMULATIONFLAGS_TRANSMISSION)
+            {
+                NumRays += Inputs.numTransmissionRays;
+            }
+        }
+    }
+
+    GNumDirectRuns++;
+    GNumDirectRays += NumRays;
+    SpendTime(NumRays);
+}
+
+void IPLCALL iplSimulatorRunReflections(IPLSimulator simulator)
+{
+    FStubSimulator* Simulator = GetStubObject<FStubSimulator>(simulator);
+
+    int64 NumRays = 0;
+    {
+        FScopeLock Lock(&Simulator->CriticalSection);
+
+        const IPLSimulationSharedInputs& SharedInputs = Simulator->ReflectionSharedInputs;
+        for (const FStubSource* Source : Simulator->Sources)
+        {
+            const IPLSimulationInputs& Inputs = Source->ReflectionInputs;
+            if ((Inputs.flags & IPL_SIMULATIONFLAGS_REFLECTIONS) && !Inputs.baked)
+            {
+                NumRays += static_cast<int64>(SharedInputs.numRays) * SharedInputs.numBounces;
+            }
+        }
+    }
+
+    GNumReflectionsRuns++;
+    GNumReflectionRays += NumRays;
+    SpendTime(NumRays);
+}
+
+void IPLCALL iplSimulatorRunPathing(IPLSimulator simulator)
+{
+    FStubSimulator* Simulator = GetStubObject<FStubSimulator>(simulator);
+
+    int64 NumProbes = 0;
+    {
+        FScopeLock Lock(&Simulator->CriticalSection);
+
+        for (const FStubSource* Source : Simulator->Sources)
+        {
+            const IPLSimulationInputs& Inputs = Source->ReflectionInputs;
+            if ((Inputs.flags & IPL_SIMULATIONFLAGS_PATHING) && Inputs.pathingProbes)
+            {
+                NumProbes += GetStubObject<FStubProbeSet>(Inputs.pathingProbes)->Probes.Num();
+            }
+        }
+    }
+
+    // Searching a probe for paths is modeled as costing as much as tracing one ray.
+    GNumPathingRuns++;
+    GNumPathingProbes += NumProbes;
+    SpendTime(NumProbes);
+}
+
+IPLerror IPLCALL iplSourceCreate(IPLSimulator simulator, IPLSourceSettings* settings, IPLSource* source) { return CreateObject<FStubSource>(source); }
+IPLSource IPLCALL iplSourceRetain(IPLSource source) { return RetainObject(source); }
+void IPLCALL iplSourceRelease(IPLSource* source) { ReleaseObject(source); }
+
+void IPLCALL iplSourceAdd(IPLSource source, IPLSimulator simulator)
+{
+    FStubSimulator* Simulator = GetStubObject<FStubSimulator>(simulator);
+    FScopeLock Lock(&Simulator->CriticalSection);
+
+    Simulator->SourcesToAdd.Add(GetStubObject<FStubSource>(RetainObject(source)));
+}
+
+void IPLCALL iplSourceRemove(IPLSource source, IPLSimulator simulator)
+{
+    FStubSimulator* Simulator = GetStubObject<FStubSimulator>(simulator);
+    FScopeLock Lock(&Simulator->CriticalSection);
+
+    FStubSource* Source = GetStubObject<FStubSource>(source);
+    if (Simulator->SourcesToAdd.Remove(Source) > 0)
+    {
+        --Source->RefCount;
+    }
+    else
+    {
+        Simulator->SourcesToRemove.Add(Source);
+    }
+}
+
+void IPLCALL iplSourceSetInputs(IPLSource source, IPLSimulationFlags flags, IPLSimulationInputs* inputs)
+{
+    FStubSource* Source = GetStubObject<FStubSource>(source);
+
+    if (flags & IPL_SIMULATIONFLAGS_DIRECT)
+    {
+        Source->DirectInputs = *inputs;
+    }
+
+    if (flags & (IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING))
+    {
+        Source->ReflectionInputs = *inputs;
+    }
+}
+
+void IPLCALL iplSourceGetOutputs(IPLSource source, IPLSimulationFlags flags, IPLSimulationOutputs* outputs)
+{
+    // Sound reaches the listener unoccluded and unattenuated, with no reflections or paths.
+    if (flags & IPL_SIMULATIONFLAGS_DIRECT)
+    {
+        IPLDirectEffectParams& Direct = outputs->direct;
+        Direct.distanceAttenuation = 1.0f;
+        Direct.airAbsorption[0] = Direct.airAbsorption[1] = Direct.airAbsorption[2] = 1.0f;
+        Direct.directivity = 1.0f;
+        Direct.occlusion = 1.0f;
+        Direct.transmission[0] = Direct.transmission[1] = Direct.transmission[2] = 1.0f;
+    }
+}
+
+IPLfloat32 IPLCALL iplDistanceAttenuationCalculate(IPLContext context, IPLVector3 source, IPLVector3 listener, IPLDistanceAttenuationModel* model)
+{
+    float Distance = FVector(source.x - listener.x, source.y - listener.y, source.z - listener.z).Size();
+    return 1.0f / FMath::Max(Distance, 1.0f);
+}
+
+void IPLCALL iplAirAbsorptionCalculate(IPLContext context, IPLVector3 source, IPLVector3 listener, IPLAirAbsorptionModel* model, IPLfloat32* airAbsorption)
+{
+    airAbsorption[0] = airAbsorption[1] = airAbsorption[2] = 1.0f;
+}
+
+IPLfloat32 IPLCALL iplDirectivityCalculate(IPLContext context, IPLCoordinateSpace3 source, IPLVector3 listener, IPLDirectivity* model)
+{
+    return 1.0f;
+}
+
+#endif
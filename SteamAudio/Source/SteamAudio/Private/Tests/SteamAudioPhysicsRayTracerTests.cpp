@@ -0,0 +1,83 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "Misc/AutomationTest.h"
+#include <limits>
+#include "SteamAudioCommon.h"
+#include "SteamAudioPhysicsRayTracer.h"
+#include "SteamAudioSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using namespace SteamAudio;
+
+/**
+ * Checks how the physics ray tracer handles the ray interval it is given, using a proxy sphere in front of the ray
+ * origin so that no world is needed. Empty and inverted intervals must never report a hit.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSteamAudioPhysicsRayTracerRangeTest, "SteamAudio.PhysicsRayTracer.RayInterval",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSteamAudioPhysicsRayTracerRangeTest::RunTest(const FString& Parameters)
+{
+    FSteamAudioSettings Settings{};
+    FSteamAudioProxyOccluders ProxyOccluders;
+    FSteamAudioPhysicsRayTracer RayTracer(Settings, ProxyOccluders);
+
+    // A 1 m sphere centered 5 m in front of the ray origin.
+    const float UnitsPerMeter = ConvertSteamAudioDistanceToUnreal(1.0f);
+
+    FSteamAudioProxyOccluderShape Sphere;
+    Sphere.Type = EProxyOccluderShape::SPHERE;
+    Sphere.Transform = FTransform(FVector(5.0f * UnitsPerMeter, 0.0f, 0.0f));
+    Sphere.Extents = FVector(UnitsPerMeter);
+    Sphere.BoundingRadius = UnitsPerMeter;
+    Sphere.Material.absorption[0] = 0.5f;
+
+    FSteamAudioProxyOccluders::FShapeArray Shapes;
+    Shapes.Add(Sphere);
+
+    IPLRay Ray{};
+    Ray.origin = ConvertVector(FVector::ZeroVector);
+    Ray.direction = ConvertVector(FVector(1.0f, 0.0f, 0.0f), false);
+
+    IPLHit Hit{};
+
+    RayTracer.ClosestHit(Ray, 0.0f, 10.0f, Hit, Shapes);
+    TestTrue(TEXT("ClosestHit hits the sphere within the interval"), Hit.material != nullptr);
+    TestEqual(TEXT("ClosestHit returns the distance to the surface of the sphere"), Hit.distance, 4.0f, 1e-3f);
+    TestTrue(TEXT("AnyHit hits the sphere within the interval"), RayTracer.AnyHit(Ray, 0.0f, 10.0f, Shapes));
+
+    RayTracer.ClosestHit(Ray, 2.0f, 10.0f, Hit, Shapes);
+    TestEqual(TEXT("ClosestHit measures distance from the ray origin, not the start of the interval"), Hit.distance, 4.0f, 1e-3f);
+
+    RayTracer.ClosestHit(Ray, 0.0f, 3.0f, Hit, Shapes);
+    TestTrue(TEXT("ClosestHit ignores the sphere beyond the interval"), Hit.material == nullptr);
+    TestFalse(TEXT("AnyHit ignores the sphere beyond the interval"), RayTracer.AnyHit(Ray, 0.0f, 3.0f, Shapes));
+
+    RayTracer.ClosestHit(Ray, 5.0f, 5.0f, Hit, Shapes);
+    TestTrue(TEXT("ClosestHit reports no hit for an empty interval"), Hit.material == nullptr && Hit.distance == std::numeric_limits<float>::infinity());
+    TestFalse(TEXT("AnyHit reports no hit for an empty interval"), RayTracer.AnyHit(Ray, 5.0f, 5.0f, Shapes));
+
+    RayTracer.ClosestHit(Ray, 10.0f, 0.0f, Hit, Shapes);
+    TestTrue(TEXT("ClosestHit reports no hit for an inverted interval"), Hit.material == nullptr && Hit.distance == std::numeric_limits<float>::infinity());
+    TestFalse(TEXT("AnyHit reports no hit for an inverted interval"), RayTracer.AnyHit(Ray, 10.0f, 0.0f, Shapes));
+
+    return true;
+}
+
+#endif
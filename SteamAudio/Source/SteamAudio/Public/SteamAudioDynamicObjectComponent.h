@@ -20,6 +20,12 @@
 #include "Components/ActorComponent.h"
 #include "SteamAudioDynamicObjectComponent.generated.h"
 
+namespace SteamAudio {
+
+class FSteamAudioDoubleBufferedScene;
+
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // USteamAudioDynamicObjectComponent
 // ---------------------------------------------------------------------------------------------------------------------
@@ -39,17 +45,21 @@ public:
     UPROPERTY(VisibleAnywhere, Category = ExportSettings, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioSerializedObject"))
     FSoftObjectPath Asset;
 
-    USteamAudioDynamicObjectComponent();
+    /** If true, this dynamic object's transform is sent to Steam Audio every frame in which it moves at all,
+        regardless of how far it has moved. Use this for objects whose small, continuous movements are audible, such
+        as doors that swing open. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = DynamicObjectSettings)
+    bool bFastMoving;
 
-    /**
-     * Inherited from UActorComponent
-     */
-
-    /** Called once every frame. */
-    virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    USteamAudioDynamicObjectComponent();
 
     FSoftObjectPath GetAssetToLoad();
 
+    /** Sends the owner's current transform to Steam Audio if it has moved or rotated by more than the given
+        thresholds (in Unreal units and degrees) since the last update, or if this object is fast-moving. The new
+        transform is used once the scene has been committed in the background. Called by the Steam Audio Manager. */
+    void UpdateTransform(float TranslationThreshold, float RotationThreshold);
+
 protected:
     /**
      * Inherited from UActorComponent
@@ -62,9 +72,18 @@ protected:
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-    /** Retained reference to the main scene used by the Steam Audio Manager for simulation. */
-    IPLScene Scene;
+    /** Shared reference to the main scene used by the Steam Audio Manager for simulation. */
+    TSharedPtr<SteamAudio::FSteamAudioDoubleBufferedScene> Scene;
+
+    /** Handle to the instance in the main scene. */
+    int32 InstanceHandle;
+
+    /** Shared reference to the scene used for reflections, if the Steam Audio Manager uses a separate one. */
+    TSharedPtr<SteamAudio::FSteamAudioDoubleBufferedScene> ReflectionScene;
+
+    /** Handle to the instance in the reflection scene. */
+    int32 ReflectionInstanceHandle;
 
-    /** The Instanced Mesh object. */
-    IPLInstancedMesh InstancedMesh;
+    /** The transform last sent to Steam Audio. */
+    FTransform LastTransform;
 };
@@ -99,7 +99,7 @@ public:
 
 private:
     /** Handle to the Steam Audio dynamic library (phonon.dll or similar). */
-    void* Library;
+    void* Library = nullptr;
 
     /** Manager object that maintains global Steam Audio state. */
     TSharedPtr<FSteamAudioManager> Manager;
@@ -117,6 +117,9 @@ private:
 	TUniquePtr<FSteamAudioReverbPluginFactory> ReverbPluginFactory;
 
 	TSet<const UWorld*> WorldsHoldingManager;
+
+    /** Points the manager's physics ray tracer (if any) at one of the worlds holding the manager. */
+    void UpdatePhysicsWorld();
 };
 
 }
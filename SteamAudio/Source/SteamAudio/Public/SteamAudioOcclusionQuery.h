@@ -0,0 +1,159 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "SteamAudioSourceComponent.h"
+#include "SteamAudioOcclusionQuery.generated.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioOcclusionQuery
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * A request for the occlusion and transmission of sound traveling between two points, simulated against the same
+ * acoustic geometry that is used for Steam Audio sources.
+ */
+USTRUCT(BlueprintType)
+struct STEAMAUDIO_API FSteamAudioOcclusionQuery
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** The point at which the sound is emitted. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    FVector Start;
+
+    /** The point at which the sound is heard. Ignored if bEndAtListener is true. Queries that share the same end
+        point are simulated together, so put the point that many queries have in common here. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    FVector End;
+
+    /** If true, the end point is the position of the listener when the query was submitted. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    bool bEndAtListener;
+
+    /** Specifies how rays should be traced to model occlusion. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    EOcclusionType OcclusionType;
+
+    /** The apparent size of the sound at the start point. Only if using volumetric occlusion. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery, meta = (UIMin = "0.0", UIMax = "4.0"))
+    float OcclusionRadius;
+
+    /** The number of rays to trace to various points in a sphere around the start point. Only if using volumetric
+        occlusion. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery, meta = (UIMin = "1", UIMax = "128"))
+    int OcclusionSamples;
+
+    /** If true, transmission through occluding geometry is also simulated. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    bool bSimulateTransmission;
+
+    FSteamAudioOcclusionQuery()
+        : Start(FVector::ZeroVector)
+        , End(FVector::ZeroVector)
+        , bEndAtListener(false)
+        , OcclusionType(EOcclusionType::RAYCAST)
+        , OcclusionRadius(1.0f)
+        , OcclusionSamples(16)
+        , bSimulateTransmission(false)
+    {}
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioOcclusionQueryResult
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * The result of a single occlusion query.
+ */
+USTRUCT(BlueprintType)
+struct STEAMAUDIO_API FSteamAudioOcclusionQueryResult
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** Fraction of the sound that reaches the end point unoccluded, from 0 (fully occluded) to 1 (unoccluded). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    float Occlusion;
+
+    /** Fraction of the occluded low frequency (up to 800 Hz) sound transmitted through geometry. Only if simulating
+        transmission. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    float TransmissionLow;
+
+    /** Fraction of the occluded middle frequency (800 Hz to 8 kHz) sound transmitted through geometry. Only if
+        simulating transmission. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    float TransmissionMid;
+
+    /** Fraction of the occluded high frequency (8 kHz and above) sound transmitted through geometry. Only if
+        simulating transmission. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    float TransmissionHigh;
+
+    /** Length of the direct path between the start and end points, in Unreal units. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = OcclusionQuery)
+    float PathLength;
+
+    FSteamAudioOcclusionQueryResult()
+        : Occlusion(1.0f)
+        , TransmissionLow(1.0f)
+        , TransmissionMid(1.0f)
+        , TransmissionHigh(1.0f)
+        , PathLength(0.0f)
+    {}
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioOcclusionQueryAction
+// ---------------------------------------------------------------------------------------------------------------------
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSteamAudioOcclusionQueryCompleted, const TArray<FSteamAudioOcclusionQueryResult>&, Results);
+
+/**
+ * Runs a batch of occlusion queries in the background, for use from blueprints. Submitting many queries in a single
+ * batch (for example, one per AI agent) is much cheaper than submitting them separately.
+ */
+UCLASS()
+class STEAMAUDIO_API USteamAudioOcclusionQueryAction : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+
+public:
+    /** Called with one result per query, in the same order as the queries. If Steam Audio is not running, called
+        with no results. */
+    UPROPERTY(BlueprintAssignable)
+    FSteamAudioOcclusionQueryCompleted Completed;
+
+    /** Simulates occlusion and transmission between pairs of points, against Steam Audio's acoustic geometry. */
+    UFUNCTION(BlueprintCallable, Category = "Steam Audio", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
+    static USteamAudioOcclusionQueryAction* QueryOcclusion(UObject* WorldContextObject, const TArray<FSteamAudioOcclusionQuery>& Queries);
+
+    /**
+     * Inherited from UBlueprintAsyncActionBase
+     */
+
+    /** Called to start the action. */
+    virtual void Activate() override;
+
+private:
+    /** The queries to run. */
+    TArray<FSteamAudioOcclusionQuery> Queries;
+};
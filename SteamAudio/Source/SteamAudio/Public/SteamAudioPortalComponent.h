@@ -0,0 +1,110 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+#include "Components/SceneComponent.h"
+#include "SteamAudioPortalComponent.generated.h"
+
+namespace SteamAudio {
+
+struct FSteamAudioProxyOccluderShape;
+
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioPortalComponent
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Marks an opening between two spaces, such as a doorway or window, that can be closed by a door. The opening is a box
+ * centered on this component, and should cover the door when it is closed. Add this component to the door actor
+ * itself: that actor's geometry is not exported (actors attached to it, or that it is attached to, are), so the
+ * opening is always open in the scene, and the door's effect on occlusion and transmission along the direct
+ * path is applied analytically based on how open it is. Opening or closing a door never requires the scene to be
+ * committed. Doors don't affect reflections or baked pathing. When tracing against the physics scene, the door's
+ * collision should ignore the Steam Audio trace channel.
+ *
+ * The door must be closed when play begins. The opening stays where the door was then, relative to whatever the door
+ * actor is attached to (such as the door frame), so it doesn't move as the door swings or slides open. How open the
+ * door is follows how far it has rotated or moved away from its closed position.
+ */
+UCLASS(ClassGroup = (SteamAudio), HideCategories = (Activation, Collision, Cooking, Mobility), meta = (BlueprintSpawnableComponent))
+class STEAMAUDIO_API USteamAudioPortalComponent : public USceneComponent
+{
+    GENERATED_BODY()
+
+public:
+    /** Half the size of the opening along each axis, in the component's local space. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PortalSettings)
+    FVector Extents;
+
+    /** How open the door is, from 0 (closed) to 1 (open), for doors that are opened without moving. The door is
+        treated as at least this open however far it has moved. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PortalSettings, meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0"))
+    float OpenFactor;
+
+    /** How far the door rotates away from its closed position before it is fully open, in degrees. If 0, rotating the
+        door doesn't open it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PortalSettings, meta = (ClampMin = "0.0", ClampMax = "180.0", UIMin = "0.0", UIMax = "180.0"))
+    float OpenAngle;
+
+    /** How far the door moves away from its closed position before it is fully open, in Unreal units. If 0, moving
+        the door doesn't open it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = PortalSettings, meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float OpenDistance;
+
+    /** The acoustic material of the door. Only its transmission coefficients are used. If not specified, the default
+        mesh material from project settings is used. */
+    UPROPERTY(EditAnywhere, Category = MaterialSettings, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioMaterial"))
+    FSoftObjectPath Material;
+
+    USteamAudioPortalComponent();
+
+    /** Sets how open the door is, from 0 (closed) to 1 (open). */
+    UFUNCTION(BlueprintCallable, Category = "Steam Audio")
+    void SetOpenFactor(float InOpenFactor) { OpenFactor = FMath::Clamp(InOpenFactor, 0.0f, 1.0f); }
+
+    /** Returns the shape of the closed part of the opening, in world space. Returns false if the door is fully open.
+        Called by the Steam Audio Manager on the game thread. */
+    bool GetShape(SteamAudio::FSteamAudioProxyOccluderShape& OutShape) const;
+
+protected:
+    /**
+     * Inherited from UActorComponent
+     */
+
+    /** Called when the component has been initialized. */
+    virtual void BeginPlay() override;
+
+    /** Called when the component is going to be destroyed. */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    /** The material of the door. */
+    IPLMaterial DoorMaterial;
+
+    /** The component the opening is anchored to: the one the door actor is attached to, if any. */
+    TWeakObjectPtr<const USceneComponent> Anchor;
+
+    /** The transform of this component when the door was closed, relative to the anchor, or in world space if there
+        is no anchor. */
+    FTransform ClosedTransform;
+
+    /** Returns the transform of this component when the door was closed, in world space. */
+    FTransform GetClosedWorldTransform() const;
+};
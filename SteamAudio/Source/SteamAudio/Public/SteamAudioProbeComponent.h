@@ -38,4 +38,8 @@ public:
     TArray<FVector> ProbePositions;
 
     FCriticalSection ProbePositionsCriticalSection;
+
+    /** Incremented, while holding ProbePositionsCriticalSection, whenever ProbePositions is replaced. Lets the
+        visualizer rebuild its cached copy of the probes only when they change. */
+    uint32 ProbePositionsVersion = 0;
 };
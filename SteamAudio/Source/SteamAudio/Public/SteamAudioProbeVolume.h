@@ -17,62 +17,51 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "SteamAudioSerializedObject.h"
 #include "GameFramework/Volume.h"
 #include "SteamAudioProbeVolume.generated.h"
 
 class ASteamAudioStaticMeshActor;
 class USteamAudioProbeComponent;
+struct FSteamAudioSettings;
+
+namespace SteamAudio {
+
+class FSteamAudioProbeStreamer;
+
+}
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Enumerations
 // ---------------------------------------------------------------------------------------------------------------------
 
 /**
- * Equivalent to IPLProbeGenerationType.
+ * Equivalent to IPLProbeGenerationType, plus adaptive placement, which is implemented on top of uniform floor
+ * placement.
  */
 UENUM(BlueprintType)
 enum class EProbeGenerationType : uint8
 {
     CENTROID        UMETA(DisplayName = "Centroid"),
     UNIFORM_FLOOR   UMETA(DisplayName = "Uniform Floor"),
+    ADAPTIVE        UMETA(DisplayName = "Adaptive"),
 };
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// FSteamAudioBakedDataInfo
+// FSteamAudioProbeGenerationProgress
 // ---------------------------------------------------------------------------------------------------------------------
 
 /**
- * Information about a single layer of baked data in a probe batch.
+ * Used to track and cancel probe generation from other threads.
  */
-USTRUCT()
-struct FSteamAudioBakedDataInfo
+struct FSteamAudioProbeGenerationProgress
 {
-    GENERATED_USTRUCT_BODY()
-
-    /** Name of the actor associated with this layer (or "Reverb" if this layer is reverb). */
-    UPROPERTY()
-    FString Name;
+    /** Set to true to cancel probe generation. */
+    std::atomic<bool> bCancel{false};
 
-    /** See IPLBakedDataIdentifier. */
-    UPROPERTY()
-    int Type = static_cast<int>(IPL_BAKEDDATATYPE_REFLECTIONS);
-
-    /** See IPLBakedDataIdentifier. */
-    UPROPERTY()
-    int Variation = static_cast<int>(IPL_BAKEDDATAVARIATION_REVERB);
-
-    /** See IPLBakedDataIdentifier. */
-    UPROPERTY()
-    FVector EndpointCenter{0.0f, 0.0f, 0.0f};
-
-    /** See IPLBakedDataIdentifier. */
-    UPROPERTY()
-    float EndpointRadius = 0.0f;
-
-    /** Size (in bytes) of the baked data in this layer. */
-    UPROPERTY()
-    int Size = 0;
+    /** Called from worker threads each time probes have been generated for a probe volume. */
+    TFunction<void(int NumVolumesCompleted, int NumVolumes)> OnProgress;
 };
 
 
@@ -97,14 +86,26 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings)
     EProbeGenerationType GenerationType;
 
-    /** Horizontal spacing (in meters) between adjacent probes. Only when using uniform floor probe generation. */
+    /** Horizontal spacing (in meters) between adjacent probes. Only when using uniform floor or adaptive probe
+        generation. When using adaptive probe generation, this is the spacing used in open, flat areas. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings)
     float HorizontalSpacing;
 
-    /** Height above the floor (in meters) at which to place probes. Only when using uniform floor probe generation. */
+    /** Height above the floor (in meters) at which to place probes. Only when using uniform floor or adaptive probe
+        generation. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings)
     float HeightAboveFloor;
 
+    /** Horizontal spacing (in meters) between adjacent probes in areas where the floor is broken up by walls and
+        obstacles, or changes height. Only when using adaptive probe generation. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings, meta = (ClampMin = "0.1"))
+    float MinHorizontalSpacing;
+
+    /** Maximum number of probes to generate, or 0 for no limit. Areas are refined in decreasing order of complexity
+        until the limit is reached. Only when using adaptive probe generation. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProbeBatchSettings, meta = (ClampMin = "0"))
+    int32 MaxProbes;
+
     /** Number of probes generated. */
     UPROPERTY(VisibleAnywhere, Category = ProbeBatchSettings, meta = (DisplayName = "Probes"))
     int32 NumProbes;
@@ -134,9 +135,16 @@ public:
 
     IPLProbeBatch GetProbeBatch() { return ProbeBatch; }
 
-    /** Generates probes. */
+    /** Generates probes. Call on a worker thread. */
     bool GenerateProbes(ASteamAudioStaticMeshActor* StaticMeshActor, FString AssetName);
 
+    /** Generates probes for several probe volumes in parallel, loading the static geometry only once. Each volume's
+        probe batch is saved to the asset with the corresponding name. If cancelled, no volume is changed. Returns
+        true if probes were generated for all volumes. Call on a worker thread. */
+    static bool GenerateProbesForVolumes(ASteamAudioStaticMeshActor* StaticMeshActor,
+        const TArray<ASteamAudioProbeVolume*>& ProbeVolumes, const TArray<FString>& AssetNames,
+        FSteamAudioProbeGenerationProgress* Progress = nullptr);
+
     /** Sets the total size of baked data (for stats display). */
     void UpdateTotalSize(int Size);
 
@@ -147,17 +155,22 @@ public:
     void RemoveLayer(const FString& Name);
 
     /** Adds (if missing) or updates stats for the given layer. Called when the layer is baked. */
-    void AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size);
+    void AddOrUpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, uint32 GeometryHash = 0);
 
     /** Adds stats for the given layer. */
-    void AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size);
+    void AddLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, uint32 GeometryHash = 0);
 
     /** Updates stats for the given layer. */
-    void UpdateLayer(const FString& Name, int Size);
+    void UpdateLayer(const FString& Name, IPLBakedDataIdentifier& Identifier, int Size, uint32 GeometryHash = 0);
 
     /** Returns the index of the given layer in the stats array. */
     int FindLayer(const FString& Name);
 
+    /** Returns the identifiers of the layers that shouldn't be kept resident when this probe volume is loaded: layers
+        stripped on this platform, and, if enabled, reflections baked for static sources or listeners that aren't in
+        the world. Call on the game thread. */
+    TArray<IPLBakedDataIdentifier> GetLayersToUnload(const FSteamAudioSettings& Settings) const;
+
 protected:
     /**
      * Inherited from AActor
@@ -170,9 +183,12 @@ protected:
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-    /** Retained reference to the Steam Audio simulator. */
+    friend class SteamAudio::FSteamAudioProbeStreamer;
+
+    /** Retained reference to the Steam Audio simulator. Not used when probe streaming is enabled. */
     IPLSimulator Simulator;
 
-    /** The Probe Batch object. */
+    /** The Probe Batch object. When probe streaming is enabled, this is owned by the probe streamer, and is nullptr
+        while the probe volume isn't loaded. */
     IPLProbeBatch ProbeBatch;
 };
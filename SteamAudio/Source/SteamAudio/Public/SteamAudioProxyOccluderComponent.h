@@ -0,0 +1,121 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+#include "Components/ActorComponent.h"
+#include "SteamAudioProxyOccluderComponent.generated.h"
+
+class UPrimitiveComponent;
+
+namespace SteamAudio {
+
+struct FSteamAudioProxyOccluderShape;
+
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Enumerations
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Analytic shapes that can be used as a proxy occluder.
+ */
+UENUM(BlueprintType)
+enum class EProxyOccluderShape : uint8
+{
+    SPHERE      UMETA(DisplayName = "Sphere"),
+    CAPSULE     UMETA(DisplayName = "Capsule"),
+    BOX         UMETA(DisplayName = "Box"),
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioProxyOccluderComponent
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Makes an actor occlude sound using a single sphere, capsule, or box taken from the simple collision of one of its
+ * physics bodies, instead of exported triangle geometry. Proxy occluders are tested analytically against occlusion
+ * rays, so they need no geometry export and moving them doesn't require the scene to be committed. This makes them
+ * well suited to characters and vehicles. Proxy occluders only affect occlusion and transmission, not reflections or
+ * pathing.
+ */
+UCLASS(ClassGroup = (SteamAudio), HideCategories = (Activation, Collision, Cooking), meta = (BlueprintSpawnableComponent))
+class STEAMAUDIO_API USteamAudioProxyOccluderComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    /** The acoustic material of the proxy. Only its transmission coefficients are used. If not specified, the
+        default mesh material from project settings is used. */
+    UPROPERTY(EditAnywhere, Category = MaterialSettings, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioMaterial"))
+    FSoftObjectPath Material;
+
+    /** Name of the primitive component whose physics body provides the proxy shape. If not specified, the root
+        component is used if it has a sphere, capsule, or box in its simple collision, otherwise the first component
+        that does. */
+    UPROPERTY(EditAnywhere, Category = ProxySettings)
+    FName ComponentName;
+
+    /** Scale applied to the proxy shape, relative to the physics body. Values below 1 make the proxy hug the visible
+        geometry more tightly, for instance when a character's collision capsule is much wider than its body. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProxySettings, meta = (UIMin = "0.1", UIMax = "2.0"))
+    float ShapeScale;
+
+    USteamAudioProxyOccluderComponent();
+
+    /** Returns the proxy shape with its current world transform. Returns false if no suitable physics body was found.
+        Called by the Steam Audio Manager on the game thread. */
+    bool GetShape(SteamAudio::FSteamAudioProxyOccluderShape& OutShape) const;
+
+protected:
+    /**
+     * Inherited from UActorComponent
+     */
+
+    /** Called when the component has been initialized. */
+    virtual void BeginPlay() override;
+
+    /** Called when the component is going to be destroyed. */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    /** The primitive component whose physics body provides the proxy shape. */
+    TWeakObjectPtr<UPrimitiveComponent> ShapeComponent;
+
+    /** The type of the proxy shape. */
+    EProxyOccluderShape ShapeType;
+
+    /** Transform of the proxy shape relative to ShapeComponent. */
+    FTransform ShapeTransform;
+
+    /** Radius of a sphere or capsule, or half-extents of a box, before the component's scale is applied. */
+    FVector ShapeExtents;
+
+    /** Distance between the centers of the end caps of a capsule, before the component's scale is applied. */
+    float ShapeLength;
+
+    /** The material of the proxy. */
+    IPLMaterial ShapeMaterial;
+
+    /** Finds the physics body to use as the proxy shape. Returns false if none was found. */
+    bool FindShape();
+
+    /** Reads a sphere, capsule, or box from the simple collision of the given component. */
+    bool InitShapeFromComponent(UPrimitiveComponent* Component);
+};
@@ -17,14 +17,68 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "Serialization/BulkData.h"
+#if WITH_EDITOR && ((ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 0) || (ENGINE_MAJOR_VERSION > 5))
+#include "UObject/ObjectSaveContext.h"
+#endif
 #include "SteamAudioSerializedObject.generated.h"
 
+class ITargetPlatform;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioBakedDataInfo
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Information about a single layer of baked data in a probe batch.
+ */
+USTRUCT()
+struct FSteamAudioBakedDataInfo
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** Name of the actor associated with this layer (or "Reverb" if this layer is reverb). */
+    UPROPERTY()
+    FString Name;
+
+    /** See IPLBakedDataIdentifier. */
+    UPROPERTY()
+    int Type = static_cast<int>(IPL_BAKEDDATATYPE_REFLECTIONS);
+
+    /** See IPLBakedDataIdentifier. */
+    UPROPERTY()
+    int Variation = static_cast<int>(IPL_BAKEDDATAVARIATION_REVERB);
+
+    /** See IPLBakedDataIdentifier. */
+    UPROPERTY()
+    FVector EndpointCenter{0.0f, 0.0f, 0.0f};
+
+    /** See IPLBakedDataIdentifier. */
+    UPROPERTY()
+    float EndpointRadius = 0.0f;
+
+    /** Size (in bytes) of the baked data in this layer. */
+    UPROPERTY()
+    int Size = 0;
+
+    /** Hash of the exported geometry near the probe volume when this layer was baked, or 0 if unknown. See
+        ASteamAudioStaticMeshActor::GetGeometryHash. */
+    UPROPERTY()
+    uint32 GeometryHash = 0;
+
+    /** Returns the identifier of this layer in the probe batch. */
+    IPLBakedDataIdentifier GetIdentifier() const;
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // USteamAudioSerializedObject
 // ---------------------------------------------------------------------------------------------------------------------
 
 /**
- * An object containing data from an IPLSerializedObject that can be serialized to a .uasset file.
+ * An object containing data from an IPLSerializedObject that can be serialized to a .uasset file. The data is stored
+ * as bulk data, optionally compressed, so it is not kept resident in memory along with the object. Use
+ * FSteamAudioSerializedObjectReader to access it.
  */
 UCLASS()
 class STEAMAUDIO_API USteamAudioSerializedObject : public UObject
@@ -32,11 +86,105 @@ class STEAMAUDIO_API USteamAudioSerializedObject : public UObject
     GENERATED_BODY()
 
 public:
-    /** The data to serialize. */
+    /** The data stored by assets saved with older versions of the plugin. Moved into bulk data when the asset is
+        next saved. */
     UPROPERTY()
     TArray<uint8> Data;
 
+    /** If this asset contains a probe batch, the layers of baked data in it. Used to strip layers when cooking. */
+    UPROPERTY()
+    TArray<FSteamAudioBakedDataInfo> BakedLayers;
+
+    /**
+     * Inherited from UObject
+     */
+
+    virtual void Serialize(FArchive& Ar) override;
+
+#if WITH_EDITOR
+#if ((ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 0) || (ENGINE_MAJOR_VERSION > 5))
+    virtual void PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext) override;
+#else
+    virtual void PostSaveRoot(bool bCleanupIsRequired) override;
+#endif
+#endif
+
+    /** Returns the size, in bytes, of the serialized data. */
+    int64 GetDataSize() const;
+
     /** Serializes the binary data in the provided IPLSerializedObject to a .uasset. The asset is specified using an
-        Unreal asset path of the form /Path/To/PackageName.ObjectName. */
-    static USteamAudioSerializedObject* SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName);
+        Unreal asset path of the form /Path/To/PackageName.ObjectName. If the data is a probe batch, BakedLayers
+        should list the layers of baked data in it. */
+    static USteamAudioSerializedObject* SerializeObjectToPackage(IPLSerializedObject SerializedObject, const FString& AssetName,
+        const TArray<FSteamAudioBakedDataInfo>& BakedLayers = TArray<FSteamAudioBakedDataInfo>());
+
+private:
+    /** The serialized data. */
+    FByteBulkData BulkData;
+
+    /** Guards BulkData, which may be read from worker threads, and CookedBulkData. */
+    mutable FCriticalSection BulkDataCriticalSection;
+
+#if WITH_EDITOR
+    /** The data written when cooking for a platform on which some layers of baked data are stripped. The linker only
+        writes bulk data payloads once the whole package has been serialized, so this must stay alive (and BulkData
+        must stay unchanged) until the package has been saved. Emptied once it has been. */
+    FByteBulkData CookedBulkData;
+#endif
+
+    /** Moves legacy data into bulk data. */
+    void MoveDataToBulkData();
+
+    /** Copies the given data into bulk data, and sets the flags used when saving it. */
+    void SetBulkData(const uint8* Buffer, int64 Size);
+
+    /** Copies the given data into the given bulk data, and sets the flags used when saving it. */
+    void SetBulkData(FByteBulkData& Target, const uint8* Buffer, int64 Size);
+
+#if WITH_EDITOR
+    /** Checks that stripped data written while cooking is smaller than the full data, and releases it. */
+    void FinishCooking();
+
+    /** Removes the layers of baked data that are stripped on the given platform from a copy of the probe batch.
+        Returns false, and leaves OutData empty, if no layers need to be stripped. */
+    bool GetStrippedData(const ITargetPlatform* TargetPlatform, TArray<uint8>& OutData);
+#endif
+
+    friend class FSteamAudioSerializedObjectReader;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioSerializedObjectReader
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Wraps the data in a Steam Audio Serialized Object asset in an IPLSerializedObject, for as long as the reader is
+ * alive. The data is read from disk (and decompressed) into a temporary buffer, which is freed along with the reader.
+ * In cooked builds, any copy of the data already in memory is handed over to the reader instead, so the asset holds
+ * no data once the Steam Audio object has been created from it, but can still be read again later. Can be used from a
+ * worker thread, as long as the asset is kept alive by the caller.
+ */
+class STEAMAUDIO_API FSteamAudioSerializedObjectReader
+{
+public:
+    FSteamAudioSerializedObjectReader(const USteamAudioSerializedObject* InAsset, IPLContext Context);
+
+    ~FSteamAudioSerializedObjectReader();
+
+    /** Returns the serialized object, or nullptr if it could not be created. */
+    IPLSerializedObject GetSerializedObject() const { return SerializedObject; }
+
+private:
+    /** The asset being read. */
+    const USteamAudioSerializedObject* Asset;
+
+    /** Buffer allocated to hold the data, if it could not be accessed in place. */
+    void* Buffer;
+
+    /** True if the asset's bulk data is locked for reading. */
+    bool bBulkDataLocked;
+
+    /** The serialized object wrapping the data. */
+    IPLSerializedObject SerializedObject;
 };
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "SteamAudioModule.h"
+#include "Engine/EngineTypes.h"
 #include "SteamAudioSettings.generated.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -42,6 +43,7 @@ enum class ESceneType : uint8
     DEFAULT     UMETA(DisplayName = "Default"),
     EMBREE      UMETA(DisplayName = "Embree"),
     RADEONRAYS  UMETA(DisplayName = "Radeon Rays"),
+    PHYSICS     UMETA(DisplayName = "Unreal Physics"),
 };
 
 /**
@@ -77,11 +79,80 @@ enum class EHRTFNormType : uint8
     RMS     UMETA(DisplayName = "RMS"),
 };
 
+/**
+ * Compression applied to the payload of Steam Audio assets (exported geometry and baked data) when they are saved.
+ */
+UENUM(BlueprintType)
+enum class ESerializedDataCompression : uint8
+{
+    NONE    UMETA(DisplayName = "None"),
+    ZLIB    UMETA(DisplayName = "Zlib"),
+    OODLE   UMETA(DisplayName = "Oodle"),
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioPhysicalMaterialMapping
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Specifies the Steam Audio Material to use for surfaces with a given Physical Material, when ray tracing against
+ * Unreal's physics scene.
+ */
+USTRUCT()
+struct FSteamAudioPhysicalMaterialMapping
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** The Physical Material to map. */
+    UPROPERTY(EditAnywhere, Category = Mapping, meta = (AllowedClasses = "/Script/PhysicsCore.PhysicalMaterial"))
+    FSoftObjectPath PhysicalMaterial;
+
+    /** The Steam Audio Material to use for surfaces with this Physical Material. */
+    UPROPERTY(EditAnywhere, Category = Mapping, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioMaterial"))
+    FSoftObjectPath Material;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FSteamAudioBakedDataPlatformRule
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Specifies which layers of baked data to leave out on a given platform. Stripped layers are removed from probe
+ * batches when cooking for the platform, and are never loaded when running on it.
+ */
+USTRUCT()
+struct STEAMAUDIO_API FSteamAudioBakedDataPlatformRule
+{
+    GENERATED_USTRUCT_BODY()
+
+    /** If true, baked reverb is stripped. */
+    UPROPERTY(EditAnywhere, Category = Rule)
+    bool bStripReverb = false;
+
+    /** If true, reflections baked for static sources are stripped. */
+    UPROPERTY(EditAnywhere, Category = Rule)
+    bool bStripStaticSourceReflections = false;
+
+    /** If true, reflections baked for static listeners are stripped. */
+    UPROPERTY(EditAnywhere, Category = Rule)
+    bool bStripStaticListenerReflections = false;
+
+    /** If true, baked pathing is stripped. */
+    UPROPERTY(EditAnywhere, Category = Rule)
+    bool bStripPathing = false;
+
+    /** Returns true if layers of the given type and variation (see IPLBakedDataIdentifier) are stripped. */
+    bool ShouldStrip(IPLBakedDataType Type, IPLBakedDataVariation Variation) const;
+};
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // FSteamAudioSettings
 // ---------------------------------------------------------------------------------------------------------------------
 
+class UPhysicalMaterial;
 class USOFAFile;
 
 /**
@@ -96,7 +167,10 @@ struct FSteamAudioSettings
     IPLMaterial DefaultMeshMaterial;
     IPLMaterial DefaultLandscapeMaterial;
     IPLMaterial DefaultBSPMaterial;
+    bool bUseReflectionGeometry;
     IPLSceneType SceneType;
+    ECollisionChannel PhysicsTraceChannel;
+    TMap<const UPhysicalMaterial*, IPLMaterial> PhysicalMaterials;
     int MaxOcclusionSamples;
     int RealTimeRays;
     int RealTimeBounces;
@@ -113,6 +187,11 @@ struct FSteamAudioSettings
     int BakingAmbisonicOrder;
     int BakingCPUCoresPercentage;
     float BakingIrradianceMinDistance;
+    int BakingMaxParallelProbeVolumes;
+    float BakingCheckpointInterval;
+    float BakingGeometryInfluenceDistance;
+    float BakingSavedDuration;
+    int BakingReverbAmbisonicOrder;
     UObject* ReverbSubmix;
     int BakingVisibilitySamples;
     float BakingVisibilityRadius;
@@ -120,8 +199,19 @@ struct FSteamAudioSettings
     float BakingVisibilityRange;
     float BakingPathRange;
     int BakedPathingCPUCoresPercentage;
+    bool bEnableBakeCache;
+    FString BakeCacheDirectory;
     float SimulationUpdateInterval;
+    float DynamicObjectTranslationThreshold;
+    float DynamicObjectRotationThreshold;
+    bool bEnableProbeStreaming;
+    float ProbeStreamingDistance;
+    int ProbeStreamingMemoryBudget;
+    float ProbeStreamingChunkSize;
+    FSteamAudioBakedDataPlatformRule BakedDataPlatformRule;
+    bool bLoadOnlyReferencedBakedLayers;
     IPLReflectionEffectType ReflectionEffectType;
+    bool bParametricReverbFastPath;
     float HybridReverbTransitionTime;
     int HybridReverbOverlapPercent;
     IPLOpenCLDeviceType OpenCLDeviceType;
@@ -175,9 +265,41 @@ public:
     UPROPERTY(GlobalConfig, EditAnywhere, Category = SceneExportSettings, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioMaterial", DisplayName = "Default BSP Material"))
     FSoftObjectPath DefaultBSPMaterial;
 
+    /** If true, a separate, simplified copy of each level's static geometry is exported, and used for reflections
+        and pathing (including baking), while the full geometry is used for occlusion and transmission. Reflections
+        tolerate much coarser geometry than occlusion does, so this can greatly reduce the cost of tracing
+        reflection rays. Levels exported without reflection geometry use their full geometry for everything. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SceneExportSettings)
+    bool bUseReflectionGeometry;
+
+    /** The LOD of each static mesh to export as part of the reflection geometry. If a mesh has fewer LODs, its
+        lowest-detail LOD is used. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SceneExportSettings, meta = (UIMin = 0, UIMax = 7, EditCondition = "bUseReflectionGeometry", DisplayName = "Reflection Geometry LOD"))
+    int ReflectionGeometryLOD;
+
+    /** The number of Landscape quads (along each axis) to merge into a single quad when exporting reflection
+        geometry. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = SceneExportSettings, meta = (UIMin = 1, UIMax = 16, EditCondition = "bUseReflectionGeometry"))
+    int ReflectionLandscapeStride;
+
+    /** The ray tracer to use. Unreal Physics traces rays against the collision geometry that is already loaded by
+        the physics engine, so no geometry needs to be exported, but only at runtime: baking still uses the exported
+        geometry and the default ray tracer. */
     UPROPERTY(GlobalConfig, EditAnywhere, Category = RayTracerSettings)
     ESceneType SceneType;
 
+    /** The collision channel to trace rays on when using the Unreal Physics ray tracer. Using a dedicated channel
+        lets you control which objects block sound independently of gameplay collision. Defaults to the first project
+        trace channel, which should be added (e.g. as "SteamAudio", blocking by default) under Project Settings >
+        Collision. If the chosen channel is not a trace channel defined in the project, Visibility is used instead. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = RayTracerSettings, meta = (EditCondition = "SceneType == ESceneType::PHYSICS"))
+    TEnumAsByte<ECollisionChannel> PhysicsTraceChannel;
+
+    /** Steam Audio Materials to use for surfaces with specific Physical Materials when using the Unreal Physics ray
+        tracer. Surfaces with any other Physical Material use the Default Mesh Material. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = RayTracerSettings, meta = (EditCondition = "SceneType == ESceneType::PHYSICS"))
+    TArray<FSteamAudioPhysicalMaterialMapping> PhysicalMaterialMappings;
+
     /** The maximum possible value of Occlusion Samples that can be specified on any Steam Audio Source component. */
     UPROPERTY(GlobalConfig, EditAnywhere, Category = OcclusionSettings, meta = (UIMin = 1, UIMax = 128))
     int MaxOcclusionSamples;
@@ -227,6 +349,36 @@ public:
     UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionsSettings, meta = (UIMin = 0.1f, UIMax = 10.0f))
     float BakingIrradianceMinDistance;
 
+    /** Maximum number of probe volumes to bake at the same time. The threads allowed by the CPU cores percentage
+        settings are shared equally between them. If 0, this is chosen based on the number of threads available. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionsSettings, meta = (ClampMin = 0, UIMin = 0, UIMax = 16))
+    int BakingMaxParallelProbeVolumes;
+
+    /** Minimum time (in seconds) between checkpoints while baking a probe volume. At each checkpoint, the layers
+        baked so far are saved, so a bake that is cancelled or crashes resumes from the last checkpoint instead of
+        baking the whole probe volume again. If 0, probe volumes are only saved once all their layers are baked. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionsSettings, meta = (ClampMin = 0.0f, UIMin = 0.0f, UIMax = 3600.0f))
+    float BakingCheckpointInterval;
+
+    /** Distance (in meters) from a probe volume within which changes to exported geometry cause its baked data to be
+        considered out of date. Larger values catch more distant changes to long reflection paths, but rebake more
+        probe volumes after each change. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionsSettings, meta = (ClampMin = 0.0f, UIMin = 0.0f, UIMax = 100.0f))
+    float BakingGeometryInfluenceDistance;
+
+    /** Length (in seconds) of the impulse responses saved in baked data. The size of baked data is proportional to
+        this. Reflections are still simulated for the full Baking Duration, so when using hybrid reverb, the late
+        reverb is estimated from the full impulse response, and only the part before the Hybrid Reverb Transition Time
+        needs to be saved. If 0, the full Baking Duration is saved. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionsSettings, meta = (ClampMin = 0.0f, UIMin = 0.0f, UIMax = 10.0f))
+    float BakingSavedDuration;
+
+    /** Ambisonic order of baked reverb. Reverb is mostly diffuse, so it usually needs a lower order than reflections
+        baked for static sources or listeners. The size of baked data is proportional to (order + 1)^2. If -1, Baking
+        Ambisonic Order is used. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionsSettings, meta = (ClampMin = -1, UIMin = -1, UIMax = 3))
+    int BakingReverbAmbisonicOrder;
+
     UPROPERTY(GlobalConfig, EditAnywhere, Category = ReverbSettings, meta = (AllowedClasses = "/Script/Engine.SoundSubmix"))
     FSoftObjectPath ReverbSubmix;
 
@@ -248,12 +400,70 @@ public:
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = PathingSettings, meta = (UIMin = 0, UIMax = 100, DisplayName = "Baked Pathing CPU Cores Percentage"))
 	int BakedPathingCPUCoresPercentage;
 
+    /** If true, baked probe batches are saved to the bake cache, and probe volumes whose geometry, probes, bake
+        settings, and tasks match a cached bake are restored from the cache instead of being baked again. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = BakeCacheSettings)
+    bool bEnableBakeCache;
+
+    /** Directory in which to store the bake cache. This can be a shared network directory, so bakes done on one
+        machine can be reused on others. If empty, the project's Saved/SteamAudio/BakeCache directory is used. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = BakeCacheSettings)
+    FString BakeCacheDirectory;
+
     UPROPERTY(GlobalConfig, EditAnywhere, Category = SimulationUpdateSettings, meta = (UIMin = 0.1f, UIMax = 1.0f))
     float SimulationUpdateInterval;
 
+    /** Minimum distance (in Unreal units) that a dynamic object must move before its transform is sent to Steam
+        Audio. Dynamic objects marked as fast-moving are updated every frame. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = DynamicObjectSettings, meta = (UIMin = 0.0f, UIMax = 100.0f))
+    float DynamicObjectTranslationThreshold;
+
+    /** Minimum angle (in degrees) that a dynamic object must rotate before its transform is sent to Steam Audio.
+        Dynamic objects marked as fast-moving are updated every frame. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = DynamicObjectSettings, meta = (UIMin = 0.0f, UIMax = 45.0f))
+    float DynamicObjectRotationThreshold;
+
+    /** If true, probe volumes load their baked data only when a listener comes near them, and unload it when the
+        memory budget is exceeded. If false, all probe volumes stay loaded while their level is loaded. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ProbeStreamingSettings)
+    bool bEnableProbeStreaming;
+
+    /** Distance (in meters) from a listener within which probe volumes are loaded. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ProbeStreamingSettings, meta = (ClampMin = 0.0f, UIMin = 0.0f, UIMax = 500.0f))
+    float ProbeStreamingDistance;
+
+    /** Maximum size (in MB) of the baked data kept loaded at any time, or 0 for no limit. When exceeded, probe volumes
+        that are no longer near a listener are unloaded, least recently used first. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ProbeStreamingSettings, meta = (ClampMin = 0, UIMin = 0, UIMax = 2048, DisplayName = "Probe Streaming Memory Budget (MB)"))
+    int ProbeStreamingMemoryBudget;
+
+    /** Maximum horizontal size (in meters) of the probe volumes created when splitting a probe volume for
+        streaming. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ProbeStreamingSettings, meta = (ClampMin = 1.0f, UIMin = 10.0f, UIMax = 500.0f))
+    float ProbeStreamingChunkSize;
+
+    /** Layers of baked data to strip on each platform, keyed by platform name (e.g. Android or IOS). Platforms that
+        aren't listed keep all layers. Applies to probe batches baked or edited after the setting is changed. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = BakedDataPlatformSettings)
+    TMap<FString, FSteamAudioBakedDataPlatformRule> BakedDataPlatformRules;
+
+    /** If true, reflections baked for a static source or static listener are only loaded if the actor they were baked
+        for is in the world when the probe volume is loaded. Don't enable this if baked sources or listeners are
+        placed in sublevels that are streamed in after the probe volumes that refer to them. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = BakedDataPlatformSettings)
+    bool bLoadOnlyReferencedBakedLayers;
+
     UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionEffectSettings)
     EReflectionEffectType ReflectionEffectType;
 
+    /** If true, the reverb submix renders listener-centric reverb with a single mono parametric reverb, driven by the
+        reverb times and EQ interpolated from the nearest baked probes, and skips the reflection mixer and Ambisonic
+        decoding. Reflections for all sources are also rendered using parametric reverb while playing. Intended for
+        low-end platforms, where it can be enabled in the platform's Engine.ini. Requires probes baked with Bake
+        Parametric enabled. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = ReflectionEffectSettings)
+    bool bParametricReverbFastPath;
+
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = HybridReverbSettings, meta = (UIMin = 0.1f, UIMax = 2.0f))
 	float HybridReverbTransitionTime;
 
@@ -290,6 +500,13 @@ public:
     UPROPERTY(Config, EditAnywhere, Category = "Custom HRTF Settings", meta = (DisplayName = "SOFA File", AllowedClasses = "/Script/SteamAudio.SOFAFile"))
     FSoftObjectPath SOFAFile;
 
+    /** Compression to use for exported geometry and baked data. Uncompressed data loads fastest, since it is read
+        from disk as-is; compressed data is smaller on disk, but must be decompressed into memory on load.
+        Oodle is only available in Unreal Engine 5, and falls back to Zlib otherwise. Applies to assets saved after the
+        setting is changed. */
+    UPROPERTY(GlobalConfig, EditAnywhere, Category = "Asset Settings")
+    ESerializedDataCompression SerializedDataCompression;
+
     UPROPERTY(Config, EditAnywhere, Category = "Advanced Settings")
     bool EnableValidation;
 
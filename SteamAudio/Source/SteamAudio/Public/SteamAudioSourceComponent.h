@@ -186,6 +186,12 @@ private:
     /** Retained reference to the Steam Audio simulator. */
     IPLSimulator Simulator;
 
+    /** The Source object used for reflections and pathing, if the manager uses a separate reflection scene. */
+    IPLSource ReflectionSource;
+
+    /** Retained reference to the Steam Audio simulator used for reflections and pathing, if separate. */
+    IPLSimulator ReflectionSimulator;
+
     /** Interface for communicating with the spatializer effect instance. */
     TSharedPtr<SteamAudio::IAudioEngineSource> AudioEngineSource;
 	
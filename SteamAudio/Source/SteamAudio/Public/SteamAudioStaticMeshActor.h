@@ -37,10 +37,35 @@ public:
     UPROPERTY(EditAnywhere, Category = ExportSettings, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioSerializedObject"))
     FSoftObjectPath Asset;
 
+    /** Reference to the Steam Audio Serialized Object asset containing simplified static geometry data, used for
+        reflections and pathing. Only exported if Use Reflection Geometry is enabled in the project settings. */
+    UPROPERTY(EditAnywhere, Category = ExportSettings, meta = (AllowedClasses = "/Script/SteamAudio.SteamAudioSerializedObject"))
+    FSoftObjectPath ReflectionAsset;
+
+    /** Size (in Unreal units) of the grid cells over which the geometry used for reflections and pathing was hashed
+        when it was exported. */
+    UPROPERTY()
+    float GeometryCellSize;
+
+    /** Hash of the geometry used for reflections and pathing in each grid cell, as of the last export. Baked data
+        records a hash of the cells around its probe volume, so that it only needs to be rebaked when nearby geometry
+        changes. */
+    UPROPERTY()
+    TMap<FIntVector, uint32> GeometryCellHashes;
+
+    /** Number of triangles in the geometry used for reflections and pathing, as of the last export. Used to estimate
+        how long bakes will take. */
+    UPROPERTY(VisibleAnywhere, Category = ExportSettings, meta = (DisplayName = "Triangles"))
+    int32 NumTriangles;
+
     ASteamAudioStaticMeshActor();
 
     static ASteamAudioStaticMeshActor* FindInLevel(UWorld* World, ULevel* Level);
 
+    /** Returns a hash of the exported geometry in all grid cells that overlap the given bounds. Returns 0 if the
+        geometry was exported before grid cells were hashed. */
+    uint32 GetGeometryHash(const FBox& Bounds) const;
+
 protected:
     /**
      * Inherited from UActorComponent
@@ -51,11 +76,4 @@ protected:
 
     /** Called when the component is going to be destroyed. */
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-
-private:
-    /** Retained reference to the main scene used by the Steam Audio Manager for simulation. */
-    IPLScene Scene;
-
-    /** The Static Mesh object. */
-    IPLStaticMesh StaticMesh;
 };
@@ -0,0 +1,67 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioModule.h"
+
+#if STEAMAUDIO_STUB_PHONON
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Stub Steam Audio SDK
+// ---------------------------------------------------------------------------------------------------------------------
+
+/*
+ * When STEAMAUDIO_STUB_PHONON=1 is set in the environment when building (except for Shipping builds, where it is an
+ * error), the plugin is built against a stub implementation of the Steam Audio API instead of the SDK.
+ * The stub keeps track of the objects created through the API, but doesn't trace rays or process audio: simulation
+ * outputs are neutral, and effects output silence. Instead, it counts the rays that the real simulator would trace
+ * for the inputs it is given, and can optionally spin for a fixed time per ray, so the cost of simulation is
+ * deterministic. This lets the plugin's own overhead be benchmarked on machines without the SDK or audio hardware.
+ */
+
+/** Work done by the stub simulator since the last call to ResetStubPhononStats. */
+struct FStubPhononStats
+{
+    int32 NumDirectRuns = 0;
+    int32 NumReflectionsRuns = 0;
+    int32 NumPathingRuns = 0;
+
+    /** Number of occlusion and transmission rays that would have been traced. */
+    int64 NumDirectRays = 0;
+
+    /** Number of reflection rays (times bounces) that would have been traced for real-time reflections. */
+    int64 NumReflectionRays = 0;
+
+    /** Number of probes that would have been searched for paths. */
+    int64 NumPathingProbes = 0;
+};
+
+/** Sets how long the stub simulator spins for each modeled ray, in nanoseconds. 0 (the default) means simulation
+    takes no time. */
+void STEAMAUDIO_API SetStubPhononNanosecondsPerRay(double Nanoseconds);
+
+/** Returns the work done by the stub simulator since the last reset. */
+FStubPhononStats STEAMAUDIO_API GetStubPhononStats();
+
+/** Resets the work counted by the stub simulator. */
+void STEAMAUDIO_API ResetStubPhononStats();
+
+}
+
+#endif
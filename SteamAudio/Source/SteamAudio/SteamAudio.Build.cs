@@ -28,6 +28,7 @@ public class SteamAudio : ModuleRules
             "Engine",
             "Projects",
             "Landscape",
+            "PhysicsCore",
             "AudioMixer",
             "AudioExtensions"
         });
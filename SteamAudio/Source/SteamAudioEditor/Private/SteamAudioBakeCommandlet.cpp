@@ -0,0 +1,392 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioBakeCommandlet.h"
+#include "FileHelpers.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectIterator.h"
+#include "SteamAudioBakedListenerComponent.h"
+#include "SteamAudioBakedSourceComponent.h"
+#include "SteamAudioBaking.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioProbeVolume.h"
+#include "SteamAudioSettings.h"
+#include "SteamAudioStaticMeshActor.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helper Functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const TCHAR* GetBakeResultName(EBakeResult Result)
+{
+    switch (Result)
+    {
+    case EBakeResult::SUCCESS:
+        return TEXT("Success");
+    case EBakeResult::PARTIAL_SUCCESS:
+        return TEXT("PartialSuccess");
+    default:
+        return TEXT("Failure");
+    }
+}
+
+// Writes the timing and throughput of a bake to a JSON file.
+static bool WriteBakeReport(const FString& FileName, const FString& MapName, double ProbeGenerationTime, const FBakeReport& Report)
+{
+    int NumProbes = 0;
+    int64 NumRaysEstimated = 0;
+    for (const FBakeProbeVolumeReport& ProbeVolume : Report.ProbeVolumes)
+    {
+        NumProbes += ProbeVolume.NumProbes;
+        NumRaysEstimated += ProbeVolume.NumRaysEstimated;
+    }
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("map"), MapName);
+    Writer->WriteValue(TEXT("result"), FString(GetBakeResultName(Report.Result)));
+    Writer->WriteValue(TEXT("probeGenerationSeconds"), ProbeGenerationTime);
+    Writer->WriteValue(TEXT("bakeSeconds"), Report.TotalTime);
+    Writer->WriteValue(TEXT("parallelProbeVolumes"), Report.NumParallelProbeVolumes);
+    Writer->WriteValue(TEXT("reflectionsThreadsPerProbeVolume"), Report.NumReflectionsThreads);
+    Writer->WriteValue(TEXT("pathingThreadsPerProbeVolume"), Report.NumPathingThreads);
+    Writer->WriteValue(TEXT("probes"), NumProbes);
+    Writer->WriteValue(TEXT("estimatedRays"), NumRaysEstimated);
+    Writer->WriteValue(TEXT("estimatedRaysPerSecond"), (Report.TotalTime > 0.0) ? NumRaysEstimated / Report.TotalTime : 0.0);
+
+    Writer->WriteArrayStart(TEXT("probeVolumes"));
+    for (const FBakeProbeVolumeReport& ProbeVolume : Report.ProbeVolumes)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("name"), ProbeVolume.Name);
+        Writer->WriteValue(TEXT("probes"), ProbeVolume.NumProbes);
+        Writer->WriteValue(TEXT("tasks"), ProbeVolume.NumTasks);
+        Writer->WriteValue(TEXT("tasksSucceeded"), ProbeVolume.NumTasksSucceeded);
+        Writer->WriteValue(TEXT("resumed"), ProbeVolume.bResumed);
+        Writer->WriteValue(TEXT("cached"), ProbeVolume.bCached);
+        Writer->WriteValue(TEXT("reflectionsSeconds"), ProbeVolume.ReflectionsTime);
+        Writer->WriteValue(TEXT("pathingSeconds"), ProbeVolume.PathingTime);
+        Writer->WriteValue(TEXT("estimatedRays"), ProbeVolume.NumRaysEstimated);
+        Writer->WriteValue(TEXT("estimatedRaysPerSecond"), (ProbeVolume.ReflectionsTime > 0.0) ? ProbeVolume.NumRaysEstimated / ProbeVolume.ReflectionsTime : 0.0);
+
+        Writer->WriteArrayStart(TEXT("tasks"));
+        for (const FBakeTaskReport& Task : ProbeVolume.Tasks)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("layer"), Task.LayerName);
+            Writer->WriteValue(TEXT("restored"), Task.bRestored);
+            Writer->WriteValue(TEXT("seconds"), Task.Time);
+            Writer->WriteValue(TEXT("probesPerSecond"), Task.GetProbesPerSecond());
+            Writer->WriteValue(TEXT("estimatedRaysPerSecond"), Task.GetRaysPerSecond());
+            Writer->WriteValue(TEXT("threads"), Task.NumThreads);
+            Writer->WriteValue(TEXT("cpuUtilizationPercent"), Task.CPUUtilization);
+            Writer->WriteValue(TEXT("peakMemoryBytes"), static_cast<int64>(Task.PeakUsedPhysical));
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return FFileHelper::SaveStringToFile(Json, *FileName);
+}
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBakeCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioBakeCommandlet::USteamAudioBakeCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 USteamAudioBakeCommandlet::Main(const FString& Params)
+{
+    using namespace SteamAudio;
+
+    FString MapName;
+    if (!FParse::Value(*Params, TEXT("Map="), MapName) || !FPackageName::DoesPackageExist(MapName))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Specify an existing map to bake with -Map=/Game/Path/To/Map."));
+        return 1;
+    }
+
+    // Parse the layers to bake.
+    bool bBakeStaticSources = true;
+    bool bBakeStaticListeners = true;
+    bool bBakeReverb = true;
+    bool bBakePathing = true;
+
+    FString LayersString;
+    if (FParse::Value(*Params, TEXT("Layers="), LayersString, false))
+    {
+        bBakeStaticSources = bBakeStaticListeners = bBakeReverb = bBakePathing = false;
+
+        TArray<FString> LayerNames;
+        LayersString.ParseIntoArray(LayerNames, TEXT(","));
+
+        for (const FString& LayerName : LayerNames)
+        {
+            if (LayerName == TEXT("StaticSource"))
+                bBakeStaticSources = true;
+            else if (LayerName == TEXT("StaticListener"))
+                bBakeStaticListeners = true;
+            else if (LayerName == TEXT("Reverb"))
+                bBakeReverb = true;
+            else if (LayerName == TEXT("Pathing"))
+                bBakePathing = true;
+            else
+            {
+                UE_LOG(LogSteamAudioEditor, Error, TEXT("Unknown layer: %s. Expected StaticSource, StaticListener, Reverb, or Pathing."), *LayerName);
+                return 1;
+            }
+        }
+    }
+
+    // Parse the shard to bake, if any.
+    FBakeOptions Options;
+
+    FString ShardString;
+    if (FParse::Value(*Params, TEXT("Shard="), ShardString))
+    {
+        FString ShardIndexString;
+        FString NumShardsString;
+        if (!ShardString.Split(TEXT("/"), &ShardIndexString, &NumShardsString))
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Invalid shard: %s. Expected -Shard=<index>/<count>."), *ShardString);
+            return 1;
+        }
+
+        Options.ShardIndex = FCString::Atoi(*ShardIndexString);
+        Options.NumShards = FCString::Atoi(*NumShardsString);
+
+        if (Options.NumShards < 1 || Options.ShardIndex < 0 || Options.ShardIndex >= Options.NumShards)
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Invalid shard: %s. Expected -Shard=<index>/<count>."), *ShardString);
+            return 1;
+        }
+    }
+
+    bool bGenerateProbes = FParse::Param(*Params, TEXT("GenerateProbes"));
+    if (bGenerateProbes && Options.NumShards > 1)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("-GenerateProbes can't be combined with -Shard. Generate probes in a separate run first."));
+        return 1;
+    }
+
+    // Override the ray tracer, if requested. Radeon Rays needs a GPU, and the Unreal physics scene can't be used for
+    // baking, so only the CPU ray tracers can be chosen here.
+    FString SceneTypeName;
+    if (FParse::Value(*Params, TEXT("SceneType="), SceneTypeName))
+    {
+        if (SceneTypeName == TEXT("Default"))
+        {
+            GetMutableDefault<USteamAudioSettings>()->SceneType = ESceneType::DEFAULT;
+        }
+        else if (SceneTypeName == TEXT("Embree"))
+        {
+            GetMutableDefault<USteamAudioSettings>()->SceneType = ESceneType::EMBREE;
+        }
+        else
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unknown scene type: %s. Expected Default or Embree."), *SceneTypeName);
+            return 1;
+        }
+    }
+
+    FString ReportFileName = FPaths::ProjectSavedDir() / TEXT("SteamAudio") / TEXT("Bakes") / MapName.Replace(TEXT("/"), TEXT("_"));
+    if (Options.NumShards > 1)
+    {
+        ReportFileName += FString::Printf(TEXT(".%dof%d"), Options.ShardIndex, Options.NumShards);
+    }
+    ReportFileName += TEXT(".json");
+    FParse::Value(*Params, TEXT("Report="), ReportFileName);
+
+    // Load the map.
+    UWorld* World = UEditorLoadingAndSavingUtils::LoadMap(MapName);
+    if (!World)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load map: %s"), *MapName);
+        return 1;
+    }
+
+    ULevel* Level = World->PersistentLevel;
+
+    TArray<AActor*> ProbeVolumes;
+    UGameplayStatics::GetAllActorsOfClass(World, ASteamAudioProbeVolume::StaticClass(), ProbeVolumes);
+
+    // Regenerate probes, if requested. Probe generation loads and saves assets on the game thread, so it runs on a
+    // worker thread while the game thread is ticked.
+    double ProbeGenerationTime = 0.0;
+    if (bGenerateProbes)
+    {
+        ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+        if (!StaticMeshActor || !StaticMeshActor->Asset.IsAsset())
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to generate probes: no static geometry exported for map %s."), *MapName);
+            return 1;
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+
+        TArray<ASteamAudioProbeVolume*> ProbeVolumesToGenerate;
+        TArray<FString> AssetNames;
+        for (AActor* Actor : ProbeVolumes)
+        {
+            ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
+
+            FString AssetName = ProbeVolume->Asset.GetAssetPathString();
+            if (!ProbeVolume->Asset.IsAsset())
+            {
+                FString ObjectName = FPackageName::GetShortName(World->GetOutermost()) + TEXT("_") + ProbeVolume->GetName();
+                AssetName = FPackageName::GetLongPackagePath(World->GetOutermost()->GetName()) / ObjectName + TEXT(".") + ObjectName;
+            }
+
+            ProbeVolumesToGenerate.Add(ProbeVolume);
+            AssetNames.Add(AssetName);
+        }
+
+        TFuture<bool> Future = Async(EAsyncExecution::Thread, [ProbeVolumesToGenerate, AssetNames, StaticMeshActor]()
+        {
+            return ASteamAudioProbeVolume::GenerateProbesForVolumes(StaticMeshActor, ProbeVolumesToGenerate, AssetNames);
+        });
+
+        SteamAudio::WaitInGameThread(Future);
+
+        if (!Future.Get())
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to generate probes for map %s."), *MapName);
+            return 1;
+        }
+
+        for (ASteamAudioProbeVolume* ProbeVolume : ProbeVolumesToGenerate)
+        {
+            UE_LOG(LogSteamAudioEditor, Display, TEXT("Generated %d probes for probe volume %s."), ProbeVolume->NumProbes, *ProbeVolume->GetName());
+        }
+
+        ProbeGenerationTime = FPlatformTime::Seconds() - StartTime;
+    }
+
+    // Gather the bake tasks.
+    TArray<FBakeTask> Tasks;
+
+    if (bBakeReverb)
+    {
+        FBakeTask Task{};
+        Task.Type = EBakeTaskType::REVERB;
+        Tasks.Add(Task);
+    }
+
+    if (bBakeStaticSources)
+    {
+        for (TObjectIterator<USteamAudioBakedSourceComponent> It; It; ++It)
+        {
+            if (It->GetWorld() != World)
+                continue;
+
+            FBakeTask Task{};
+            Task.Type = EBakeTaskType::STATIC_SOURCE_REFLECTIONS;
+            Task.BakedSource = *It;
+            Tasks.Add(Task);
+        }
+    }
+
+    if (bBakeStaticListeners)
+    {
+        for (TObjectIterator<USteamAudioBakedListenerComponent> It; It; ++It)
+        {
+            if (It->GetWorld() != World)
+                continue;
+
+            FBakeTask Task{};
+            Task.Type = EBakeTaskType::STATIC_LISTENER_REFLECTIONS;
+            Task.BakedListener = *It;
+            Tasks.Add(Task);
+        }
+    }
+
+    if (bBakePathing)
+    {
+        for (AActor* Actor : ProbeVolumes)
+        {
+            FBakeTask Task{};
+            Task.Type = EBakeTaskType::PATHING;
+            Task.PathingProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
+            Tasks.Add(Task);
+        }
+    }
+
+    if (Tasks.Num() == 0)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Nothing to bake in map %s."), *MapName);
+        return 1;
+    }
+
+    if (FParse::Param(*Params, TEXT("OnlyChanged")))
+    {
+        Tasks = GetOutOfDateBakeTasks(World, Level, Tasks);
+        if (Tasks.Num() == 0)
+        {
+            UE_LOG(LogSteamAudioEditor, Display, TEXT("Baked data for map %s is up to date."), *MapName);
+            return 0;
+        }
+    }
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Baking %d layer(s) in %d probe volume(s) for map %s."), Tasks.Num(), ProbeVolumes.Num(), *MapName);
+
+    FBakeReport Report;
+    EBakeResult Result = BakeAndWait(World, Level, Tasks, Options, Report);
+
+    // Probe batch assets are saved as each probe volume finishes baking. Save the map too, so the probe volumes
+    // record the new probe batches and layers. Shards leave this to the run that collects their results.
+    if (Options.NumShards <= 1 && (Result != EBakeResult::FAILURE || bGenerateProbes))
+    {
+        if (!UEditorLoadingAndSavingUtils::SavePackages({ World->GetOutermost() }, true))
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to save map: %s"), *MapName);
+            Result = EBakeResult::FAILURE;
+            Report.Result = Result;
+        }
+    }
+
+    if (!WriteBakeReport(ReportFileName, MapName, ProbeGenerationTime, Report))
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to write bake report: %s"), *ReportFileName);
+    }
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Bake finished with result %s in %.1f s. Report written to %s."), GetBakeResultName(Result),
+        Report.TotalTime, *ReportFileName);
+
+    return (Result == EBakeResult::SUCCESS) ? 0 : 1;
+}
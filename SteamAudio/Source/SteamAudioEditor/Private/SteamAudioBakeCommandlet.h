@@ -0,0 +1,61 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioEditorModule.h"
+#include "Commandlets/Commandlet.h"
+#include "SteamAudioBakeCommandlet.generated.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBakeCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Bakes reflections, reverb, and pathing for a map without the editor UI, for use on build machines. Probe batch
+// assets and the map are saved when the bake finishes. Doesn't need rendering, so it can be run with -nullrhi.
+//
+// Usage:
+//     UnrealEditor-Cmd <Project>.uproject -run=SteamAudioBake -Map=/Game/Maps/MyMap [options] -nullrhi -unattended
+//
+// Options:
+//     -Layers=<list>       Comma-separated layers to bake: StaticSource, StaticListener, Reverb, Pathing. Defaults to
+//                          all of them.
+//     -GenerateProbes      Generates probes in all probe volumes before baking.
+//     -OnlyChanged         Only bakes layers in probe volumes where they haven't been baked, or where nearby geometry
+//                          has changed since they were baked.
+//     -SceneType=<type>    Overrides the ray tracer to bake with: Default or Embree.
+//     -Shard=<i>/<n>       Bakes only the i-th of n shards of the probe volumes, so a bake can be split between n
+//                          processes. The map isn't saved. Run once more without -Shard afterwards to collect the
+//                          results into the map; probe volumes baked by the shards aren't baked again.
+//     -Report=<file>       Writes timing and throughput as JSON to the given file. Defaults to
+//                          Saved/SteamAudio/Bakes/<Map>.json.
+//
+// Returns 0 if every layer was baked in every probe volume, and 1 otherwise.
+UCLASS()
+class USteamAudioBakeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USteamAudioBakeCommandlet();
+
+    //
+    // Inherited from UCommandlet
+    //
+
+    // Runs the commandlet.
+    virtual int32 Main(const FString& Params) override;
+};
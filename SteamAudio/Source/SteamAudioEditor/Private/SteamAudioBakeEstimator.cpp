@@ -0,0 +1,492 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioBakeEstimator.h"
+#include "Async/Async.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Compression.h"
+#include "Misc/ConfigCacheIni.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioProbeComponent.h"
+#include "SteamAudioProbeVolume.h"
+#include "SteamAudioScene.h"
+#include "SteamAudioSettings.h"
+#include "SteamAudioStaticMeshActor.h"
+
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FBakeCalibration
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const TCHAR* BakeCalibrationSection = TEXT("SteamAudio.BakeCalibration");
+
+FBakeCalibration FBakeCalibration::Load()
+{
+    FBakeCalibration Calibration;
+
+    GConfig->GetBool(BakeCalibrationSection, TEXT("bCalibrated"), Calibration.bCalibrated, GEditorPerProjectIni);
+    if (!Calibration.bCalibrated)
+        return Calibration;
+
+    GConfig->GetDouble(BakeCalibrationSection, TEXT("SecondsPerRayBounce"), Calibration.SecondsPerRayBounce, GEditorPerProjectIni);
+    GConfig->GetDouble(BakeCalibrationSection, TEXT("SecondsPerVisibilityRay"), Calibration.SecondsPerVisibilityRay, GEditorPerProjectIni);
+    GConfig->GetDouble(BakeCalibrationSection, TEXT("ReflectionsBytesPerChannelSecond"), Calibration.ReflectionsBytesPerChannelSecond, GEditorPerProjectIni);
+    GConfig->GetDouble(BakeCalibrationSection, TEXT("PathingBytesPerProbePair"), Calibration.PathingBytesPerProbePair, GEditorPerProjectIni);
+    GConfig->GetDouble(BakeCalibrationSection, TEXT("CompressionRatio"), Calibration.CompressionRatio, GEditorPerProjectIni);
+    GConfig->GetInt(BakeCalibrationSection, TEXT("NumTriangles"), Calibration.NumTriangles, GEditorPerProjectIni);
+
+    return Calibration;
+}
+
+void FBakeCalibration::Save() const
+{
+    GConfig->SetBool(BakeCalibrationSection, TEXT("bCalibrated"), bCalibrated, GEditorPerProjectIni);
+    GConfig->SetDouble(BakeCalibrationSection, TEXT("SecondsPerRayBounce"), SecondsPerRayBounce, GEditorPerProjectIni);
+    GConfig->SetDouble(BakeCalibrationSection, TEXT("SecondsPerVisibilityRay"), SecondsPerVisibilityRay, GEditorPerProjectIni);
+    GConfig->SetDouble(BakeCalibrationSection, TEXT("ReflectionsBytesPerChannelSecond"), ReflectionsBytesPerChannelSecond, GEditorPerProjectIni);
+    GConfig->SetDouble(BakeCalibrationSection, TEXT("PathingBytesPerProbePair"), PathingBytesPerProbePair, GEditorPerProjectIni);
+    GConfig->SetDouble(BakeCalibrationSection, TEXT("CompressionRatio"), CompressionRatio, GEditorPerProjectIni);
+    GConfig->SetInt(BakeCalibrationSection, TEXT("NumTriangles"), NumTriangles, GEditorPerProjectIni);
+    GConfig->Flush(false, GEditorPerProjectIni);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Estimation
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Size of the parametric reverb data baked for each probe, in bytes. */
+static const double ParametricBytesPerProbe = 16.0;
+
+/** Number of probes baked by a calibration bake. */
+static const int NumCalibrationProbes = 32;
+
+/** Returns how much longer each ray takes to trace in geometry with the given number of triangles than in the
+    geometry against which the calibration was run. Tracing cost grows with the depth of the acceleration structure,
+    so roughly with the logarithm of the number of triangles. */
+static double GetTriangleCostFactor(int NumTriangles, int CalibrationNumTriangles)
+{
+    return FMath::Log2(static_cast<float>(FMath::Max(NumTriangles, 2))) / FMath::Log2(static_cast<float>(FMath::Max(CalibrationNumTriangles, 2)));
+}
+
+/** Returns the length (in seconds) of the impulse responses saved in baked data. */
+static float GetSavedDuration()
+{
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+    return (Settings->BakingSavedDuration > 0.0f) ? FMath::Min(Settings->BakingSavedDuration, Settings->BakingDuration) : Settings->BakingDuration;
+}
+
+/** Returns the size of baked reflections for one probe, in bytes. */
+static double GetReflectionsBytesPerProbe(const FBakeCalibration& Calibration, int Order)
+{
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+
+    double Bytes = 0.0;
+    if (Settings->bBakeConvolution)
+    {
+        Bytes += Calibration.ReflectionsBytesPerChannelSecond * CalcNumChannelsForAmbisonicOrder(Order) * GetSavedDuration();
+    }
+    if (Settings->bBakeParametric)
+    {
+        Bytes += ParametricBytesPerProbe;
+    }
+
+    return Bytes;
+}
+
+/** Returns the number of probes in a probe volume within the given sphere (in Unreal units). */
+static int CountProbesInSphere(ASteamAudioProbeVolume* ProbeVolume, const FVector& Center, float Radius)
+{
+    USteamAudioProbeComponent* ProbeComponent = ProbeVolume->ProbeComponent;
+    if (!ProbeComponent)
+        return ProbeVolume->NumProbes;
+
+    FScopeLock Lock(&ProbeComponent->ProbePositionsCriticalSection);
+
+    int NumProbes = 0;
+    for (const FVector& Position : ProbeComponent->ProbePositions)
+    {
+        if (FVector::DistSquared(Position, Center) <= Radius * Radius)
+        {
+            NumProbes++;
+        }
+    }
+
+    return NumProbes;
+}
+
+/** Estimates the number of ordered pairs of probes in a probe volume that are within the given distance (in Unreal
+    units) of each other, assuming the probes are spread evenly over the volume's floor area. */
+static double EstimateProbePairsInRange(ASteamAudioProbeVolume* ProbeVolume, float Range)
+{
+    double NumProbes = ProbeVolume->NumProbes;
+    if (NumProbes < 2.0)
+        return 0.0;
+
+    FVector Size = ProbeVolume->GetComponentsBoundingBox(true).GetSize();
+    double Area = FMath::Max(Size.X * Size.Y, 1.0);
+
+    double NumNeighbors = FMath::Min(NumProbes - 1.0, NumProbes / Area * PI * Range * Range);
+    return NumProbes * NumNeighbors;
+}
+
+/** Returns the number of ordered pairs of the given positions (in Unreal units) within the given distance of each
+    other. */
+static int CountPairsInRange(const TArray<FVector>& Positions, float Range)
+{
+    int NumPairs = 0;
+    for (int i = 0; i < Positions.Num(); ++i)
+    {
+        for (int j = 0; j < Positions.Num(); ++j)
+        {
+            if (i != j && FVector::DistSquared(Positions[i], Positions[j]) <= Range * Range)
+            {
+                NumPairs++;
+            }
+        }
+    }
+
+    return NumPairs;
+}
+
+/** Returns the ratio of compressed to uncompressed size for the given data, using the compression format chosen in
+    the project settings. */
+static double MeasureCompressionRatio(const uint8* Data, int32 Size)
+{
+    FName FormatName = NAME_None;
+    switch (GetDefault<USteamAudioSettings>()->SerializedDataCompression)
+    {
+    case ESerializedDataCompression::ZLIB:
+        FormatName = NAME_Zlib;
+        break;
+    case ESerializedDataCompression::OODLE:
+#if ((ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 0) || (ENGINE_MAJOR_VERSION > 5))
+        FormatName = NAME_Oodle;
+#else
+        FormatName = NAME_Zlib;
+#endif
+        break;
+    default:
+        return 1.0;
+    }
+
+    if (Size <= 0)
+        return 1.0;
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Size);
+
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(FormatName, Compressed.GetData(), CompressedSize, Data, Size))
+        return 1.0;
+
+    return static_cast<double>(CompressedSize) / Size;
+}
+
+FBakeEstimate EstimateBake(UWorld* World, ULevel* Level, const FBakeTask& Task)
+{
+    check(World);
+    check(Level);
+
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+    FBakeCalibration Calibration = FBakeCalibration::Load();
+
+    ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+    int NumTriangles = (StaticMeshActor && StaticMeshActor->NumTriangles > 0) ? StaticMeshActor->NumTriangles : Calibration.NumTriangles;
+    double TriangleCostFactor = GetTriangleCostFactor(NumTriangles, Calibration.NumTriangles);
+
+    // Static source and listener reflections are only baked for probes within the endpoint's influence radius.
+    IPLBakedDataIdentifier Identifier = GetBakedDataIdentifier(Task);
+    bool bLimitedInfluence = (Identifier.variation == IPL_BAKEDDATAVARIATION_STATICSOURCE || Identifier.variation == IPL_BAKEDDATAVARIATION_STATICLISTENER);
+    FVector InfluenceCenter = ConvertVectorInverse(Identifier.endpointInfluence.center);
+    float InfluenceRadius = ConvertSteamAudioDistanceToUnreal(Identifier.endpointInfluence.radius);
+
+    float VisibilityRange = ConvertSteamAudioDistanceToUnreal(Settings->BakingVisibilityRange);
+
+    TArray<AActor*> ProbeVolumes;
+    UGameplayStatics::GetAllActorsOfClass(World, ASteamAudioProbeVolume::StaticClass(), ProbeVolumes);
+
+    FBakeEstimate Estimate;
+    double NumProbePairs = 0.0;
+
+    for (AActor* Actor : ProbeVolumes)
+    {
+        ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
+        if (!ProbeVolume || !DoesTaskApplyToProbeVolume(Task, ProbeVolume))
+            continue;
+
+        if (Task.Type == EBakeTaskType::PATHING)
+        {
+            Estimate.NumProbes += ProbeVolume->NumProbes;
+            NumProbePairs += EstimateProbePairsInRange(ProbeVolume, VisibilityRange);
+        }
+        else
+        {
+            Estimate.NumProbes += bLimitedInfluence ? CountProbesInSphere(ProbeVolume, InfluenceCenter, InfluenceRadius) : ProbeVolume->NumProbes;
+        }
+    }
+
+    double ResidentSize = 0.0;
+
+    if (Task.Type == EBakeTaskType::PATHING)
+    {
+        int NumThreads = FMath::Max(GetNumThreadsForCPUCoresPercentage(Settings->BakedPathingCPUCoresPercentage), 1);
+        double NumRays = NumProbePairs * Settings->BakingVisibilitySamples * Settings->BakingVisibilitySamples;
+
+        Estimate.Time = NumRays * Calibration.SecondsPerVisibilityRay * TriangleCostFactor / NumThreads;
+        ResidentSize = NumProbePairs * Calibration.PathingBytesPerProbePair;
+    }
+    else
+    {
+        int NumThreads = FMath::Max(GetNumThreadsForCPUCoresPercentage(Settings->BakingCPUCoresPercentage), 1);
+        double NumRayBounces = static_cast<double>(Estimate.NumProbes) * Settings->BakingRays * Settings->BakingBounces;
+
+        Estimate.Time = NumRayBounces * Calibration.SecondsPerRayBounce * TriangleCostFactor / NumThreads;
+        ResidentSize = Estimate.NumProbes * GetReflectionsBytesPerProbe(Calibration, GetBakedOrder(Task, Settings->BakingAmbisonicOrder));
+    }
+
+    double CompressionRatio = (Settings->SerializedDataCompression == ESerializedDataCompression::NONE) ? 1.0 : Calibration.CompressionRatio;
+
+    Estimate.ResidentSize = static_cast<int64>(ResidentSize);
+    Estimate.DiskSize = static_cast<int64>(ResidentSize * CompressionRatio);
+    return Estimate;
+}
+
+double EstimateRealTimeReflectionsTime(int NumSources, int NumTriangles)
+{
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+    FBakeCalibration Calibration = FBakeCalibration::Load();
+
+    int NumThreads = FMath::Max(GetNumThreadsForCPUCoresPercentage(Settings->RealTimeCPUCoresPercentage), 1);
+    double NumRayBounces = static_cast<double>(FMath::Min(NumSources, Settings->RealTimeMaxSources)) * Settings->RealTimeRays * Settings->RealTimeBounces;
+
+    return NumRayBounces * Calibration.SecondsPerRayBounce * GetTriangleCostFactor(NumTriangles, Calibration.NumTriangles) / NumThreads;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Calibration
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Bakes reverb and pathing for the given probes, and measures throughput and data sizes. Runs on a worker thread. */
+static bool RunCalibrationBake(ASteamAudioStaticMeshActor* StaticMeshActor, const TArray<FVector>& ProbePositions,
+    FBakeCalibration& Calibration)
+{
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+    bool bInitializeSucceeded = RunInGameThread<bool>([&]()
+    {
+        return Manager.InitializeSteamAudio(EManagerInitReason::BAKING);
+    });
+    if (!bInitializeSucceeded)
+        return false;
+
+    IPLContext Context = Manager.GetContext();
+    IPLScene Scene = Manager.GetScene();
+
+    FSoftObjectPath GeometryAsset = GetBakeGeometryAsset(StaticMeshActor);
+
+    IPLStaticMesh StaticMesh = RunInGameThread<IPLStaticMesh>([&]()
+    {
+        return LoadStaticMeshFromAsset(GeometryAsset, Context, Scene);
+    });
+    if (!StaticMesh)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load static mesh asset: %s"), *GeometryAsset.GetAssetPathString());
+        Manager.ShutDownSteamAudio();
+        return false;
+    }
+
+    iplStaticMeshAdd(StaticMesh, Scene);
+    iplSceneCommit(Scene);
+
+    IPLProbeBatch ProbeBatch = nullptr;
+    if (iplProbeBatchCreate(Context, &ProbeBatch) != IPL_STATUS_SUCCESS)
+    {
+        iplStaticMeshRelease(&StaticMesh);
+        Manager.ShutDownSteamAudio();
+        return false;
+    }
+
+    for (const FVector& Position : ProbePositions)
+    {
+        IPLSphere Probe{};
+        Probe.center = ConvertVector(Position);
+        Probe.radius = 1.0f;
+        iplProbeBatchAddProbe(ProbeBatch, Probe);
+    }
+
+    iplProbeBatchCommit(ProbeBatch);
+
+    IPLSimulationSettings SimulationSettings = Manager.GetBakingSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
+
+    IPLReflectionsBakeParams ReflectionsBakeParams{};
+    IPLPathBakeParams PathBakeParams{};
+    GetBakeParams(Scene, SimulationSettings, ReflectionsBakeParams, PathBakeParams);
+
+    ReflectionsBakeParams.probeBatch = ProbeBatch;
+    ReflectionsBakeParams.identifier.type = IPL_BAKEDDATATYPE_REFLECTIONS;
+    ReflectionsBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_REVERB;
+
+    PathBakeParams.probeBatch = ProbeBatch;
+    PathBakeParams.identifier.type = IPL_BAKEDDATATYPE_PATHING;
+    PathBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_DYNAMIC;
+
+    const int NumProbes = ProbePositions.Num();
+
+    double StartTime = FPlatformTime::Seconds();
+    iplReflectionsBakerBake(Context, &ReflectionsBakeParams, nullptr, nullptr);
+    double ReflectionsTime = FPlatformTime::Seconds() - StartTime;
+
+    double NumRayBounces = static_cast<double>(NumProbes) * ReflectionsBakeParams.numRays * ReflectionsBakeParams.numBounces;
+    Calibration.SecondsPerRayBounce = ReflectionsTime * ReflectionsBakeParams.numThreads / NumRayBounces;
+
+    double ReflectionsBytesPerProbe = static_cast<double>(iplProbeBatchGetDataSize(ProbeBatch, &ReflectionsBakeParams.identifier)) / NumProbes;
+    if (ReflectionsBakeParams.bakeFlags & IPL_REFLECTIONSBAKEFLAGS_BAKEPARAMETRIC)
+    {
+        ReflectionsBytesPerProbe -= ParametricBytesPerProbe;
+    }
+    if ((ReflectionsBakeParams.bakeFlags & IPL_REFLECTIONSBAKEFLAGS_BAKECONVOLUTION) && ReflectionsBakeParams.savedDuration > 0.0f)
+    {
+        Calibration.ReflectionsBytesPerChannelSecond = FMath::Max(ReflectionsBytesPerProbe, 0.0) /
+            (CalcNumChannelsForAmbisonicOrder(ReflectionsBakeParams.order) * ReflectionsBakeParams.savedDuration);
+    }
+
+    // Pathing is baked between pairs of probes within visibility range of each other, so its cost is measured per pair.
+    int NumProbePairs = CountPairsInRange(ProbePositions, ConvertSteamAudioDistanceToUnreal(PathBakeParams.visRange));
+    if (NumProbePairs > 0)
+    {
+        StartTime = FPlatformTime::Seconds();
+        iplPathBakerBake(Context, &PathBakeParams, nullptr, nullptr);
+        double PathingTime = FPlatformTime::Seconds() - StartTime;
+
+        double NumVisibilityRays = static_cast<double>(NumProbePairs) * PathBakeParams.numSamples * PathBakeParams.numSamples;
+        Calibration.SecondsPerVisibilityRay = PathingTime * PathBakeParams.numThreads / NumVisibilityRays;
+        Calibration.PathingBytesPerProbePair = static_cast<double>(iplProbeBatchGetDataSize(ProbeBatch, &PathBakeParams.identifier)) / NumProbePairs;
+    }
+
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    IPLSerializedObject SerializedObject = nullptr;
+    if (iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject) == IPL_STATUS_SUCCESS)
+    {
+        iplProbeBatchSave(ProbeBatch, SerializedObject);
+        Calibration.CompressionRatio = MeasureCompressionRatio(iplSerializedObjectGetData(SerializedObject), static_cast<int32>(iplSerializedObjectGetSize(SerializedObject)));
+        iplSerializedObjectRelease(&SerializedObject);
+    }
+
+    UE_LOG(LogSteamAudioEditor, Log, TEXT("Calibrated bake estimates with %d probes: %.3g s per ray bounce, %.3g s per visibility ray, %.0f bytes per channel-second, %.1f bytes per probe pair, %.2f compression ratio."),
+        NumProbes, Calibration.SecondsPerRayBounce, Calibration.SecondsPerVisibilityRay, Calibration.ReflectionsBytesPerChannelSecond,
+        Calibration.PathingBytesPerProbePair, Calibration.CompressionRatio);
+
+    iplProbeBatchRelease(&ProbeBatch);
+    iplStaticMeshRelease(&StaticMesh);
+    Manager.ShutDownSteamAudio();
+
+    return ReflectionsTime > 0.0;
+}
+
+void CalibrateBakeEstimates(UWorld* World, ULevel* Level, FSteamAudioCalibrationComplete OnCalibrationComplete)
+{
+    check(World);
+    check(Level);
+
+    if (GIsEditorJobRunning)
+        return;
+
+    ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+    if (!StaticMeshActor || !StaticMeshActor->Asset.IsValid())
+    {
+        FSteamAudioEditorModule::NotifyStarting(NSLOCTEXT("SteamAudio", "CalibratingBake", "Calibrating bake estimates..."));
+        FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "CalibrateFailedNoScene", "Calibration failed: no static geometry."));
+        OnCalibrationComplete.ExecuteIfBound(false);
+        return;
+    }
+
+    // Calibrate using neighboring probes from the largest probe volume, so that some of them are within visibility
+    // range of each other and pathing can be measured.
+    TArray<AActor*> ProbeVolumes;
+    UGameplayStatics::GetAllActorsOfClass(World, ASteamAudioProbeVolume::StaticClass(), ProbeVolumes);
+
+    ASteamAudioProbeVolume* LargestProbeVolume = nullptr;
+    for (AActor* Actor : ProbeVolumes)
+    {
+        ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
+        if (ProbeVolume && ProbeVolume->ProbeComponent && (!LargestProbeVolume || ProbeVolume->NumProbes > LargestProbeVolume->NumProbes))
+        {
+            LargestProbeVolume = ProbeVolume;
+        }
+    }
+
+    TArray<FVector> ProbePositions;
+    if (LargestProbeVolume)
+    {
+        FScopeLock Lock(&LargestProbeVolume->ProbeComponent->ProbePositionsCriticalSection);
+
+        const TArray<FVector>& AllProbePositions = LargestProbeVolume->ProbeComponent->ProbePositions;
+        ProbePositions.Append(AllProbePositions.GetData(), FMath::Min(AllProbePositions.Num(), NumCalibrationProbes));
+    }
+
+    if (ProbePositions.Num() == 0)
+    {
+        FSteamAudioEditorModule::NotifyStarting(NSLOCTEXT("SteamAudio", "CalibratingBake", "Calibrating bake estimates..."));
+        FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "CalibrateFailedNoProbes", "Calibration failed: no probes."));
+        OnCalibrationComplete.ExecuteIfBound(false);
+        return;
+    }
+
+    // Calibration is short, and can't be cancelled.
+    if (!BeginEditorJob())
+        return;
+
+    GIsBaking = true;
+
+    FSteamAudioEditorModule::NotifyStarting(NSLOCTEXT("SteamAudio", "CalibratingBake", "Calibrating bake estimates..."));
+
+    FBakeCalibration Calibration;
+    if (StaticMeshActor->NumTriangles > 0)
+    {
+        Calibration.NumTriangles = StaticMeshActor->NumTriangles;
+    }
+
+    Async(EAsyncExecution::Thread, [StaticMeshActor, ProbePositions, Calibration, OnCalibrationComplete]() mutable
+    {
+        bool bSucceeded = RunCalibrationBake(StaticMeshActor, ProbePositions, Calibration);
+
+        AsyncTask(ENamedThreads::GameThread, [bSucceeded, Calibration, OnCalibrationComplete]() mutable
+        {
+            if (bSucceeded)
+            {
+                Calibration.bCalibrated = true;
+                Calibration.Save();
+
+                FSteamAudioEditorModule::NotifySucceeded(NSLOCTEXT("SteamAudio", "CalibrateSucceeded", "Calibration succeeded."));
+            }
+            else
+            {
+                FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "CalibrateFailed", "Calibration failed."));
+            }
+
+            GIsBaking = false;
+            EndEditorJob();
+            OnCalibrationComplete.ExecuteIfBound(bSucceeded);
+        });
+    });
+}
+
+}
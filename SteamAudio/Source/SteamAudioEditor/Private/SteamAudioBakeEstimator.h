@@ -0,0 +1,104 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioBaking.h"
+
+class UWorld;
+class ULevel;
+
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FBakeEstimate
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Predicted cost of baking one layer, across all the probe volumes it applies to. */
+struct FBakeEstimate
+{
+    /** Number of probes that will be baked. */
+    int NumProbes = 0;
+
+    /** Wall-clock time, in seconds. */
+    double Time = 0.0;
+
+    /** Size of the baked data once loaded, in bytes. */
+    int64 ResidentSize = 0;
+
+    /** Size of the baked data on disk, after compression, in bytes. */
+    int64 DiskSize = 0;
+};
+
+/**
+ * Measurements of how fast this machine bakes, and how large baked data is, used to estimate bakes. Until a
+ * calibration bake has been run, conservative defaults are used. Calibration results are saved in the per-project
+ * editor settings, since they depend on the machine.
+ */
+struct FBakeCalibration
+{
+    /** Time to trace one ray for one bounce when baking reflections, on one thread, in seconds. */
+    double SecondsPerRayBounce = 2.0e-7;
+
+    /** Time to trace one visibility ray between two probes when baking pathing, on one thread, in seconds. */
+    double SecondsPerVisibilityRay = 5.0e-7;
+
+    /** Size of baked reflections per probe, per Ambisonic channel, per second of saved impulse response, in bytes. */
+    double ReflectionsBytesPerChannelSecond = 1200.0;
+
+    /** Size of baked pathing per pair of probes within visibility range of each other, in bytes. */
+    double PathingBytesPerProbePair = 8.0;
+
+    /** Ratio of compressed to uncompressed size of baked data, when compression is enabled. */
+    double CompressionRatio = 0.6;
+
+    /** Number of triangles in the geometry against which the calibration bake was run. */
+    int NumTriangles = 100000;
+
+    /** True if these values were measured, rather than defaults. */
+    bool bCalibrated = false;
+
+    static FBakeCalibration Load();
+    void Save() const;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Estimation
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if WITH_EDITOR
+
+DECLARE_DELEGATE_OneParam(FSteamAudioCalibrationComplete, bool);
+
+/** Estimates the time taken and size of baked data for a task, based on the number of probes, the number of
+    triangles in the exported geometry, the bake settings, and the last calibration. Call on the game thread. */
+FBakeEstimate STEAMAUDIOEDITOR_API EstimateBake(UWorld* World, ULevel* Level, const FBakeTask& Task);
+
+/** Estimates the wall-clock time (in seconds) taken by one update of real-time reflections for the given number of
+    sources (including listener-centric reverb), against geometry with the given number of triangles, based on the
+    real-time settings and the last calibration. */
+double STEAMAUDIOEDITOR_API EstimateRealTimeReflectionsTime(int NumSources, int NumTriangles);
+
+/** Bakes reverb and pathing for a small sample of the level's probes, and saves the measured throughput and data
+    sizes for later estimates. Runs on a worker thread, and cannot run at the same time as a bake. */
+void STEAMAUDIOEDITOR_API CalibrateBakeEstimates(UWorld* World, ULevel* Level,
+    FSteamAudioCalibrationComplete OnCalibrationComplete = FSteamAudioCalibrationComplete());
+
+#endif
+
+}
@@ -84,16 +84,24 @@ TSharedRef<SDockTab> FBakeWindow::SpawnTab(const FSpawnTabArgs& SpawnTabArgs)
         SNew(SHeaderRow)
         + SHeaderRow::Column("Actor")
         .DefaultLabel(FText::FromString(TEXT("Actor")))
-        .FillWidth(0.35f)
+        .FillWidth(0.25f)
         + SHeaderRow::Column("Level")
         .DefaultLabel(FText::FromString(TEXT("Level")))
-        .FillWidth(0.3f)
+        .FillWidth(0.2f)
         + SHeaderRow::Column("Type")
         .DefaultLabel(FText::FromString(TEXT("Type")))
-        .FillWidth(0.2f)
+        .FillWidth(0.15f)
         + SHeaderRow::Column("Data Size")
         .DefaultLabel(FText::FromString(TEXT("Data Size")))
-        .FillWidth(0.15f)
+        .FillWidth(0.12f)
+        + SHeaderRow::Column("Estimated Time")
+        .DefaultLabel(FText::FromString(TEXT("Est. Time")))
+        .DefaultTooltip(NSLOCTEXT("SteamAudio", "EstimatedTimeTooltip", "Estimated time to bake this layer with the current settings."))
+        .FillWidth(0.12f)
+        + SHeaderRow::Column("Estimated Size")
+        .DefaultLabel(FText::FromString(TEXT("Est. Size")))
+        .DefaultTooltip(NSLOCTEXT("SteamAudio", "EstimatedSizeTooltip", "Estimated size of the baked data for this layer with the current settings, once loaded / on disk."))
+        .FillWidth(0.16f)
         );
 
     return SNew(SDockTab)
@@ -125,12 +133,42 @@ TSharedRef<SDockTab> FBakeWindow::SpawnTab(const FSpawnTabArgs& SpawnTabArgs)
         .VAlign(VAlign_Center)
         .HAlign(HAlign_Center)
         .IsEnabled(this, &FBakeWindow::IsBakeEnabled)
+        .OnClicked(this, &FBakeWindow::OnCalibrate)
+        .ToolTipText(NSLOCTEXT("SteamAudio", "CalibrateEstimatesTooltip", "Bakes a small sample of probes to measure how fast this machine bakes, so the estimated time and size of each layer are more accurate."))
+        [
+            SNew(STextBlock)
+            .Text(NSLOCTEXT("SteamAudio", "CalibrateEstimates", "Calibrate Estimates"))
+        ]
+        ]
+    + SHorizontalBox::Slot()
+        .AutoWidth()
+        [
+            SNew(SButton)
+            .ContentPadding(3)
+        .VAlign(VAlign_Center)
+        .HAlign(HAlign_Center)
+        .IsEnabled(this, &FBakeWindow::IsBakeEnabled)
         .OnClicked(this, &FBakeWindow::OnBakeSelected)
         [
             SNew(STextBlock)
             .Text(NSLOCTEXT("SteamAudio", "BakeSelected", "Bake Selected"))
         ]
         ]
+    + SHorizontalBox::Slot()
+        .AutoWidth()
+        [
+            SNew(SButton)
+            .ContentPadding(3)
+        .VAlign(VAlign_Center)
+        .HAlign(HAlign_Center)
+        .IsEnabled(this, &FBakeWindow::IsBakeEnabled)
+        .OnClicked(this, &FBakeWindow::OnBakeSelectedChanged)
+        .ToolTipText(NSLOCTEXT("SteamAudio", "BakeSelectedChangedTooltip", "Bakes the selected layers only in probe volumes where they haven't been baked, or where nearby geometry has changed since they were baked."))
+        [
+            SNew(STextBlock)
+            .Text(NSLOCTEXT("SteamAudio", "BakeSelectedChanged", "Bake Selected (Changed Only)"))
+        ]
+        ]
         ]
         ];
 }
@@ -160,7 +198,7 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
             SNew(SHorizontalBox)
             + SHorizontalBox::Slot()
         .HAlign(HAlign_Left)
-        .FillWidth(0.35f)
+        .FillWidth(0.25f)
         [
             SNew(STextBlock)
             .Text(Item->Actor ? FText::FromString(Item->Actor->GetName()) : FText::FromString("N/A"))
@@ -168,7 +206,7 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
         ]
     + SHorizontalBox::Slot()
         .HAlign(HAlign_Left)
-        .FillWidth(0.3f)
+        .FillWidth(0.2f)
         [
             SNew(STextBlock)
             .Text(Item->Actor ? FText::FromString(Item->Actor->GetLevel()->GetName()) : FText::FromString("N/A"))
@@ -176,7 +214,7 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
         ]
     + SHorizontalBox::Slot()
         .HAlign(HAlign_Left)
-        .FillWidth(0.2f)
+        .FillWidth(0.15f)
         [
             SNew(STextBlock)
             .Text(FText::FromString(Type))
@@ -184,55 +222,110 @@ TSharedRef<ITableRow> FBakeWindow::OnGenerateRow(TSharedPtr<FBakeWindowRow> Item
         ]
     + SHorizontalBox::Slot()
         .HAlign(HAlign_Right)
-        .FillWidth(0.15f)
+        .FillWidth(0.12f)
         [
             SNew(STextBlock)
             .Text(FText::AsMemory(Item->Size))
         .Font(IDetailLayoutBuilder::GetDetailFont())
         ]
+    + SHorizontalBox::Slot()
+        .HAlign(HAlign_Right)
+        .FillWidth(0.12f)
+        [
+            SNew(STextBlock)
+            .Text(FText::AsTimespan(FTimespan::FromSeconds(FMath::CeilToDouble(Item->Estimate.Time))))
+        .Font(IDetailLayoutBuilder::GetDetailFont())
+        ]
+    + SHorizontalBox::Slot()
+        .HAlign(HAlign_Right)
+        .FillWidth(0.16f)
+        [
+            SNew(STextBlock)
+            .Text(FText::Format(NSLOCTEXT("SteamAudio", "EstimatedSize", "{0} / {1}"), FText::AsMemory(Item->Estimate.ResidentSize), FText::AsMemory(Item->Estimate.DiskSize)))
+        .Font(IDetailLayoutBuilder::GetDetailFont())
+        ]
         ];
 }
 
 bool FBakeWindow::IsBakeEnabled() const
 {
-    return !GIsBaking.load();
+    return !GIsEditorJobRunning.load();
 }
 
 FReply FBakeWindow::OnBakeSelected()
 {
-    TArray<TSharedPtr<FBakeWindowRow>> SelectedRows;
-    ListView->GetSelectedItems(SelectedRows);
+    UWorld* World = GEditor->GetLevelViewportClients()[0]->GetWorld();
+    ULevel* Level = World->GetCurrentLevel();
 
-    TArray<FBakeTask> Tasks;
-    for (TSharedPtr<FBakeWindowRow> Row : SelectedRows)
-    {
-        FBakeTask Task;
-        Task.Type = Row->Type;
+    Bake(World, Level, GetSelectedTasks(), FSteamAudioBakeComplete::CreateRaw(this, &FBakeWindow::OnBakeComplete));
 
-        switch (Task.Type)
-        {
-        case EBakeTaskType::STATIC_SOURCE_REFLECTIONS:
-            Task.BakedSource = Row->Actor->FindComponentByClass<USteamAudioBakedSourceComponent>();
-            break;
-        case EBakeTaskType::STATIC_LISTENER_REFLECTIONS:
-            Task.BakedListener = Row->Actor->FindComponentByClass<USteamAudioBakedListenerComponent>();
-            break;
-        case EBakeTaskType::PATHING:
-            Task.PathingProbeVolume = Cast<ASteamAudioProbeVolume>(Row->Actor);
-            break;
-        }
+    return FReply::Handled();
+}
 
-        Tasks.Add(Task);
+FReply FBakeWindow::OnBakeSelectedChanged()
+{
+    UWorld* World = GEditor->GetLevelViewportClients()[0]->GetWorld();
+    ULevel* Level = World->GetCurrentLevel();
+
+    TArray<FBakeTask> Tasks = GetOutOfDateBakeTasks(World, Level, GetSelectedTasks());
+    if (Tasks.Num() == 0)
+    {
+        FSteamAudioEditorModule::NotifyStarting(NSLOCTEXT("SteamAudio", "BakeUpToDate", "Baked data is up to date."));
+        FSteamAudioEditorModule::NotifySucceeded(NSLOCTEXT("SteamAudio", "BakeUpToDate", "Baked data is up to date."));
+        return FReply::Handled();
     }
 
+    Bake(World, Level, Tasks, FSteamAudioBakeComplete::CreateRaw(this, &FBakeWindow::OnBakeComplete));
+
+    return FReply::Handled();
+}
+
+FReply FBakeWindow::OnCalibrate()
+{
     UWorld* World = GEditor->GetLevelViewportClients()[0]->GetWorld();
     ULevel* Level = World->GetCurrentLevel();
 
-    Bake(World, Level, Tasks, FSteamAudioBakeComplete::CreateRaw(this, &FBakeWindow::OnBakeComplete));
+    CalibrateBakeEstimates(World, Level, FSteamAudioCalibrationComplete::CreateRaw(this, &FBakeWindow::OnCalibrationComplete));
 
     return FReply::Handled();
 }
 
+/** Returns the task that bakes the layer shown in the given row. */
+static FBakeTask GetTaskForRow(const FBakeWindowRow& Row)
+{
+    FBakeTask Task{};
+    Task.Type = Row.Type;
+
+    switch (Task.Type)
+    {
+    case EBakeTaskType::STATIC_SOURCE_REFLECTIONS:
+        Task.BakedSource = Row.Actor->FindComponentByClass<USteamAudioBakedSourceComponent>();
+        break;
+    case EBakeTaskType::STATIC_LISTENER_REFLECTIONS:
+        Task.BakedListener = Row.Actor->FindComponentByClass<USteamAudioBakedListenerComponent>();
+        break;
+    case EBakeTaskType::PATHING:
+        Task.PathingProbeVolume = Cast<ASteamAudioProbeVolume>(Row.Actor);
+        break;
+    }
+
+    return Task;
+}
+
+TArray<FBakeTask> FBakeWindow::GetSelectedTasks() const
+{
+    TArray<TSharedPtr<FBakeWindowRow>> SelectedRows;
+    ListView->GetSelectedItems(SelectedRows);
+
+    TArray<FBakeTask> Tasks;
+    for (TSharedPtr<FBakeWindowRow> Row : SelectedRows)
+    {
+        Tasks.Add(GetTaskForRow(*Row));
+    }
+
+    return Tasks;
+}
+
 void FBakeWindow::OnBakeComplete()
 {
     AsyncTask(ENamedThreads::GameThread, [this]()
@@ -242,6 +335,12 @@ void FBakeWindow::OnBakeComplete()
     });
 }
 
+void FBakeWindow::OnCalibrationComplete(bool bSucceeded)
+{
+    RefreshBakeTasks();
+    ListView->RequestListRefresh();
+}
+
 // todo: update window when scene changes
 void FBakeWindow::RefreshBakeTasks()
 {
@@ -343,6 +442,12 @@ void FBakeWindow::RefreshBakeTasks()
             }
         }
     }
+
+    ULevel* Level = World->GetCurrentLevel();
+    for (TSharedPtr<FBakeWindowRow>& Row : BakeWindowRows)
+    {
+        Row->Estimate = EstimateBake(World, Level, GetTaskForRow(*Row));
+    }
 }
 
 }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SteamAudioBakeEstimator.h"
 #include "SteamAudioBaking.h"
 
 
@@ -31,6 +32,9 @@ struct FBakeWindowRow
     EBakeTaskType Type;
     AActor* Actor;
     int Size;
+
+    /** Predicted cost of baking this layer with the current settings. */
+    FBakeEstimate Estimate;
 };
 
 class FBakeWindow : public TSharedFromThis<FBakeWindow>
@@ -49,7 +53,11 @@ private:
     TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FBakeWindowRow> Item, const TSharedRef<STableViewBase>& OwnerTable);
     bool IsBakeEnabled() const;
     FReply OnBakeSelected();
+    FReply OnBakeSelectedChanged();
+    FReply OnCalibrate();
     void OnBakeComplete();
+    void OnCalibrationComplete(bool bSucceeded);
+    TArray<FBakeTask> GetSelectedTasks() const;
     void RefreshBakeTasks();
 };
 
@@ -15,13 +15,21 @@
 //
 
 #include "SteamAudioBaking.h"
+#include "Editor.h"
 #include "EngineUtils.h"
 #include "Async/Async.h"
+#include "HAL/FileManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
 #include "SteamAudioBakedListenerComponent.h"
 #include "SteamAudioBakedSourceComponent.h"
 #include "SteamAudioCommon.h"
 #include "SteamAudioManager.h"
+#include "SteamAudioProbeComponent.h"
 #include "SteamAudioProbeVolume.h"
 #include "SteamAudioScene.h"
 #include "SteamAudioSerializedObject.h"
@@ -51,42 +59,915 @@ FString FBakeTask::GetLayerName() const
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FBakeShard
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** A probe volume to bake, along with the tasks that apply to it. Each probe volume is baked into its own probe batch
+    asset, independently of all others, so probe volumes can be baked in parallel. */
+struct FBakeShard
+{
+    ASteamAudioProbeVolume* ProbeVolume = nullptr;
+
+    /** Identifies the probe volume in the bake manifest. */
+    FString Name;
+
+    /** Hash of the exported geometry near the probe volume, recorded with each layer that is baked. */
+    uint32 GeometryHash = 0;
+
+    TArray<const FBakeTask*> Tasks;
+
+    /** Number of tasks finished so far, whether or not they succeeded. */
+    std::atomic<int> NumTasksCompleted{ 0 };
+
+    /** Progress of the task being baked, from 0 to 1. */
+    std::atomic<float> TaskProgress{ 0.0f };
+
+    int NumTasksSucceeded = 0;
+
+    /** True if all tasks were baked, and the probe batch was saved. */
+    bool bSucceeded = false;
+
+    /** Timing and throughput, filled in as the probe volume is baked. */
+    FBakeProbeVolumeReport Report;
+
+    /** Sum of process CPU utilization samples (in hundredths of a percent) taken while the current task is baked,
+        used for telemetry. */
+    std::atomic<int64> CPUTimeSum{ 0 };
+    std::atomic<int> NumCPUTimeSamples{ 0 };
+
+    float GetProgress() const
+    {
+        return (Tasks.Num() > 0) ? FMath::Min((NumTasksCompleted.load() + TaskProgress.load()) / Tasks.Num(), 1.0f) : 1.0f;
+    }
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FBakeManifest
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Records which probe volumes have been baked so far, so a bake that fails or is cancelled partway through can resume
+ * from where it stopped. Layers checkpointed while baking a probe volume are also recorded, so a probe volume that was
+ * only partly baked resumes from its last checkpoint. There is one manifest per level, saved in the project's Saved
+ * directory, plus one per shard when a bake is split between processes. A bake picks up probe volumes recorded in any
+ * of them. A manifest starts over whenever the geometry, bake settings, or tasks change, and all of them are deleted
+ * once an unsharded bake succeeds.
+ */
+class FBakeManifest
+{
+public:
+    /** BasePath is the path to the level's manifest, without extension. ShardName is empty unless the bake is one
+        shard of a bake split between processes. */
+    FBakeManifest(const FString& InBasePath, const FString& ShardName, const FString& InKey)
+        : BasePath(InBasePath)
+        , Path(ShardName.IsEmpty() ? InBasePath + TEXT(".txt") : InBasePath + TEXT(".") + ShardName + TEXT(".txt"))
+        , Key(InKey)
+    {
+        for (const FString& FileName : FindManifestFiles())
+        {
+            TArray<FString> Lines;
+            if (FFileHelper::LoadFileToStringArray(Lines, *FileName) && Lines.Num() > 0 && Lines[0] == Key)
+            {
+                for (int i = 1; i < Lines.Num(); ++i)
+                {
+                    CompletedShards.Add(Lines[i]);
+                }
+            }
+        }
+    }
+
+    /** Thread-safe. */
+    bool IsCompleted(const FString& ShardName) const
+    {
+        FScopeLock Lock(&CriticalSection);
+        return CompletedShards.Contains(ShardName);
+    }
+
+    /** Records a probe volume, or a checkpointed layer in one, as baked. Thread-safe. */
+    void MarkCompleted(const FString& ShardName)
+    {
+        FScopeLock Lock(&CriticalSection);
+
+        CompletedShards.Add(ShardName);
+
+        TArray<FString> Lines;
+        Lines.Add(Key);
+        Lines.Append(CompletedShards.Array());
+
+        if (!FFileHelper::SaveStringArrayToFile(Lines, *Path))
+        {
+            UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to save bake manifest: %s"), *Path);
+        }
+    }
+
+    /** Deletes the level's manifest, and those of all shards. */
+    void DeleteAll()
+    {
+        for (const FString& FileName : FindManifestFiles())
+        {
+            IFileManager::Get().Delete(*FileName, false, false, true);
+        }
+    }
+
+private:
+    FString BasePath;
+    FString Path;
+    FString Key;
+    TSet<FString> CompletedShards;
+    mutable FCriticalSection CriticalSection;
+
+    TArray<FString> FindManifestFiles() const
+    {
+        FString Directory = FPaths::GetPath(BasePath);
+
+        TArray<FString> FileNames;
+        IFileManager::Get().FindFiles(FileNames, *(BasePath + TEXT(".txt")), true, false);
+
+        TArray<FString> ShardFileNames;
+        IFileManager::Get().FindFiles(ShardFileNames, *(BasePath + TEXT(".*.txt")), true, false);
+        FileNames.Append(ShardFileNames);
+
+        for (FString& FileName : FileNames)
+        {
+            FileName = Directory / FileName;
+        }
+
+        return FileNames;
+    }
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FBakeCache
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Stores baked probe batches in a directory, keyed by a hash of everything that goes into baking them: the geometry,
+ * the probe positions, the bake settings, the tasks, and the other layers already in the probe batch. A probe volume
+ * whose inputs match a cached bake is restored from the cache instead of being baked again, even if it was baked in
+ * another level, or on another machine sharing the same directory.
+ */
+class FBakeCache
+{
+public:
+    /** SceneDigest identifies the geometry being baked against. The cache is disabled if either argument is empty. */
+    FBakeCache(const FString& InDirectory, const FString& InSceneDigest)
+        : Directory((InDirectory.IsEmpty() || InSceneDigest.IsEmpty()) ? FString() : InDirectory)
+        , SceneDigest(InSceneDigest)
+    {}
+
+    bool IsEnabled() const { return !Directory.IsEmpty(); }
+
+    /** Returns the key for a probe volume with the given probes, whose other inputs are described by Inputs. */
+    FString GetKey(const TArray<FVector>& ProbePositions, const FString& Inputs) const
+    {
+        FSHA1 Sha;
+        Sha.UpdateWithString(*SceneDigest, SceneDigest.Len());
+        Sha.Update(reinterpret_cast<const uint8*>(ProbePositions.GetData()), ProbePositions.Num() * sizeof(FVector));
+        Sha.UpdateWithString(*Inputs, Inputs.Len());
+        Sha.Final();
+
+        FSHAHash Hash;
+        Sha.GetHash(Hash.Hash);
+        return Hash.ToString();
+    }
+
+    bool Load(const FString& Key, TArray<uint8>& OutData) const
+    {
+        FString Path = GetPath(Key);
+        return IFileManager::Get().FileExists(*Path) && FFileHelper::LoadFileToArray(OutData, *Path) && OutData.Num() > 0;
+    }
+
+    /** Stores a serialized probe batch. The file is written under a temporary name and then renamed, so other
+        processes sharing the cache never see a partially written file. Thread-safe. */
+    void Store(const FString& Key, const uint8* Data, int64 Size) const
+    {
+        FString Path = GetPath(Key);
+        FString TempPath = Path + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+        if (!FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Data, Size), *TempPath) ||
+            !IFileManager::Get().Move(*Path, *TempPath, true, true))
+        {
+            UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to save to bake cache: %s"), *Path);
+            IFileManager::Get().Delete(*TempPath, false, false, true);
+        }
+    }
+
+private:
+    FString Directory;
+    FString SceneDigest;
+
+    FString GetPath(const FString& Key) const { return Directory / Key + TEXT(".bin"); }
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Baking
 // ---------------------------------------------------------------------------------------------------------------------
 
-std::atomic<bool> GIsBaking(false);
-static int GNumBakeTasks = 0;
-static int GCurrentBakeTask = 0;
-static int GNumProbeVolumes = 0;
-static int GCurrentProbeVolume = 0;
+/** When the number of probe volumes to bake in parallel is chosen automatically, each one gets at least this many
+    threads. */
+static const int MinThreadsPerProbeVolume = 4;
+
+std::atomic<bool> GIsBaking(false);
+std::atomic<bool> GIsEditorJobRunning(false);
+static FSimpleDelegate GCancelEditorJob;
+static TArray<TUniquePtr<FBakeShard>> GBakeShards;
+static std::atomic<int> GNumProbeVolumesBaked(0);
+
+bool BeginEditorJob(FSimpleDelegate OnCancel)
+{
+    check(IsInGameThread());
+
+    if (GEditor && GEditor->PlayWorld)
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to start Steam Audio job: stop playing in the editor first."));
+        return false;
+    }
+
+    bool bExpected = false;
+    if (!GIsEditorJobRunning.compare_exchange_strong(bExpected, true))
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to start Steam Audio job: a bake, calibration, or probe generation is already running."));
+        return false;
+    }
+
+    GCancelEditorJob = MoveTemp(OnCancel);
+    return true;
+}
+
+void EndEditorJob()
+{
+    GIsEditorJobRunning = false;
+}
+
+void CancelEditorJobAndWait()
+{
+    check(IsInGameThread());
+
+    if (!GIsEditorJobRunning)
+        return;
+
+    GCancelEditorJob.ExecuteIfBound();
+
+    // Jobs may finish by running tasks on the game thread, so keep running them while waiting.
+    while (GIsEditorJobRunning)
+    {
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        FPlatformProcess::Sleep(0.01f);
+    }
+
+    GCancelEditorJob.Unbind();
+}
+
+static void CancelBake()
+{
+    IPLContext Context = SteamAudio::FSteamAudioModule::GetManager().GetContext();
+
+    // Stop workers from starting any more tasks before cancelling the ones in progress.
+    GIsBaking = false;
+
+    iplReflectionsBakerCancelBake(Context);
+    iplPathBakerCancelBake(Context);
+}
+
+static void STDCALL BakeProgressCallback(float Progress, void* UserData)
+{
+    FBakeShard* Shard = static_cast<FBakeShard*>(UserData);
+    Shard->TaskProgress = Progress;
+
+    Shard->CPUTimeSum += FMath::RoundToInt(FPlatformTime::GetCPUTime().CPUTimePctRelative * 100.0f);
+    Shard->NumCPUTimeSamples++;
+
+    float TotalProgress = 0.0f;
+    for (const TUniquePtr<FBakeShard>& AnyShard : GBakeShards)
+    {
+        TotalProgress += AnyShard->GetProgress();
+    }
+    TotalProgress /= FMath::Max(GBakeShards.Num(), 1);
+
+    FSteamAudioEditorModule::NotifyUpdate(FText::FormatOrdered(NSLOCTEXT("SteamAudio", "BakeProgress", "Probe Volumes {0}/{1}\nBaking ({2})..."),
+        FText::AsNumber(GNumProbeVolumesBaked.load()), FText::AsNumber(GBakeShards.Num()),
+        FText::AsPercent(TotalProgress)));
+}
+
+IPLBakedDataIdentifier GetBakedDataIdentifier(const FBakeTask& Task)
+{
+    IPLBakedDataIdentifier Identifier{};
+
+    if (Task.Type == EBakeTaskType::PATHING)
+    {
+        Identifier.type = IPL_BAKEDDATATYPE_PATHING;
+        Identifier.variation = IPL_BAKEDDATAVARIATION_DYNAMIC;
+    }
+    else
+    {
+        Identifier.type = IPL_BAKEDDATATYPE_REFLECTIONS;
+        if (Task.Type == EBakeTaskType::STATIC_SOURCE_REFLECTIONS)
+        {
+            Identifier.variation = IPL_BAKEDDATAVARIATION_STATICSOURCE;
+
+            if (Task.BakedSource)
+            {
+                Identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedSource->GetOwner()->GetTransform().GetLocation());
+                Identifier.endpointInfluence.radius = Task.BakedSource->InfluenceRadius;
+            }
+        }
+        else if (Task.Type == EBakeTaskType::STATIC_LISTENER_REFLECTIONS)
+        {
+            Identifier.variation = IPL_BAKEDDATAVARIATION_STATICLISTENER;
+
+            if (Task.BakedListener)
+            {
+                Identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedListener->GetOwner()->GetTransform().GetLocation());
+                Identifier.endpointInfluence.radius = Task.BakedListener->InfluenceRadius;
+            }
+        }
+        else if (Task.Type == EBakeTaskType::REVERB)
+        {
+            Identifier.variation = IPL_BAKEDDATAVARIATION_REVERB;
+        }
+    }
+
+    return Identifier;
+}
+
+/** Returns true if the given task should be baked in the given probe volume. Pathing is only baked for the probe
+    volume it was requested for. */
+bool DoesTaskApplyToProbeVolume(const FBakeTask& Task, ASteamAudioProbeVolume* ProbeVolume)
+{
+    if (Task.Type == EBakeTaskType::PATHING && Task.PathingProbeVolume != ProbeVolume)
+        return false;
+
+    return !Task.ProbeVolume || Task.ProbeVolume == ProbeVolume;
+}
+
+/** Returns a hash of the exported geometry within the influence distance of the given probe volume. */
+static uint32 GetGeometryHashForProbeVolume(ASteamAudioStaticMeshActor* StaticMeshActor, ASteamAudioProbeVolume* ProbeVolume)
+{
+    float InfluenceDistance = SteamAudio::ConvertSteamAudioDistanceToUnreal(GetDefault<USteamAudioSettings>()->BakingGeometryInfluenceDistance);
+
+    FBox Bounds = ProbeVolume->GetComponentsBoundingBox(true).ExpandBy(InfluenceDistance);
+    return StaticMeshActor->GetGeometryHash(Bounds);
+}
+
+/** Returns the ambisonic order at which to bake the given task, given the order used for all other tasks. */
+IPLint32 GetBakedOrder(const FBakeTask& Task, IPLint32 Order)
+{
+    int ReverbOrder = GetDefault<USteamAudioSettings>()->BakingReverbAmbisonicOrder;
+    if (Task.Type == EBakeTaskType::REVERB && ReverbOrder >= 0)
+        return FMath::Min<IPLint32>(ReverbOrder, Order);
+
+    return Order;
+}
+
+/** Returns a description of the bake settings that affect baked data. */
+static FString GetBakeParamsString(const IPLReflectionsBakeParams& ReflectionsBakeParams, const IPLPathBakeParams& PathBakeParams)
+{
+    FString Inputs = FString::Printf(TEXT("%d %d %d %f %f %d %f %d %d"), ReflectionsBakeParams.numRays, ReflectionsBakeParams.numDiffuseSamples,
+        ReflectionsBakeParams.numBounces, ReflectionsBakeParams.simulatedDuration, ReflectionsBakeParams.savedDuration, ReflectionsBakeParams.order,
+        ReflectionsBakeParams.irradianceMinDistance, static_cast<int>(ReflectionsBakeParams.bakeFlags),
+        static_cast<int>(ReflectionsBakeParams.sceneType));
+
+    Inputs += FString::Printf(TEXT(" %d %f %f %f %f"), PathBakeParams.numSamples, PathBakeParams.radius, PathBakeParams.threshold,
+        PathBakeParams.visRange, PathBakeParams.pathRange);
+
+    return Inputs;
+}
+
+/** Returns a description of a task, including the layer it bakes and the order at which it's baked. */
+static FString GetBakeTaskString(const FBakeTask& Task, IPLint32 Order)
+{
+    IPLBakedDataIdentifier Identifier = GetBakedDataIdentifier(Task);
+    return FString::Printf(TEXT(" %s %s %d %d %f %f %f %f %d"), *Task.GetLayerName(), Task.ProbeVolume ? *Task.ProbeVolume->GetName() : TEXT("*"), static_cast<int>(Identifier.type), static_cast<int>(Identifier.variation),
+        Identifier.endpointInfluence.center.x, Identifier.endpointInfluence.center.y, Identifier.endpointInfluence.center.z,
+        Identifier.endpointInfluence.radius, GetBakedOrder(Task, Order));
+}
+
+/** Returns a key that identifies the inputs to a bake, so a bake only resumes from one that used the same geometry,
+    settings, and tasks. */
+static FString GetBakeKey(const FSoftObjectPath& GeometryAsset, const IPLReflectionsBakeParams& ReflectionsBakeParams,
+    const IPLPathBakeParams& PathBakeParams, const TArray<FBakeTask>& Tasks)
+{
+    FString GeometryFileName = FPackageName::LongPackageNameToFilename(GeometryAsset.GetLongPackageName(), FPackageName::GetAssetPackageExtension());
+
+    FString Inputs = FString::Printf(TEXT("%s %s "), *GeometryAsset.GetAssetPathString(), *IFileManager::Get().GetTimeStamp(*GeometryFileName).ToString());
+    Inputs += GetBakeParamsString(ReflectionsBakeParams, PathBakeParams);
+
+    for (const FBakeTask& Task : Tasks)
+    {
+        Inputs += GetBakeTaskString(Task, ReflectionsBakeParams.order);
+    }
+
+    return FString::Printf(TEXT("%08X"), FCrc::StrCrc32(*Inputs));
+}
+
+/** Returns true if one of a probe volume's tasks bakes the layer with the given name. */
+static bool IsLayerBakedByShard(const FBakeShard& Shard, const FString& LayerName)
+{
+    return Shard.Tasks.ContainsByPredicate([&](const FBakeTask* Task)
+    {
+        return Task->GetLayerName() == LayerName;
+    });
+}
+
+/** Returns the key under which a probe volume's bake is stored in the bake cache, or an empty string if it can't be
+    cached. Runs on a worker thread. */
+static FString GetBakeCacheKey(const FBakeCache& Cache, const FBakeShard& Shard, const IPLReflectionsBakeParams& ReflectionsBakeParams,
+    const IPLPathBakeParams& PathBakeParams)
+{
+    USteamAudioProbeComponent* ProbeComponent = Shard.ProbeVolume->ProbeComponent;
+    if (!Cache.IsEnabled() || !ProbeComponent)
+        return FString();
+
+    FString Inputs = GetBakeParamsString(ReflectionsBakeParams, PathBakeParams);
+    for (const FBakeTask* Task : Shard.Tasks)
+    {
+        Inputs += GetBakeTaskString(*Task, ReflectionsBakeParams.order);
+    }
+
+    // A cached probe batch replaces the probe volume's whole asset, including the layers that aren't being baked, so
+    // it can only be restored into a probe volume that has the same other layers as the one it was cached from.
+    Inputs += SteamAudio::RunInGameThread<FString>([&]()
+    {
+        TArray<FString> OtherLayers;
+        for (const FSteamAudioBakedDataInfo& Info : Shard.ProbeVolume->DetailedStats)
+        {
+            if (!IsLayerBakedByShard(Shard, Info.Name))
+            {
+                OtherLayers.Add(FString::Printf(TEXT(" %s %d %d %f %f %f %f %d %u"), *Info.Name, Info.Type, Info.Variation, Info.EndpointCenter.X,
+                    Info.EndpointCenter.Y, Info.EndpointCenter.Z, Info.EndpointRadius, Info.Size, Info.GeometryHash));
+            }
+        }
+
+        OtherLayers.Sort();
+        return FString::Join(OtherLayers, TEXT(""));
+    });
+
+    FScopeLock Lock(&ProbeComponent->ProbePositionsCriticalSection);
+    if (ProbeComponent->ProbePositions.Num() == 0)
+        return FString();
+
+    return Cache.GetKey(ProbeComponent->ProbePositions, Inputs);
+}
+
+/** Returns a digest of the serialized geometry being baked against, or an empty string if it can't be serialized. */
+static FString GetSceneDigest(IPLContext Context, IPLStaticMesh StaticMesh)
+{
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    IPLSerializedObject SerializedObject = nullptr;
+    if (iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject) != IPL_STATUS_SUCCESS)
+        return FString();
+
+    iplStaticMeshSave(StaticMesh, SerializedObject);
+
+    FSHAHash Hash;
+    FSHA1::HashBuffer(iplSerializedObjectGetData(SerializedObject), iplSerializedObjectGetSize(SerializedObject), Hash.Hash);
+
+    iplSerializedObjectRelease(&SerializedObject);
+    return Hash.ToString();
+}
+
+/** Returns the name under which a task is recorded in the bake manifest once its layer has been checkpointed. */
+static FString GetCheckpointName(const FBakeShard& Shard, const FBakeTask& Task)
+{
+    return Shard.Name + TEXT("|") + Task.GetLayerName();
+}
+
+/** Serializes a probe batch and saves it to a probe volume's asset. Returns the serialized object, which must be
+    released by the caller, or nullptr if the probe batch couldn't be saved. Runs on a worker thread. */
+static IPLSerializedObject SaveProbeBatch(ASteamAudioProbeVolume* ProbeVolume, IPLContext Context, IPLProbeBatch ProbeBatch)
+{
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+
+    IPLSerializedObject SerializedObject = nullptr;
+    IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to create serialized object. [%d]"), Status);
+        return nullptr;
+    }
+
+    iplProbeBatchSave(ProbeBatch, SerializedObject);
+
+    bool bSaved = SteamAudio::RunInGameThread<bool>([&]()
+    {
+        ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString(), ProbeVolume->DetailedStats);
+        ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
+        ProbeVolume->MarkPackageDirty();
+        return ProbeVolume->Asset.IsValid();
+    });
+    if (!bSaved)
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to save probe batch for probe volume: %s"), *ProbeVolume->GetName());
+        iplSerializedObjectRelease(&SerializedObject);
+        return nullptr;
+    }
+
+    return SerializedObject;
+}
+
+/** Logs a task's telemetry, and adds it to the probe volume's report. */
+static void ReportTask(FBakeShard& Shard, FBakeTaskReport& TaskReport)
+{
+    FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    TaskReport.PeakUsedPhysical = MemoryStats.PeakUsedPhysical;
+    int NumCPUTimeSamples = Shard.NumCPUTimeSamples.exchange(0);
+    int64 CPUTimeSum = Shard.CPUTimeSum.exchange(0);
+    TaskReport.CPUUtilization = (NumCPUTimeSamples > 0) ? CPUTimeSum / (100.0f * NumCPUTimeSamples) : 0.0f;
+
+    UE_LOG(LogSteamAudioEditor, Log, TEXT("Baked layer %s in probe volume %s: %.1f s, %.1f probes/s, %.3g rays/s, %d threads, %.0f%% CPU, %.1f MB peak memory%s."),
+        *TaskReport.LayerName, *Shard.ProbeVolume->GetName(), TaskReport.Time, TaskReport.GetProbesPerSecond(), TaskReport.GetRaysPerSecond(),
+        TaskReport.NumThreads, TaskReport.CPUUtilization, TaskReport.PeakUsedPhysical / (1024.0 * 1024.0),
+        TaskReport.bRestored ? TEXT(" (restored from checkpoint)") : TEXT(""));
+
+    Shard.Report.Tasks.Add(TaskReport);
+}
+
+/** Bakes all tasks for a probe volume, and saves its probe batch. Tasks checkpointed by an earlier, interrupted bake
+    are skipped. Baked layers are checkpointed periodically, so an interrupted bake can resume from the last
+    checkpoint. If CacheKey isn't empty, a fully baked probe batch is also stored in the bake cache. Runs on a worker
+    thread. */
+static void BakeShard(FBakeShard& Shard, IPLContext Context, IPLReflectionsBakeParams ReflectionsBakeParams, IPLPathBakeParams PathBakeParams,
+    FBakeManifest& Manifest, const FBakeCache& Cache, const FString& CacheKey)
+{
+    ASteamAudioProbeVolume* ProbeVolume = Shard.ProbeVolume;
+
+    IPLProbeBatch ProbeBatch = SteamAudio::RunInGameThread<IPLProbeBatch>([&]()
+    {
+        return SteamAudio::LoadProbeBatchFromAsset(ProbeVolume->Asset, Context);
+    });
+    if (!ProbeBatch)
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to load probe batch: %s"), *ProbeVolume->Asset.GetAssetPathString());
+        return;
+    }
+
+    ReflectionsBakeParams.probeBatch = ProbeBatch;
+    PathBakeParams.probeBatch = ProbeBatch;
+
+    const IPLint32 Order = ReflectionsBakeParams.order;
+
+    Shard.Report.NumProbes = iplProbeBatchGetNumProbes(ProbeBatch);
+
+    const float CheckpointInterval = GetDefault<USteamAudioSettings>()->BakingCheckpointInterval;
+    double LastCheckpointTime = FPlatformTime::Seconds();
+    TArray<FString> PendingCheckpoints;
+
+    for (const FBakeTask* Task : Shard.Tasks)
+    {
+        if (!GIsBaking)
+            break;
+
+        IPLBakedDataIdentifier Identifier = GetBakedDataIdentifier(*Task);
+        FString LayerName = Task->GetLayerName();
+        FString CheckpointName = GetCheckpointName(Shard, *Task);
+
+        FBakeTaskReport TaskReport;
+        TaskReport.LayerName = LayerName;
+        TaskReport.Type = Task->Type;
+        TaskReport.NumProbes = Shard.Report.NumProbes;
+
+        if (Manifest.IsCompleted(CheckpointName) && iplProbeBatchGetDataSize(ProbeBatch, &Identifier) > 0)
+        {
+            TaskReport.bRestored = true;
+        }
+        else
+        {
+            double StartTime = FPlatformTime::Seconds();
+
+            if (Task->Type == EBakeTaskType::PATHING)
+            {
+                PathBakeParams.identifier = Identifier;
+                iplPathBakerBake(Context, &PathBakeParams, BakeProgressCallback, &Shard);
+
+                TaskReport.Time = FPlatformTime::Seconds() - StartTime;
+                TaskReport.NumThreads = PathBakeParams.numThreads;
+                Shard.Report.PathingTime += TaskReport.Time;
+            }
+            else
+            {
+                ReflectionsBakeParams.identifier = Identifier;
+                ReflectionsBakeParams.order = GetBakedOrder(*Task, Order);
+                iplReflectionsBakerBake(Context, &ReflectionsBakeParams, BakeProgressCallback, &Shard);
+
+                TaskReport.Time = FPlatformTime::Seconds() - StartTime;
+                TaskReport.NumThreads = ReflectionsBakeParams.numThreads;
+                TaskReport.NumRaysEstimated = static_cast<int64>(Shard.Report.NumProbes) * ReflectionsBakeParams.numRays * ReflectionsBakeParams.numBounces;
+                Shard.Report.ReflectionsTime += TaskReport.Time;
+                Shard.Report.NumRaysEstimated += TaskReport.NumRaysEstimated;
+            }
+
+            // A task that was cancelled partway through has incomplete data, so it's never checkpointed.
+            if (GIsBaking)
+            {
+                PendingCheckpoints.Add(CheckpointName);
+            }
+        }
+
+        int LayerSize = iplProbeBatchGetDataSize(ProbeBatch, &Identifier);
+
+        SteamAudio::RunInGameThread<void>([&]()
+        {
+            ProbeVolume->AddOrUpdateLayer(LayerName, Identifier, LayerSize, Shard.GeometryHash);
+        });
+
+        ReportTask(Shard, TaskReport);
+
+        Shard.NumTasksSucceeded++;
+        Shard.TaskProgress = 0.0f;
+        Shard.NumTasksCompleted++;
+
+        // The last task is saved below, along with the rest of the probe batch.
+        bool bIsLastTask = (Shard.NumTasksCompleted == Shard.Tasks.Num());
+        if (CheckpointInterval > 0.0f && !bIsLastTask && PendingCheckpoints.Num() > 0 &&
+            FPlatformTime::Seconds() - LastCheckpointTime >= CheckpointInterval)
+        {
+            IPLSerializedObject SerializedObject = SaveProbeBatch(ProbeVolume, Context, ProbeBatch);
+            if (SerializedObject)
+            {
+                for (const FString& PendingCheckpoint : PendingCheckpoints)
+                {
+                    Manifest.MarkCompleted(PendingCheckpoint);
+                }
+
+                PendingCheckpoints.Empty();
+                iplSerializedObjectRelease(&SerializedObject);
+            }
+
+            LastCheckpointTime = FPlatformTime::Seconds();
+        }
+    }
+
+    // Bakes cancelled partway through still have their results saved, but aren't considered complete.
+    bool bAllTasksBaked = GIsBaking && Shard.NumTasksSucceeded == Shard.Tasks.Num();
+
+    IPLSerializedObject SerializedObject = SaveProbeBatch(ProbeVolume, Context, ProbeBatch);
+    if (!SerializedObject)
+    {
+        Shard.NumTasksSucceeded = 0;
+        iplProbeBatchRelease(&ProbeBatch);
+        return;
+    }
+
+    // Layers baked since the last checkpoint are now saved, so they can be checkpointed even if the bake was
+    // cancelled before all of them were baked.
+    for (const FString& PendingCheckpoint : PendingCheckpoints)
+    {
+        Manifest.MarkCompleted(PendingCheckpoint);
+    }
+
+    if (bAllTasksBaked && !CacheKey.IsEmpty())
+    {
+        Cache.Store(CacheKey, iplSerializedObjectGetData(SerializedObject), iplSerializedObjectGetSize(SerializedObject));
+    }
+
+    iplSerializedObjectRelease(&SerializedObject);
+    iplProbeBatchRelease(&ProbeBatch);
 
-static void CancelBake()
+    Shard.bSucceeded = bAllTasksBaked;
+}
+
+/** Finds the size of each layer baked by a probe volume's tasks in a probe batch. Returns false if any of them is
+    missing. */
+static bool GetBakedLayerSizes(const FBakeShard& Shard, IPLProbeBatch ProbeBatch, TArray<TPair<FString, IPLBakedDataIdentifier>>& OutLayers,
+    TArray<int>& OutLayerSizes)
 {
-    IPLContext Context = SteamAudio::FSteamAudioModule::GetManager().GetContext();
+    for (const FBakeTask* Task : Shard.Tasks)
+    {
+        IPLBakedDataIdentifier Identifier = GetBakedDataIdentifier(*Task);
+        int LayerSize = iplProbeBatchGetDataSize(ProbeBatch, &Identifier);
+        if (LayerSize <= 0)
+            return false;
 
-    iplReflectionsBakerCancelBake(Context);
-    iplPathBakerCancelBake(Context);
+        OutLayers.Add(TPair<FString, IPLBakedDataIdentifier>(Task->GetLayerName(), Identifier));
+        OutLayerSizes.Add(LayerSize);
+    }
 
-    GIsBaking = false;
+    return true;
 }
 
-static void STDCALL BakeProgressCallback(float Progress, void* UserData)
+/** Restores the layers of a probe volume that was baked by an earlier, interrupted bake, since the level may not have
+    been saved since. Returns false if any of the baked data is missing from the probe batch, in which case the probe
+    volume must be baked again. Runs on a worker thread. */
+static bool RestoreShard(FBakeShard& Shard, IPLContext Context)
+{
+    ASteamAudioProbeVolume* ProbeVolume = Shard.ProbeVolume;
+
+    IPLProbeBatch ProbeBatch = SteamAudio::RunInGameThread<IPLProbeBatch>([&]()
+    {
+        return SteamAudio::LoadProbeBatchFromAsset(ProbeVolume->Asset, Context);
+    });
+    if (!ProbeBatch)
+        return false;
+
+    Shard.Report.NumProbes = iplProbeBatchGetNumProbes(ProbeBatch);
+
+    TArray<TPair<FString, IPLBakedDataIdentifier>> Layers;
+    TArray<int> LayerSizes;
+    bool bAllLayersFound = GetBakedLayerSizes(Shard, ProbeBatch, Layers, LayerSizes);
+
+    iplProbeBatchRelease(&ProbeBatch);
+
+    if (!bAllLayersFound)
+        return false;
+
+    SteamAudio::RunInGameThread<void>([&]()
+    {
+        for (int i = 0; i < Layers.Num(); ++i)
+        {
+            ProbeVolume->AddOrUpdateLayer(Layers[i].Key, Layers[i].Value, LayerSizes[i], Shard.GeometryHash);
+        }
+    });
+
+    Shard.NumTasksSucceeded = Shard.Tasks.Num();
+    Shard.bSucceeded = true;
+    Shard.Report.bResumed = true;
+    return true;
+}
+
+/** Restores a probe volume from the bake cache, saving the cached probe batch to the probe volume's asset, and updates
+    the stats of every layer from it. Returns false if there is no usable cached bake, in which case the probe volume
+    must be baked. Runs on a worker thread. */
+static bool RestoreShardFromCache(FBakeShard& Shard, IPLContext Context, const FBakeCache& Cache, const FString& CacheKey)
+{
+    ASteamAudioProbeVolume* ProbeVolume = Shard.ProbeVolume;
+
+    TArray<uint8> Data;
+    if (!Cache.Load(CacheKey, Data))
+        return false;
+
+    IPLSerializedObjectSettings SerializedObjectSettings{};
+    SerializedObjectSettings.data = Data.GetData();
+    SerializedObjectSettings.size = Data.Num();
+
+    IPLSerializedObject SerializedObject = nullptr;
+    if (iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject) != IPL_STATUS_SUCCESS)
+        return false;
+
+    IPLProbeBatch ProbeBatch = nullptr;
+    if (iplProbeBatchLoad(Context, SerializedObject, &ProbeBatch) != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to load cached bake for probe volume %s, it will be baked again."), *ProbeVolume->GetName());
+        iplSerializedObjectRelease(&SerializedObject);
+        return false;
+    }
+
+    int NumProbes = iplProbeBatchGetNumProbes(ProbeBatch);
+
+    TArray<TPair<FString, IPLBakedDataIdentifier>> Layers;
+    TArray<int> LayerSizes;
+    bool bAllLayersFound = GetBakedLayerSizes(Shard, ProbeBatch, Layers, LayerSizes);
+
+    // The probe volume's other layers are replaced by the ones in the cached probe batch. The cache key ensures it had
+    // the same other layers, but their stats are rebuilt from the probe batch, in case any of them were missing.
+    TArray<FSteamAudioBakedDataInfo> OtherLayers = SteamAudio::RunInGameThread<TArray<FSteamAudioBakedDataInfo>>([&]()
+    {
+        return ProbeVolume->DetailedStats.FilterByPredicate([&](const FSteamAudioBakedDataInfo& Info)
+        {
+            return !IsLayerBakedByShard(Shard, Info.Name);
+        });
+    });
+
+    for (FSteamAudioBakedDataInfo& Info : OtherLayers)
+    {
+        IPLBakedDataIdentifier Identifier = Info.GetIdentifier();
+        Info.Size = iplProbeBatchGetDataSize(ProbeBatch, &Identifier);
+    }
+
+    iplProbeBatchRelease(&ProbeBatch);
+
+    if (!bAllLayersFound)
+    {
+        iplSerializedObjectRelease(&SerializedObject);
+        return false;
+    }
+
+    bool bSaved = SteamAudio::RunInGameThread<bool>([&]()
+    {
+        for (int i = 0; i < Layers.Num(); ++i)
+        {
+            ProbeVolume->AddOrUpdateLayer(Layers[i].Key, Layers[i].Value, LayerSizes[i], Shard.GeometryHash);
+        }
+        for (const FSteamAudioBakedDataInfo& Info : OtherLayers)
+        {
+            if (Info.Size > 0)
+            {
+                IPLBakedDataIdentifier Identifier = Info.GetIdentifier();
+                ProbeVolume->AddOrUpdateLayer(Info.Name, Identifier, Info.Size, Info.GeometryHash);
+            }
+            else
+            {
+                ProbeVolume->RemoveLayer(Info.Name);
+            }
+        }
+        ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString(), ProbeVolume->DetailedStats);
+        ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
+        ProbeVolume->MarkPackageDirty();
+        return ProbeVolume->Asset.IsValid();
+    });
+
+    iplSerializedObjectRelease(&SerializedObject);
+
+    if (!bSaved)
+        return false;
+
+    Shard.Report.NumProbes = NumProbes;
+    Shard.NumTasksSucceeded = Shard.Tasks.Num();
+    Shard.bSucceeded = true;
+    Shard.Report.bCached = true;
+    return true;
+}
+
+static const TCHAR* GetBakeTaskTypeName(EBakeTaskType Type)
+{
+    switch (Type)
+    {
+    case EBakeTaskType::STATIC_SOURCE_REFLECTIONS:
+        return TEXT("StaticSource");
+    case EBakeTaskType::STATIC_LISTENER_REFLECTIONS:
+        return TEXT("StaticListener");
+    case EBakeTaskType::REVERB:
+        return TEXT("Reverb");
+    case EBakeTaskType::PATHING:
+        return TEXT("Pathing");
+    default:
+        return TEXT("Unknown");
+    }
+}
+
+/** Writes the telemetry for each task in a bake to a CSV file, one row per task. */
+static void WriteBakeTelemetry(const FString& FileName, const FBakeReport& Report)
 {
-    FSteamAudioEditorModule::NotifyUpdate(FText::FormatOrdered(NSLOCTEXT("SteamAudio", "BakeProgress", "Probe Volume {0}/{1}\nTask {2}/{3}\nBaking ({4})..."),
-        FText::AsNumber(GCurrentProbeVolume), FText::AsNumber(GNumProbeVolumes),
-        FText::AsNumber(GCurrentBakeTask), FText::AsNumber(GNumBakeTasks),
-        FText::AsPercent(Progress)));
+    TArray<FString> Lines;
+    Lines.Add(TEXT("ProbeVolume,Layer,Type,Restored,Probes,Seconds,ProbesPerSecond,EstimatedRays,EstimatedRaysPerSecond,Threads,CPUUtilizationPercent,PeakMemoryMB"));
+
+    for (const FBakeProbeVolumeReport& ProbeVolume : Report.ProbeVolumes)
+    {
+        for (const FBakeTaskReport& Task : ProbeVolume.Tasks)
+        {
+            Lines.Add(FString::Printf(TEXT("\"%s\",\"%s\",%s,%d,%d,%.3f,%.3f,%lld,%.0f,%d,%.1f,%.1f"), *ProbeVolume.Name, *Task.LayerName,
+                GetBakeTaskTypeName(Task.Type), Task.bRestored ? 1 : 0, Task.NumProbes, Task.Time, Task.GetProbesPerSecond(),
+                Task.NumRaysEstimated, Task.GetRaysPerSecond(), Task.NumThreads, Task.CPUUtilization, Task.PeakUsedPhysical / (1024.0 * 1024.0)));
+        }
+    }
+
+    if (!FFileHelper::SaveStringArrayToFile(Lines, *FileName))
+    {
+        UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to save bake telemetry: %s"), *FileName);
+    }
 }
 
-static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, const TArray<AActor*>& ProbeVolumes, const TArray<FBakeTask>& Tasks)
+static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, const TArray<AActor*>& ProbeVolumes, const TArray<FBakeTask>& Tasks,
+    const FString& ManifestBasePath, const FString& ShardName, FBakeReport& OutReport)
 {
     TPromise<int> Promise;
 
-    Async(EAsyncExecution::Thread, [StaticMeshActor, ProbeVolumes, Tasks, &Promise]()
+    OutReport = FBakeReport();
+    double StartTime = FPlatformTime::Seconds();
+
+    // Each probe volume gets the tasks that apply to it.
+    GBakeShards.Empty();
+    GNumProbeVolumesBaked = 0;
+
+    int NumTasksTotal = 0;
+    for (AActor* Actor : ProbeVolumes)
     {
-        int NumBakesSucceeded = 0;
+        ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
+        if (!ProbeVolume || !ProbeVolume->Asset.IsValid())
+        {
+            UE_LOG(LogSteamAudioEditor, Warning, TEXT("No probes generated in probe volume, skipping."));
+            continue;
+        }
+
+        TUniquePtr<FBakeShard> Shard = MakeUnique<FBakeShard>();
+        Shard->ProbeVolume = ProbeVolume;
+        Shard->Name = ProbeVolume->GetPathName();
+        Shard->GeometryHash = GetGeometryHashForProbeVolume(StaticMeshActor, ProbeVolume);
+
+        for (const FBakeTask& Task : Tasks)
+        {
+            if (!DoesTaskApplyToProbeVolume(Task, ProbeVolume))
+                continue;
+
+            Shard->Tasks.Add(&Task);
+        }
+
+        if (Shard->Tasks.Num() > 0)
+        {
+            NumTasksTotal += Shard->Tasks.Num();
+            GBakeShards.Add(MoveTemp(Shard));
+        }
+    }
+
+    if (GBakeShards.Num() == 0)
+        return EBakeResult::FAILURE;
 
+    Async(EAsyncExecution::Thread, [StaticMeshActor, Tasks, ManifestBasePath, ShardName, &OutReport, &Promise]()
+    {
 		SteamAudio::FSteamAudioManager& Manager = SteamAudio::FSteamAudioModule::GetManager();
         bool bInitializeSucceeded = SteamAudio::RunInGameThread<bool>([&]()
         {
@@ -101,172 +982,138 @@ static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, con
 		IPLContext Context = Manager.GetContext();
 		IPLScene Scene = Manager.GetScene();
 
+        FSoftObjectPath GeometryAsset = GetBakeGeometryAsset(StaticMeshActor);
+
         IPLStaticMesh StaticMesh = SteamAudio::RunInGameThread<IPLStaticMesh>([&]()
         {
-            return SteamAudio::LoadStaticMeshFromAsset(StaticMeshActor->Asset, Context, Scene);
+            return SteamAudio::LoadStaticMeshFromAsset(GeometryAsset, Context, Scene);
         });
         if (!StaticMesh)
         {
-            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load static mesh asset: %s"), *StaticMeshActor->Asset.GetAssetPathString());
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load static mesh asset: %s"), *GeometryAsset.GetAssetPathString());
             Manager.ShutDownSteamAudio();
             Promise.SetValue(0);
             return;
         }
 
+        // The scene is committed once, and shared by all probe volumes.
         iplStaticMeshAdd(StaticMesh, Scene);
         iplSceneCommit(Scene);
 
+        FString BakeCacheDirectory;
+        if (GetDefault<USteamAudioSettings>()->bEnableBakeCache)
+        {
+            BakeCacheDirectory = GetDefault<USteamAudioSettings>()->BakeCacheDirectory;
+            if (BakeCacheDirectory.IsEmpty())
+            {
+                BakeCacheDirectory = FPaths::ProjectSavedDir() / TEXT("SteamAudio") / TEXT("BakeCache");
+            }
+        }
+
+        FBakeCache Cache(BakeCacheDirectory, BakeCacheDirectory.IsEmpty() ? FString() : GetSceneDigest(Context, StaticMesh));
+
         IPLSimulationSettings SimulationSettings = Manager.GetBakingSettings(static_cast<IPLSimulationFlags>(IPL_SIMULATIONFLAGS_REFLECTIONS | IPL_SIMULATIONFLAGS_PATHING));
 
         IPLReflectionsBakeParams ReflectionsBakeParams{};
-        ReflectionsBakeParams.scene = Scene;
-        ReflectionsBakeParams.sceneType = SimulationSettings.sceneType;
-        ReflectionsBakeParams.numRays = SimulationSettings.maxNumRays;
-        ReflectionsBakeParams.numDiffuseSamples = SimulationSettings.numDiffuseSamples;
-        ReflectionsBakeParams.numBounces = GetDefault<USteamAudioSettings>()->BakingBounces;
-        ReflectionsBakeParams.simulatedDuration = SimulationSettings.maxDuration;
-        ReflectionsBakeParams.savedDuration = SimulationSettings.maxDuration;
-        ReflectionsBakeParams.order = SimulationSettings.maxOrder;
-        ReflectionsBakeParams.numThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakingCPUCoresPercentage);
-        ReflectionsBakeParams.rayBatchSize = 1;
-        ReflectionsBakeParams.irradianceMinDistance = GetDefault<USteamAudioSettings>()->BakingIrradianceMinDistance;
-        ReflectionsBakeParams.bakeBatchSize = (SimulationSettings.sceneType == IPL_SCENETYPE_RADEONRAYS) ? GetDefault<USteamAudioSettings>()->BakingBatchSize : 1;
-        ReflectionsBakeParams.openCLDevice = SimulationSettings.openCLDevice;
-        ReflectionsBakeParams.radeonRaysDevice = SimulationSettings.radeonRaysDevice;
+        IPLPathBakeParams PathBakeParams{};
+        GetBakeParams(Scene, SimulationSettings, ReflectionsBakeParams, PathBakeParams);
 
-        if (GetDefault<USteamAudioSettings>()->bBakeConvolution)
-        {
-            ReflectionsBakeParams.bakeFlags = static_cast<IPLReflectionsBakeFlags>(ReflectionsBakeParams.bakeFlags | IPL_REFLECTIONSBAKEFLAGS_BAKECONVOLUTION);
-        }
-        if (GetDefault<USteamAudioSettings>()->bBakeParametric)
-        {
-            ReflectionsBakeParams.bakeFlags = static_cast<IPLReflectionsBakeFlags>(ReflectionsBakeParams.bakeFlags | IPL_REFLECTIONSBAKEFLAGS_BAKEPARAMETRIC);
-        }
+        // Skip probe volumes that were already baked by an earlier bake of the same inputs that didn't finish.
+        FBakeManifest Manifest(ManifestBasePath, ShardName, GetBakeKey(GeometryAsset, ReflectionsBakeParams, PathBakeParams, Tasks));
 
-        IPLPathBakeParams PathBakeParams{};
-        PathBakeParams.scene = Scene;
-        PathBakeParams.numSamples = SimulationSettings.numVisSamples;
-        PathBakeParams.radius = GetDefault<USteamAudioSettings>()->BakingVisibilityRadius;
-        PathBakeParams.threshold = GetDefault<USteamAudioSettings>()->BakingVisibilityThreshold;
-        PathBakeParams.visRange = GetDefault<USteamAudioSettings>()->BakingVisibilityRange;
-        PathBakeParams.pathRange = GetDefault<USteamAudioSettings>()->BakingPathRange;
-        PathBakeParams.numThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakedPathingCPUCoresPercentage);
-
-        for (AActor* Actor : ProbeVolumes)
-        {
-            ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
-            if (!ProbeVolume || !ProbeVolume->Asset.IsValid())
+        TArray<FBakeShard*> ShardsToBake;
+        for (const TUniquePtr<FBakeShard>& Shard : GBakeShards)
+        {
+            if (Manifest.IsCompleted(Shard->Name) && RestoreShard(*Shard, Context))
             {
-                UE_LOG(LogSteamAudioEditor, Warning, TEXT("No probes generated in probe volume, skipping."));
-                GCurrentProbeVolume++;
+                UE_LOG(LogSteamAudioEditor, Log, TEXT("Probe volume %s was baked by an earlier bake, skipping."), *Shard->ProbeVolume->GetName());
+                Shard->NumTasksCompleted = Shard->Tasks.Num();
+                GNumProbeVolumesBaked++;
                 continue;
             }
 
-            IPLProbeBatch ProbeBatch = SteamAudio::RunInGameThread<IPLProbeBatch>([&]()
-            {
-                return SteamAudio::LoadProbeBatchFromAsset(ProbeVolume->Asset, Context);
-            });
-            if (!ProbeBatch)
-            {
-                UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to load probe batch: %s"), *ProbeVolume->Asset.GetAssetPathString());
-                GCurrentProbeVolume++;
-                continue;
-            }
+            ShardsToBake.Add(Shard.Get());
+        }
+
+        // Bake several probe volumes at once, splitting the threads between them. With Radeon Rays, probes are already
+        // batched on the GPU, so probe volumes are baked one at a time.
+        int NumParallelShards = GetDefault<USteamAudioSettings>()->BakingMaxParallelProbeVolumes;
+        if (NumParallelShards <= 0)
+        {
+            NumParallelShards = FMath::Max(ReflectionsBakeParams.numThreads, PathBakeParams.numThreads) / MinThreadsPerProbeVolume;
+        }
+        if (SimulationSettings.sceneType == IPL_SCENETYPE_RADEONRAYS)
+        {
+            NumParallelShards = 1;
+        }
+        NumParallelShards = FMath::Clamp(NumParallelShards, 1, FMath::Max(ShardsToBake.Num(), 1));
 
-            ReflectionsBakeParams.probeBatch = ProbeBatch;
-            PathBakeParams.probeBatch = ProbeBatch;
+        ReflectionsBakeParams.numThreads = FMath::Max(ReflectionsBakeParams.numThreads / NumParallelShards, 1);
+        PathBakeParams.numThreads = FMath::Max(PathBakeParams.numThreads / NumParallelShards, 1);
 
-            int NumBakesSucceededForProbeBatch = 0;
+        OutReport.NumParallelProbeVolumes = NumParallelShards;
+        OutReport.NumReflectionsThreads = ReflectionsBakeParams.numThreads;
+        OutReport.NumPathingThreads = PathBakeParams.numThreads;
 
-            for (const FBakeTask& Task : Tasks)
+        std::atomic<int> NextShard(0);
+        TArray<TFuture<void>> Workers;
+
+        for (int i = 0; i < NumParallelShards; ++i)
+        {
+            Workers.Add(Async(EAsyncExecution::Thread, [&]()
             {
-                if (Task.Type == EBakeTaskType::PATHING && Task.PathingProbeVolume != ProbeVolume)
+                for (int Index = NextShard++; Index < ShardsToBake.Num() && GIsBaking; Index = NextShard++)
                 {
-                    GCurrentBakeTask++;
-                    continue;
-                }
+                    FBakeShard& Shard = *ShardsToBake[Index];
 
-                if (Task.Type == EBakeTaskType::PATHING)
-                {
-                    PathBakeParams.identifier.type = IPL_BAKEDDATATYPE_PATHING;
-                    PathBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_DYNAMIC;
-                }
-                else
-                {
-                    ReflectionsBakeParams.identifier.type = IPL_BAKEDDATATYPE_REFLECTIONS;
-                    if (Task.Type == EBakeTaskType::STATIC_SOURCE_REFLECTIONS)
+                    FString CacheKey = GetBakeCacheKey(Cache, Shard, ReflectionsBakeParams, PathBakeParams);
+                    if (!CacheKey.IsEmpty() && RestoreShardFromCache(Shard, Context, Cache, CacheKey))
                     {
-                        ReflectionsBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_STATICSOURCE;
+                        Manifest.MarkCompleted(Shard.Name);
 
-                        if (Task.BakedSource)
-                        {
-                            ReflectionsBakeParams.identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedSource->GetOwner()->GetTransform().GetLocation());
-                            ReflectionsBakeParams.identifier.endpointInfluence.radius = Task.BakedSource->InfluenceRadius;
-                        }
+                        UE_LOG(LogSteamAudioEditor, Log, TEXT("Probe volume %s was restored from the bake cache."), *Shard.ProbeVolume->GetName());
                     }
-                    else if (Task.Type == EBakeTaskType::STATIC_LISTENER_REFLECTIONS)
+                    else
                     {
-                        ReflectionsBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_STATICLISTENER;
+                        BakeShard(Shard, Context, ReflectionsBakeParams, PathBakeParams, Manifest, Cache, CacheKey);
 
-                        if (Task.BakedListener)
+                        if (Shard.bSucceeded)
                         {
-                            ReflectionsBakeParams.identifier.endpointInfluence.center = SteamAudio::ConvertVector(Task.BakedListener->GetOwner()->GetTransform().GetLocation());
-                            ReflectionsBakeParams.identifier.endpointInfluence.radius = Task.BakedListener->InfluenceRadius;
+                            Manifest.MarkCompleted(Shard.Name);
+
+                            UE_LOG(LogSteamAudioEditor, Log, TEXT("Baked probe volume %s (%d probes) in %.1f s."), *Shard.ProbeVolume->GetName(),
+                                Shard.Report.NumProbes, Shard.Report.ReflectionsTime + Shard.Report.PathingTime);
+                        }
+                        else
+                        {
+                            UE_LOG(LogSteamAudioEditor, Warning, TEXT("Probe volume %s was not fully baked; it will be baked again by the next bake."), *Shard.ProbeVolume->GetName());
                         }
                     }
-                    else if (Task.Type == EBakeTaskType::REVERB)
-                    {
-                        ReflectionsBakeParams.identifier.variation = IPL_BAKEDDATAVARIATION_REVERB;
-                    }
-                }
 
-                if (Task.Type == EBakeTaskType::PATHING)
-                {
-                    iplPathBakerBake(Context, &PathBakeParams, BakeProgressCallback, nullptr);
+                    Shard.NumTasksCompleted = Shard.Tasks.Num();
+                    GNumProbeVolumesBaked++;
                 }
-                else
-                {
-                    iplReflectionsBakerBake(Context, &ReflectionsBakeParams, BakeProgressCallback, nullptr);
-                }
-
-                IPLBakedDataIdentifier& Identifier = (Task.Type == EBakeTaskType::PATHING) ? PathBakeParams.identifier : ReflectionsBakeParams.identifier;
-                FString LayerName = Task.GetLayerName();
-                int LayerSize = iplProbeBatchGetDataSize(ProbeBatch, &Identifier);
-
-                SteamAudio::RunInGameThread<void>([&]()
-                {
-                    ProbeVolume->AddOrUpdateLayer(LayerName, Identifier, LayerSize);
-                });
-
-                NumBakesSucceededForProbeBatch++;
-                GCurrentBakeTask++;
-            }
-
-            IPLSerializedObjectSettings SerializedObjectSettings{};
-
-            IPLSerializedObject SerializedObject = nullptr;
-            IPLerror Status = iplSerializedObjectCreate(Context, &SerializedObjectSettings, &SerializedObject);
-            if (Status != IPL_STATUS_SUCCESS)
-            {
-                UE_LOG(LogSteamAudioEditor, Warning, TEXT("Unable to create serialized object. [%d]"), Status);
-                iplProbeBatchRelease(&ProbeBatch);
-                GCurrentProbeVolume++;
-                continue;
-            }
+            }));
+        }
 
-            iplProbeBatchSave(ProbeBatch, SerializedObject);
+        for (TFuture<void>& Worker : Workers)
+        {
+            Worker.Wait();
+        }
 
-            SteamAudio::RunInGameThread<void>([&]()
-            {
-                ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString());
-                ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
-                ProbeVolume->MarkPackageDirty();
-            });
+        int NumBakesSucceeded = 0;
+        bool bAllShardsSucceeded = true;
+        for (const TUniquePtr<FBakeShard>& Shard : GBakeShards)
+        {
+            NumBakesSucceeded += Shard->NumTasksSucceeded;
+            bAllShardsSucceeded &= Shard->bSucceeded;
+        }
 
-            iplSerializedObjectRelease(&SerializedObject);
-            iplProbeBatchRelease(&ProbeBatch);
-            NumBakesSucceeded += NumBakesSucceededForProbeBatch;
-            GCurrentProbeVolume++;
+        // Shards of a bake split between processes keep their manifests, so the unsharded bake that follows them can
+        // pick up what they baked.
+        if (bAllShardsSucceeded && ShardName.IsEmpty())
+        {
+            Manifest.DeleteAll();
         }
 
         iplStaticMeshRelease(&StaticMesh);
@@ -279,12 +1126,35 @@ static EBakeResult BakeInternal(ASteamAudioStaticMeshActor* StaticMeshActor, con
 
     int NumBakesSucceeded = Future.Get();
 
+    for (const TUniquePtr<FBakeShard>& Shard : GBakeShards)
+    {
+        Shard->Report.Name = Shard->ProbeVolume->GetName();
+        Shard->Report.NumTasks = Shard->Tasks.Num();
+        Shard->Report.NumTasksSucceeded = Shard->NumTasksSucceeded;
+        OutReport.ProbeVolumes.Add(Shard->Report);
+    }
+
+    GBakeShards.Empty();
+
     if (NumBakesSucceeded == 0)
-        return EBakeResult::FAILURE;
-    else if (NumBakesSucceeded == GNumBakeTasks * GNumProbeVolumes)
-        return EBakeResult::SUCCESS;
+        OutReport.Result = EBakeResult::FAILURE;
+    else if (NumBakesSucceeded == NumTasksTotal)
+        OutReport.Result = EBakeResult::SUCCESS;
     else
-        return EBakeResult::PARTIAL_SUCCESS;
+        OutReport.Result = EBakeResult::PARTIAL_SUCCESS;
+
+    OutReport.TotalTime = FPlatformTime::Seconds() - StartTime;
+
+    FString TelemetryPath = ShardName.IsEmpty() ? ManifestBasePath + TEXT(".csv") : ManifestBasePath + TEXT(".") + ShardName + TEXT(".csv");
+    WriteBakeTelemetry(TelemetryPath, OutReport);
+
+    return OutReport.Result;
+}
+
+/** Returns the path, without extension, of the manifest used to resume bakes of the given level. */
+static FString GetBakeManifestBasePath(ULevel* Level)
+{
+    return FPaths::ProjectSavedDir() / TEXT("SteamAudio") / TEXT("Bakes") / Level->GetOutermost()->GetName().Replace(TEXT("/"), TEXT("_"));
 }
 
 void Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, FSteamAudioBakeComplete OnBakeComplete)
@@ -292,6 +1162,9 @@ void Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, FSteamAu
     check(World);
     check(Level);
 
+    if (!BeginEditorJob(FSimpleDelegate::CreateStatic(CancelBake)))
+        return;
+
     GIsBaking = true;
 
     FSteamAudioEditorModule::NotifyStartingWithCancel(NSLOCTEXT("SteamAudio", "Baking", "Baking..."), FSimpleDelegate::CreateStatic(CancelBake));
@@ -301,6 +1174,7 @@ void Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, FSteamAu
     {
         FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "BakeFailedNoScene", "Bake failed: no static geometry."));
         GIsBaking = false;
+        EndEditorJob();
         return;
     }
 
@@ -311,17 +1185,16 @@ void Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, FSteamAu
     {
         FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "BakeFailedNoProbes", "Bake failed: no probe volumes."));
         GIsBaking = false;
+        EndEditorJob();
         return;
     }
 
-    GNumBakeTasks = Tasks.Num();
-    GNumProbeVolumes = ProbeVolumes.Num();
-    GCurrentBakeTask = 1;
-    GCurrentProbeVolume = 1;
+    FString ManifestBasePath = GetBakeManifestBasePath(Level);
 
-    Async(EAsyncExecution::Thread, [StaticMeshActor, ProbeVolumes, Tasks, OnBakeComplete]()
+    Async(EAsyncExecution::Thread, [StaticMeshActor, ProbeVolumes, Tasks, ManifestBasePath, OnBakeComplete]()
     {
-        EBakeResult BakeResult = BakeInternal(StaticMeshActor, ProbeVolumes, Tasks);
+        FBakeReport Report;
+        EBakeResult BakeResult = BakeInternal(StaticMeshActor, ProbeVolumes, Tasks, ManifestBasePath, FString(), Report);
         if (BakeResult == EBakeResult::SUCCESS)
         {
             FSteamAudioEditorModule::NotifySucceeded(NSLOCTEXT("SteamAudio", "BakeSucceeded", "Bake succeeded."));
@@ -337,7 +1210,178 @@ void Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, FSteamAu
 
         OnBakeComplete.ExecuteIfBound();
         GIsBaking = false;
+        EndEditorJob();
+    });
+}
+
+TArray<FBakeTask> GetOutOfDateBakeTasks(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks)
+{
+    check(World);
+    check(Level);
+
+    ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+    if (!StaticMeshActor)
+        return Tasks;
+
+    TArray<AActor*> ProbeVolumes;
+    UGameplayStatics::GetAllActorsOfClass(World, ASteamAudioProbeVolume::StaticClass(), ProbeVolumes);
+
+    TArray<FBakeTask> OutOfDateTasks;
+
+    for (AActor* Actor : ProbeVolumes)
+    {
+        ASteamAudioProbeVolume* ProbeVolume = Cast<ASteamAudioProbeVolume>(Actor);
+        if (!ProbeVolume || !ProbeVolume->Asset.IsValid())
+            continue;
+
+        uint32 GeometryHash = GetGeometryHashForProbeVolume(StaticMeshActor, ProbeVolume);
+
+        for (const FBakeTask& Task : Tasks)
+        {
+            if (!DoesTaskApplyToProbeVolume(Task, ProbeVolume))
+                continue;
+
+            int LayerIndex = ProbeVolume->FindLayer(Task.GetLayerName());
+            if (LayerIndex != INDEX_NONE)
+            {
+                const FSteamAudioBakedDataInfo& Info = ProbeVolume->DetailedStats[LayerIndex];
+                IPLBakedDataIdentifier Identifier = GetBakedDataIdentifier(Task);
+
+                bool bGeometryChanged = (Info.GeometryHash == 0 || GeometryHash == 0 || Info.GeometryHash != GeometryHash);
+                bool bEndpointChanged = !Info.EndpointCenter.Equals(SteamAudio::ConvertVectorInverse(Identifier.endpointInfluence.center), 1.0f) ||
+                    !FMath::IsNearlyEqual(Info.EndpointRadius, Identifier.endpointInfluence.radius);
+
+                if (!bGeometryChanged && !bEndpointChanged)
+                    continue;
+            }
+
+            FBakeTask OutOfDateTask = Task;
+            OutOfDateTask.ProbeVolume = ProbeVolume;
+            OutOfDateTasks.Add(OutOfDateTask);
+        }
+    }
+
+    return OutOfDateTasks;
+}
+
+EBakeResult BakeAndWait(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks, const FBakeOptions& Options, FBakeReport& OutReport)
+{
+    check(World);
+    check(Level);
+
+    OutReport = FBakeReport();
+
+    ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
+    if (!StaticMeshActor || !StaticMeshActor->Asset.IsValid())
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Bake failed: no static geometry."));
+        return EBakeResult::FAILURE;
+    }
+
+    TArray<AActor*> ProbeVolumes;
+    UGameplayStatics::GetAllActorsOfClass(World, ASteamAudioProbeVolume::StaticClass(), ProbeVolumes);
+
+    if (ProbeVolumes.Num() <= 0)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Bake failed: no probe volumes."));
+        return EBakeResult::FAILURE;
+    }
+
+    FString ShardName;
+    if (Options.NumShards > 1)
+    {
+        check(0 <= Options.ShardIndex && Options.ShardIndex < Options.NumShards);
+
+        // Every process must split the probe volumes the same way.
+        ProbeVolumes.Sort([](const AActor& A, const AActor& B)
+        {
+            return A.GetName() < B.GetName();
+        });
+
+        TArray<AActor*> ShardProbeVolumes;
+        for (int i = Options.ShardIndex; i < ProbeVolumes.Num(); i += Options.NumShards)
+        {
+            ShardProbeVolumes.Add(ProbeVolumes[i]);
+        }
+
+        ProbeVolumes = MoveTemp(ShardProbeVolumes);
+        ShardName = FString::Printf(TEXT("%dof%d"), Options.ShardIndex, Options.NumShards);
+
+        if (ProbeVolumes.Num() <= 0)
+        {
+            UE_LOG(LogSteamAudioEditor, Warning, TEXT("No probe volumes in shard %s, nothing to bake."), *ShardName);
+            OutReport.Result = EBakeResult::SUCCESS;
+            return OutReport.Result;
+        }
+    }
+
+    if (!BeginEditorJob(FSimpleDelegate::CreateStatic(CancelBake)))
+        return EBakeResult::FAILURE;
+
+    GIsBaking = true;
+
+    FString ManifestBasePath = GetBakeManifestBasePath(Level);
+
+    TFuture<EBakeResult> Future = Async(EAsyncExecution::Thread, [&]()
+    {
+        return BakeInternal(StaticMeshActor, ProbeVolumes, Tasks, ManifestBasePath, ShardName, OutReport);
     });
+
+    SteamAudio::WaitInGameThread(Future);
+
+    GIsBaking = false;
+    EndEditorJob();
+
+    return Future.Get();
+}
+
+FSoftObjectPath GetBakeGeometryAsset(const ASteamAudioStaticMeshActor* StaticMeshActor)
+{
+    // Bake against the same geometry that's used for reflections and pathing at runtime.
+    if (GetDefault<USteamAudioSettings>()->bUseReflectionGeometry && StaticMeshActor->ReflectionAsset.IsAsset())
+        return StaticMeshActor->ReflectionAsset;
+
+    return StaticMeshActor->Asset;
+}
+
+void GetBakeParams(IPLScene Scene, const IPLSimulationSettings& SimulationSettings, IPLReflectionsBakeParams& OutReflectionsBakeParams,
+    IPLPathBakeParams& OutPathBakeParams)
+{
+    OutReflectionsBakeParams.scene = Scene;
+    OutReflectionsBakeParams.sceneType = SimulationSettings.sceneType;
+    OutReflectionsBakeParams.numRays = SimulationSettings.maxNumRays;
+    OutReflectionsBakeParams.numDiffuseSamples = SimulationSettings.numDiffuseSamples;
+    OutReflectionsBakeParams.numBounces = GetDefault<USteamAudioSettings>()->BakingBounces;
+    OutReflectionsBakeParams.simulatedDuration = SimulationSettings.maxDuration;
+    OutReflectionsBakeParams.savedDuration = SimulationSettings.maxDuration;
+    if (GetDefault<USteamAudioSettings>()->BakingSavedDuration > 0.0f)
+    {
+        OutReflectionsBakeParams.savedDuration = FMath::Min(GetDefault<USteamAudioSettings>()->BakingSavedDuration, SimulationSettings.maxDuration);
+    }
+    OutReflectionsBakeParams.order = SimulationSettings.maxOrder;
+    OutReflectionsBakeParams.numThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakingCPUCoresPercentage);
+    OutReflectionsBakeParams.rayBatchSize = 1;
+    OutReflectionsBakeParams.irradianceMinDistance = GetDefault<USteamAudioSettings>()->BakingIrradianceMinDistance;
+    OutReflectionsBakeParams.bakeBatchSize = (SimulationSettings.sceneType == IPL_SCENETYPE_RADEONRAYS) ? GetDefault<USteamAudioSettings>()->BakingBatchSize : 1;
+    OutReflectionsBakeParams.openCLDevice = SimulationSettings.openCLDevice;
+    OutReflectionsBakeParams.radeonRaysDevice = SimulationSettings.radeonRaysDevice;
+
+    if (GetDefault<USteamAudioSettings>()->bBakeConvolution)
+    {
+        OutReflectionsBakeParams.bakeFlags = static_cast<IPLReflectionsBakeFlags>(OutReflectionsBakeParams.bakeFlags | IPL_REFLECTIONSBAKEFLAGS_BAKECONVOLUTION);
+    }
+    if (GetDefault<USteamAudioSettings>()->bBakeParametric)
+    {
+        OutReflectionsBakeParams.bakeFlags = static_cast<IPLReflectionsBakeFlags>(OutReflectionsBakeParams.bakeFlags | IPL_REFLECTIONSBAKEFLAGS_BAKEPARAMETRIC);
+    }
+
+    OutPathBakeParams.scene = Scene;
+    OutPathBakeParams.numSamples = SimulationSettings.numVisSamples;
+    OutPathBakeParams.radius = GetDefault<USteamAudioSettings>()->BakingVisibilityRadius;
+    OutPathBakeParams.threshold = GetDefault<USteamAudioSettings>()->BakingVisibilityThreshold;
+    OutPathBakeParams.visRange = GetDefault<USteamAudioSettings>()->BakingVisibilityRange;
+    OutPathBakeParams.pathRange = GetDefault<USteamAudioSettings>()->BakingPathRange;
+    OutPathBakeParams.numThreads = GetNumThreadsForCPUCoresPercentage(GetDefault<USteamAudioSettings>()->BakedPathingCPUCoresPercentage);
 }
 
 }
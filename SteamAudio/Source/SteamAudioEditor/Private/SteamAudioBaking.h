@@ -23,6 +23,7 @@ class ULevel;
 class USteamAudioBakedSourceComponent;
 class USteamAudioBakedListenerComponent;
 class ASteamAudioProbeVolume;
+class ASteamAudioStaticMeshActor;
 
 
 namespace SteamAudio {
@@ -53,10 +54,107 @@ struct FBakeTask
     USteamAudioBakedListenerComponent* BakedListener;
     ASteamAudioProbeVolume* PathingProbeVolume;
 
+    /** If set, the layer is only baked in this probe volume. Otherwise, it is baked in all probe volumes. */
+    ASteamAudioProbeVolume* ProbeVolume = nullptr;
+
     FString GetLayerName() const;
 };
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FBakeReport
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Timing and throughput for one task in a probe volume. */
+struct FBakeTaskReport
+{
+    FString LayerName;
+    EBakeTaskType Type = EBakeTaskType::REVERB;
+    int NumProbes = 0;
+
+    /** True if the layer was checkpointed by an earlier, interrupted bake, and was not baked again. */
+    bool bRestored = false;
+
+    /** Time spent baking, in seconds. */
+    double Time = 0.0;
+
+    /** Number of threads used to bake. */
+    int NumThreads = 0;
+
+    /** Average CPU utilization of the process while baking, as a percentage of all cores. Includes other probe
+        volumes baked at the same time. */
+    float CPUUtilization = 0.0f;
+
+    /** Peak physical memory used by the process so far, in bytes. */
+    uint64 PeakUsedPhysical = 0;
+
+    /** Upper bound on the number of rays traced, assuming every probe was baked. 0 for pathing. */
+    int64 NumRaysEstimated = 0;
+
+    double GetProbesPerSecond() const { return (Time > 0.0) ? NumProbes / Time : 0.0; }
+    double GetRaysPerSecond() const { return (Time > 0.0) ? NumRaysEstimated / Time : 0.0; }
+};
+
+/** Timing and throughput for one probe volume in a bake. */
+struct FBakeProbeVolumeReport
+{
+    FString Name;
+    int NumProbes = 0;
+    int NumTasks = 0;
+    int NumTasksSucceeded = 0;
+
+    /** True if the probe volume was baked by an earlier bake, and was skipped. */
+    bool bResumed = false;
+
+    /** True if the probe volume was restored from the bake cache, and was not baked. */
+    bool bCached = false;
+
+    /** Time spent baking reflections and reverb, in seconds. */
+    double ReflectionsTime = 0.0;
+
+    /** Time spent baking pathing, in seconds. */
+    double PathingTime = 0.0;
+
+    /** Upper bound on the number of rays traced while baking reflections and reverb, assuming every probe was baked
+        for every task. */
+    int64 NumRaysEstimated = 0;
+
+    /** Telemetry for each task that was baked or restored from a checkpoint, in the order they were baked. Empty if
+        the whole probe volume was skipped. */
+    TArray<FBakeTaskReport> Tasks;
+};
+
+/** Timing and throughput for a bake. */
+struct FBakeReport
+{
+    EBakeResult Result = EBakeResult::FAILURE;
+
+    /** Total time taken, including loading geometry and saving probe batches, in seconds. */
+    double TotalTime = 0.0;
+
+    /** Number of probe volumes baked at the same time. */
+    int NumParallelProbeVolumes = 0;
+
+    /** Number of threads used to bake reflections for each probe volume. */
+    int NumReflectionsThreads = 0;
+
+    /** Number of threads used to bake pathing for each probe volume. */
+    int NumPathingThreads = 0;
+
+    TArray<FBakeProbeVolumeReport> ProbeVolumes;
+};
+
+/** Options for BakeAndWait. */
+struct FBakeOptions
+{
+    /** If NumShards is greater than 1, only every NumShards-th probe volume, starting from ShardIndex (in order of
+        name), is baked. This lets a bake be split between several processes. A later bake of the same tasks with
+        NumShards set to 1 picks up the probe batches baked by all shards, without baking them again. */
+    int ShardIndex = 0;
+    int NumShards = 1;
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Baking
 // ---------------------------------------------------------------------------------------------------------------------
@@ -65,12 +163,55 @@ struct FBakeTask
 
 extern std::atomic<bool> GIsBaking;
 
+/** True while a bake, calibration, or probe generation is running. These all initialize the Steam Audio Manager for
+    their own use on a worker thread, so only one can run at a time, and never while playing in the editor. */
+extern std::atomic<bool> GIsEditorJobRunning;
+
+/** Marks an editor job as running, with a delegate that cancels it. Returns false if another job is already running,
+    or the editor is playing. Call on the game thread. */
+bool STEAMAUDIOEDITOR_API BeginEditorJob(FSimpleDelegate OnCancel = FSimpleDelegate());
+
+/** Marks the running editor job as finished, once it no longer uses the Steam Audio Manager. Can be called from any
+    thread. */
+void STEAMAUDIOEDITOR_API EndEditorJob();
+
+/** Cancels the running editor job, if any, and waits for it to finish. Call on the game thread. */
+void STEAMAUDIOEDITOR_API CancelEditorJobAndWait();
+
 DECLARE_DELEGATE(FSteamAudioBakeComplete);
 
-/** Runs one or more bakes for a level. */
+/** Runs one or more bakes for a level. Probe volumes are baked in parallel, each into its own probe batch asset. If
+    an earlier bake of the same tasks failed or was cancelled, probe volumes that it finished baking are skipped. */
 void STEAMAUDIOEDITOR_API Bake(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks,
     FSteamAudioBakeComplete OnBakeComplete = FSteamAudioBakeComplete());
 
+/** Returns the given tasks, each restricted to the probe volumes in which its layer hasn't been baked, or was baked
+    against geometry that has since changed near the probe volume, or for an endpoint that has since moved. */
+TArray<FBakeTask> STEAMAUDIOEDITOR_API GetOutOfDateBakeTasks(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks);
+
+/** Runs one or more bakes for a level and waits for them to finish, without showing any notifications. Must be
+    called on the game thread, which is ticked while waiting. For use by commandlets. */
+EBakeResult STEAMAUDIOEDITOR_API BakeAndWait(UWorld* World, ULevel* Level, const TArray<FBakeTask>& Tasks,
+    const FBakeOptions& Options, FBakeReport& OutReport);
+
+/** Returns the identifier of the layer baked by the given task. */
+IPLBakedDataIdentifier GetBakedDataIdentifier(const FBakeTask& Task);
+
+/** Returns the Ambisonic order at which to bake the given task, given the order used for all other tasks. */
+IPLint32 GetBakedOrder(const FBakeTask& Task, IPLint32 Order);
+
+/** Returns true if the given task bakes a layer in the given probe volume. */
+bool DoesTaskApplyToProbeVolume(const FBakeTask& Task, ASteamAudioProbeVolume* ProbeVolume);
+
+/** Returns the geometry asset that probes are baked against: the reflection geometry if it is enabled and was
+    exported, otherwise the full static geometry. */
+FSoftObjectPath GetBakeGeometryAsset(const ASteamAudioStaticMeshActor* StaticMeshActor);
+
+/** Fills in the parameters for baking reflections and pathing against the given scene, based on the project
+    settings. The probe batch and identifier are left for the caller to set. */
+void GetBakeParams(IPLScene Scene, const IPLSimulationSettings& SimulationSettings, IPLReflectionsBakeParams& OutReflectionsBakeParams,
+    IPLPathBakeParams& OutPathBakeParams);
+
 #endif
 
 }
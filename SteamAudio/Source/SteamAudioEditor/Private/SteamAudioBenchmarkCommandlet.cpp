@@ -0,0 +1,531 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include "SteamAudioBenchmarkCommandlet.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioListenerComponent.h"
+#include "SteamAudioManager.h"
+#include "SteamAudioSettings.h"
+#include "SteamAudioSourceComponent.h"
+#include "SteamAudioStubPhonon.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helper Functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Length of each side of the synthetic room, in Unreal units.
+static const float RoomSize = 5000.0f;
+
+// Options parsed from the command line.
+struct FBenchmarkOptions
+{
+    int NumSources = 64;
+    int NumReflectionSources = 8;
+    int NumListeners = 1;
+    int NumTriangles = 10000;
+    int NumFrames = 600;
+    int NumWarmupFrames = 60;
+    float DeltaTime = 1.0f / 60.0f;
+    bool bPacing = true;
+};
+
+// Creates a scene containing a box-shaped room centered on the origin. Each of the six walls is subdivided into a
+// grid, so that the room has roughly the requested number of triangles. Returns nullptr on failure.
+static IPLScene CreateSyntheticScene(FSteamAudioManager& Manager, int NumTriangles)
+{
+    int NumDivisions = FMath::Max(FMath::CeilToInt(FMath::Sqrt(NumTriangles / 12.0f)), 1);
+
+    TArray<IPLVector3> Vertices;
+    TArray<IPLTriangle> Triangles;
+
+    static const FVector FaceNormals[] = {
+        FVector(1.0f, 0.0f, 0.0f), FVector(-1.0f, 0.0f, 0.0f),
+        FVector(0.0f, 1.0f, 0.0f), FVector(0.0f, -1.0f, 0.0f),
+        FVector(0.0f, 0.0f, 1.0f), FVector(0.0f, 0.0f, -1.0f)
+    };
+
+    for (const FVector& Normal : FaceNormals)
+    {
+        FVector U = FVector::CrossProduct(Normal, (FMath::Abs(Normal.Z) > 0.5f) ? FVector::ForwardVector : FVector::UpVector);
+        FVector V = FVector::CrossProduct(Normal, U);
+        FVector Corner = (Normal - U - V) * (RoomSize * 0.5f);
+        float CellSize = RoomSize / NumDivisions;
+
+        int BaseIndex = Vertices.Num();
+        for (int j = 0; j <= NumDivisions; ++j)
+        {
+            for (int i = 0; i <= NumDivisions; ++i)
+            {
+                Vertices.Add(ConvertVector(Corner + (U * i + V * j) * CellSize));
+            }
+        }
+
+        for (int j = 0; j < NumDivisions; ++j)
+        {
+            for (int i = 0; i < NumDivisions; ++i)
+            {
+                int Index = BaseIndex + j * (NumDivisions + 1) + i;
+                Triangles.Add(IPLTriangle{ { Index, Index + 1, Index + NumDivisions + 2 } });
+                Triangles.Add(IPLTriangle{ { Index, Index + NumDivisions + 2, Index + NumDivisions + 1 } });
+            }
+        }
+    }
+
+    TArray<IPLint32> MaterialIndices;
+    MaterialIndices.Init(0, Triangles.Num());
+
+    IPLMaterial Material{ { 0.10f, 0.20f, 0.30f }, 0.05f, { 0.100f, 0.050f, 0.030f } };
+
+    IPLSceneSettings SceneSettings = Manager.GetSceneSettings();
+
+    IPLScene Scene = nullptr;
+    IPLerror Status = iplSceneCreate(Manager.GetContext(), &SceneSettings, &Scene);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to create scene. [%d]"), Status);
+        return nullptr;
+    }
+
+    IPLStaticMeshSettings StaticMeshSettings{};
+    StaticMeshSettings.numVertices = Vertices.Num();
+    StaticMeshSettings.numTriangles = Triangles.Num();
+    StaticMeshSettings.numMaterials = 1;
+    StaticMeshSettings.vertices = Vertices.GetData();
+    StaticMeshSettings.triangles = Triangles.GetData();
+    StaticMeshSettings.materialIndices = MaterialIndices.GetData();
+    StaticMeshSettings.materials = &Material;
+
+    IPLStaticMesh StaticMesh = nullptr;
+    Status = iplStaticMeshCreate(Scene, &StaticMeshSettings, &StaticMesh);
+    if (Status != IPL_STATUS_SUCCESS)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to create static mesh. [%d]"), Status);
+        iplSceneRelease(&Scene);
+        return nullptr;
+    }
+
+    iplStaticMeshAdd(StaticMesh, Scene);
+    iplSceneCommit(Scene);
+    iplStaticMeshRelease(&StaticMesh);
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Created synthetic scene with %d triangles."), Triangles.Num());
+
+    return Scene;
+}
+
+// Spawns an actor at the origin, with a scene component as its root so it can be moved.
+static AActor* SpawnBenchmarkActor(UWorld* World)
+{
+    AActor* Actor = World->SpawnActor<AActor>();
+
+    USceneComponent* Root = NewObject<USceneComponent>(Actor);
+    Actor->SetRootComponent(Root);
+    Root->RegisterComponent();
+
+    return Actor;
+}
+
+// Moves an actor along a horizontal circle around the center of the room. Each actor gets its own radius, height,
+// and starting angle, so actors are spread through the room and follow the same paths on every run.
+static void MoveBenchmarkActor(AActor* Actor, int Index, int Count, double Time, float AngularSpeed, float RadiusScale)
+{
+    float Phase = 2.0f * PI * Index / FMath::Max(Count, 1);
+    float Radius = RoomSize * RadiusScale * (0.25f + 0.75f * ((Index * 7) % 11) / 10.0f);
+    float Height = RoomSize * RadiusScale * (-0.5f + ((Index * 5) % 7) / 6.0f);
+    float Angle = Phase + AngularSpeed * Time;
+
+    Actor->SetActorLocation(FVector(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), Height));
+}
+
+// Returns the given percentile (0 to 100) of a set of values, or 0 if there are none.
+static double GetPercentile(TArray<double> Values, double Percentile)
+{
+    if (Values.Num() == 0)
+        return 0.0;
+
+    Values.Sort();
+
+    int Index = FMath::Clamp(FMath::CeilToInt(Percentile / 100.0 * Values.Num()) - 1, 0, Values.Num() - 1);
+    return Values[Index];
+}
+
+// Returns the mean of a set of values, or 0 if there are none.
+static double GetMean(const TArray<double>& Values)
+{
+    if (Values.Num() == 0)
+        return 0.0;
+
+    double Sum = 0.0;
+    for (double Value : Values)
+    {
+        Sum += Value;
+    }
+
+    return Sum / Values.Num();
+}
+
+// Writes the mean, maximum, and percentiles of a set of times (in seconds) as a JSON object, in milliseconds.
+static void WriteTimings(const TSharedRef<TJsonWriter<>>& Writer, const TCHAR* Name, const TArray<double>& Times)
+{
+    Writer->WriteObjectStart(Name);
+    Writer->WriteValue(TEXT("count"), Times.Num());
+    Writer->WriteValue(TEXT("meanMs"), GetMean(Times) * 1000.0);
+    Writer->WriteValue(TEXT("p50Ms"), GetPercentile(Times, 50.0) * 1000.0);
+    Writer->WriteValue(TEXT("p90Ms"), GetPercentile(Times, 90.0) * 1000.0);
+    Writer->WriteValue(TEXT("p95Ms"), GetPercentile(Times, 95.0) * 1000.0);
+    Writer->WriteValue(TEXT("p99Ms"), GetPercentile(Times, 99.0) * 1000.0);
+    Writer->WriteValue(TEXT("maxMs"), GetPercentile(Times, 100.0) * 1000.0);
+    Writer->WriteObjectEnd();
+}
+
+// Waits for the simulation thread to finish the reflections and pathing update it is running, if any.
+static void WaitForSimulationThread(const FSteamAudioManager& Manager)
+{
+    while (!Manager.IsSimulationThreadIdle())
+    {
+        FPlatformProcess::Sleep(0.001f);
+    }
+}
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBenchmarkCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioBenchmarkCommandlet::USteamAudioBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 USteamAudioBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace SteamAudio;
+
+    FBenchmarkOptions Options;
+    FParse::Value(*Params, TEXT("Sources="), Options.NumSources);
+    FParse::Value(*Params, TEXT("Reflections="), Options.NumReflectionSources);
+    FParse::Value(*Params, TEXT("Listeners="), Options.NumListeners);
+    FParse::Value(*Params, TEXT("Triangles="), Options.NumTriangles);
+    FParse::Value(*Params, TEXT("Frames="), Options.NumFrames);
+    FParse::Value(*Params, TEXT("Warmup="), Options.NumWarmupFrames);
+    FParse::Value(*Params, TEXT("DeltaTime="), Options.DeltaTime);
+    Options.bPacing = !FParse::Param(*Params, TEXT("NoPacing"));
+
+    Options.NumSources = FMath::Max(Options.NumSources, 0);
+    Options.NumReflectionSources = FMath::Clamp(Options.NumReflectionSources, 0, Options.NumSources);
+    Options.NumListeners = FMath::Max(Options.NumListeners, 0);
+    Options.NumTriangles = FMath::Max(Options.NumTriangles, 12);
+    Options.NumFrames = FMath::Max(Options.NumFrames, 1);
+    Options.NumWarmupFrames = FMath::Max(Options.NumWarmupFrames, 0);
+
+    if (Options.DeltaTime <= 0.0f)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Delta time must be greater than 0."));
+        return 1;
+    }
+
+    double MaxFrameP95Ms = 0.0;
+    FParse::Value(*Params, TEXT("MaxFrameP95Ms="), MaxFrameP95Ms);
+
+    FString ReportFileName = FPaths::ProjectSavedDir() / TEXT("SteamAudio") / TEXT("Benchmarks") / TEXT("Simulation.json");
+    FParse::Value(*Params, TEXT("Report="), ReportFileName);
+
+    // Custom ray tracers need a loaded map, so the built-in ray tracer is used unless Embree is requested.
+    GetMutableDefault<USteamAudioSettings>()->SceneType = ESceneType::DEFAULT;
+
+    FString SceneTypeName;
+    if (FParse::Value(*Params, TEXT("SceneType="), SceneTypeName))
+    {
+        if (SceneTypeName == TEXT("Default"))
+        {
+            GetMutableDefault<USteamAudioSettings>()->SceneType = ESceneType::DEFAULT;
+        }
+        else if (SceneTypeName == TEXT("Embree"))
+        {
+            GetMutableDefault<USteamAudioSettings>()->SceneType = ESceneType::EMBREE;
+        }
+        else
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unknown scene type: %s. Expected Default or Embree."), *SceneTypeName);
+            return 1;
+        }
+    }
+
+#if STEAMAUDIO_STUB_PHONON
+    double StubNanosecondsPerRay = 0.0;
+    FParse::Value(*Params, TEXT("StubNanosecondsPerRay="), StubNanosecondsPerRay);
+    SetStubPhononNanosecondsPerRay(StubNanosecondsPerRay);
+#endif
+
+    FSteamAudioManager& Manager = FSteamAudioModule::GetManager();
+    if (!Manager.InitializeSteamAudio(EManagerInitReason::PLAYING))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to initialize Steam Audio."));
+        return 1;
+    }
+
+    IPLScene SubScene = CreateSyntheticScene(Manager, Options.NumTriangles);
+    if (!SubScene)
+    {
+        Manager.ShutDownSteamAudio();
+        return 1;
+    }
+
+    IPLMatrix4x4 Transform = ConvertTransform(FTransform::Identity);
+
+    FSteamAudioDoubleBufferedScene::FInstanceHandle InstanceHandle = Manager.GetDoubleBufferedScene()->AddInstance(SubScene, Transform);
+
+    FSteamAudioDoubleBufferedScene::FInstanceHandle ReflectionInstanceHandle = 0;
+    if (Manager.HasSeparateReflectionScene())
+    {
+        ReflectionInstanceHandle = Manager.GetDoubleBufferedReflectionScene()->AddInstance(SubScene, Transform);
+    }
+
+    iplSceneRelease(&SubScene);
+
+    // Sources and listeners add themselves to the manager in BeginPlay, so they need a world that has begun play.
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SteamAudioBenchmark"));
+    GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+
+    TArray<AActor*> SourceActors;
+    for (int i = 0; i < Options.NumSources; ++i)
+    {
+        AActor* Actor = SpawnBenchmarkActor(World);
+
+        USteamAudioSourceComponent* Source = NewObject<USteamAudioSourceComponent>(Actor);
+        Source->bSimulateOcclusion = true;
+        Source->OcclusionType = EOcclusionType::VOLUMETRIC;
+        Source->bSimulateTransmission = true;
+        Source->bSimulateReflections = (i < Options.NumReflectionSources);
+        Source->ReflectionsType = EReflectionSimulationType::REALTIME;
+        Source->RegisterComponent();
+
+        SourceActors.Add(Actor);
+    }
+
+    TArray<AActor*> ListenerActors;
+    for (int i = 0; i < Options.NumListeners; ++i)
+    {
+        AActor* Actor = SpawnBenchmarkActor(World);
+
+        USteamAudioListenerComponent* Listener = NewObject<USteamAudioListenerComponent>(Actor);
+        Listener->bSimulateReverb = true;
+        Listener->ReverbType = EReverbSimulationType::REALTIME;
+        Listener->RegisterComponent();
+
+        ListenerActors.Add(Actor);
+    }
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Running %d warmup and %d measured frames with %d source(s) (%d with reflections) and %d listener(s)."),
+        Options.NumWarmupFrames, Options.NumFrames, Options.NumSources, Options.NumReflectionSources, Options.NumListeners);
+
+    TArray<double> FrameTimes;
+    TArray<double> DirectTimes;
+    TArray<double> ReflectionsTimes;
+    TArray<double> PathingTimes;
+
+    FSteamAudioSimulationStats PreviousStats;
+    double Time = 0.0;
+    double StartTime = 0.0;
+
+    // Records the reflections and pathing updates that finished since the last call, and returns the current stats.
+    auto RecordSimulationUpdates = [&]()
+    {
+        FSteamAudioSimulationStats Stats = Manager.GetSimulationStats();
+
+        int NumUpdates = Stats.NumReflectionsUpdates - PreviousStats.NumReflectionsUpdates;
+        if (NumUpdates > 0)
+        {
+            ReflectionsTimes.Add((Stats.ReflectionsTime - PreviousStats.ReflectionsTime) / NumUpdates);
+            PathingTimes.Add((Stats.PathingTime - PreviousStats.PathingTime) / NumUpdates);
+        }
+
+        return Stats;
+    };
+
+    for (int Frame = 0; Frame < Options.NumWarmupFrames + Options.NumFrames; ++Frame)
+    {
+        bool bMeasured = (Frame >= Options.NumWarmupFrames);
+
+        if (Frame == Options.NumWarmupFrames)
+        {
+            WaitForSimulationThread(Manager);
+            Manager.ResetSimulationStats();
+            PreviousStats = FSteamAudioSimulationStats();
+#if STEAMAUDIO_STUB_PHONON
+            ResetStubPhononStats();
+#endif
+            StartTime = FPlatformTime::Seconds();
+        }
+
+        double FrameStartTime = FPlatformTime::Seconds();
+
+        for (int i = 0; i < SourceActors.Num(); ++i)
+        {
+            MoveBenchmarkActor(SourceActors[i], i, SourceActors.Num(), Time, 0.5f, 0.4f);
+        }
+
+        for (int i = 0; i < ListenerActors.Num(); ++i)
+        {
+            MoveBenchmarkActor(ListenerActors[i], i, ListenerActors.Num(), Time, 0.2f, 0.1f);
+        }
+
+        double TickStartTime = FPlatformTime::Seconds();
+        Manager.Tick(Options.DeltaTime);
+        double TickTime = FPlatformTime::Seconds() - TickStartTime;
+
+        // Runs anything queued for the game thread, as the engine loop would between frames.
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+        if (bMeasured)
+        {
+            FSteamAudioSimulationStats Stats = RecordSimulationUpdates();
+
+            FrameTimes.Add(TickTime);
+            DirectTimes.Add(Stats.DirectTime - PreviousStats.DirectTime);
+
+            PreviousStats = Stats;
+        }
+
+        Time += Options.DeltaTime;
+
+        if (Options.bPacing)
+        {
+            double RemainingTime = Options.DeltaTime - (FPlatformTime::Seconds() - FrameStartTime);
+            if (RemainingTime > 0.0)
+            {
+                FPlatformProcess::Sleep(RemainingTime);
+            }
+        }
+    }
+
+    WaitForSimulationThread(Manager);
+    RecordSimulationUpdates();
+
+    double TotalTime = FPlatformTime::Seconds() - StartTime;
+
+    for (AActor* Actor : SourceActors)
+    {
+        Actor->Destroy();
+    }
+
+    for (AActor* Actor : ListenerActors)
+    {
+        Actor->Destroy();
+    }
+
+    Manager.GetDoubleBufferedScene()->RemoveInstance(InstanceHandle);
+    if (Manager.HasSeparateReflectionScene())
+    {
+        Manager.GetDoubleBufferedReflectionScene()->RemoveInstance(ReflectionInstanceHandle);
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+
+    Manager.ShutDownSteamAudio();
+
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+    Writer->WriteObjectStart();
+
+#if STEAMAUDIO_STUB_PHONON
+    Writer->WriteValue(TEXT("backend"), TEXT("stub"));
+#else
+    Writer->WriteValue(TEXT("backend"), TEXT("sdk"));
+#endif
+
+    Writer->WriteObjectStart(TEXT("config"));
+    Writer->WriteValue(TEXT("sources"), Options.NumSources);
+    Writer->WriteValue(TEXT("reflectionSources"), Options.NumReflectionSources);
+    Writer->WriteValue(TEXT("listeners"), Options.NumListeners);
+    Writer->WriteValue(TEXT("triangles"), Options.NumTriangles);
+    Writer->WriteValue(TEXT("frames"), Options.NumFrames);
+    Writer->WriteValue(TEXT("warmupFrames"), Options.NumWarmupFrames);
+    Writer->WriteValue(TEXT("deltaTime"), Options.DeltaTime);
+    Writer->WriteValue(TEXT("pacing"), Options.bPacing);
+    Writer->WriteValue(TEXT("sceneType"), (Settings->SceneType == ESceneType::EMBREE) ? TEXT("Embree") : TEXT("Default"));
+    Writer->WriteValue(TEXT("realTimeRays"), Settings->RealTimeRays);
+    Writer->WriteValue(TEXT("realTimeBounces"), Settings->RealTimeBounces);
+    Writer->WriteValue(TEXT("simulationUpdateIntervalSeconds"), Settings->SimulationUpdateInterval);
+#if STEAMAUDIO_STUB_PHONON
+    Writer->WriteValue(TEXT("stubNanosecondsPerRay"), StubNanosecondsPerRay);
+#endif
+    Writer->WriteObjectEnd();
+
+    Writer->WriteValue(TEXT("totalSeconds"), TotalTime);
+    WriteTimings(Writer, TEXT("frame"), FrameTimes);
+    WriteTimings(Writer, TEXT("direct"), DirectTimes);
+    WriteTimings(Writer, TEXT("reflections"), ReflectionsTimes);
+    WriteTimings(Writer, TEXT("pathing"), PathingTimes);
+
+#if STEAMAUDIO_STUB_PHONON
+    FStubPhononStats StubStats = GetStubPhononStats();
+    Writer->WriteObjectStart(TEXT("stub"));
+    Writer->WriteValue(TEXT("directRuns"), StubStats.NumDirectRuns);
+    Writer->WriteValue(TEXT("reflectionsRuns"), StubStats.NumReflectionsRuns);
+    Writer->WriteValue(TEXT("pathingRuns"), StubStats.NumPathingRuns);
+    Writer->WriteValue(TEXT("directRays"), StubStats.NumDirectRays);
+    Writer->WriteValue(TEXT("reflectionRays"), StubStats.NumReflectionRays);
+    Writer->WriteValue(TEXT("pathingProbes"), StubStats.NumPathingProbes);
+    Writer->WriteObjectEnd();
+#endif
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    double FrameP95Ms = GetPercentile(FrameTimes, 95.0) * 1000.0;
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Frame: %.3f ms mean, %.3f ms p95, %.3f ms max. Direct: %.3f ms mean. Reflections: %d update(s), %.3f ms mean. Pathing: %.3f ms mean."),
+        GetMean(FrameTimes) * 1000.0, FrameP95Ms, GetPercentile(FrameTimes, 100.0) * 1000.0, GetMean(DirectTimes) * 1000.0,
+        ReflectionsTimes.Num(), GetMean(ReflectionsTimes) * 1000.0, GetMean(PathingTimes) * 1000.0);
+
+    if (!FFileHelper::SaveStringToFile(Json, *ReportFileName))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to write benchmark report: %s"), *ReportFileName);
+        return 1;
+    }
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Benchmark report written to %s."), *ReportFileName);
+
+    if (MaxFrameP95Ms > 0.0 && FrameP95Ms > MaxFrameP95Ms)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("95th percentile frame cost of %.3f ms exceeds budget of %.3f ms."), FrameP95Ms, MaxFrameP95Ms);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioEditorModule.h"
+#include "Commandlets/Commandlet.h"
+#include "SteamAudioBenchmarkCommandlet.generated.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioBenchmarkCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Measures the cost of real-time simulation in the Steam Audio manager, without loading a map or needing audio
+// hardware. Builds a synthetic scene (a box-shaped room whose walls are subdivided into the requested number of
+// triangles), spawns sources and listeners that move along scripted paths, and ticks the manager for a fixed number
+// of frames. Reports the time spent on direct simulation (on the game thread), reflections and pathing (on the
+// simulation thread), and percentiles of the manager's per-frame cost. The current project settings are used, except
+// that the scene type defaults to Default.
+//
+// When the plugin is built against the stub Steam Audio API (see SteamAudioStubPhonon.h), the report also includes
+// the number of rays the simulator was asked to trace, which doesn't depend on the machine, and simulation can be
+// given a fixed cost per ray with -StubNanosecondsPerRay.
+//
+// Usage:
+//     UnrealEditor-Cmd <Project>.uproject -run=SteamAudioBenchmark [options] -nullrhi -nosound -unattended
+//
+// Options:
+//     -Sources=<n>                 Number of sources. Defaults to 64.
+//     -Reflections=<n>             Number of sources that also simulate real-time reflections. Defaults to 8.
+//     -Listeners=<n>               Number of listeners, each simulating real-time reverb. Defaults to 1.
+//     -Triangles=<n>               Approximate number of triangles in the scene. Defaults to 10000.
+//     -Frames=<n>                  Number of frames to measure. Defaults to 600.
+//     -Warmup=<n>                  Number of frames to run before measuring. Defaults to 60.
+//     -DeltaTime=<seconds>         Time step of each frame. Defaults to 1/60.
+//     -NoPacing                    Ticks as fast as possible, instead of waiting for the rest of each frame.
+//     -SceneType=<type>            Ray tracer to use: Default or Embree.
+//     -StubNanosecondsPerRay=<n>   With the stub API, how long each modeled ray takes.
+//     -MaxFrameP95Ms=<n>           Fails if the 95th percentile of the per-frame cost is more than n milliseconds.
+//     -Report=<file>               Writes the results as JSON to the given file. Defaults to
+//                                  Saved/SteamAudio/Benchmarks/Simulation.json.
+//
+// Returns 0 if the benchmark ran and is within budget, and 1 otherwise.
+UCLASS()
+class USteamAudioBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USteamAudioBenchmarkCommandlet();
+
+    //
+    // Inherited from UCommandlet
+    //
+
+    // Runs the commandlet.
+    virtual int32 Main(const FString& Params) override;
+};
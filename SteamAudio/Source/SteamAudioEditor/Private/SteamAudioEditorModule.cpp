@@ -27,6 +27,7 @@
 #include "Developer/DesktopPlatform/Public/DesktopPlatformModule.h"
 #include "Editor/UnrealEdEngine.h"
 #include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
 #include "Styling/SlateStyle.h"
 #include "Styling/SlateStyleRegistry.h"
 #include "SteamAudioBakedListenerComponent.h"
@@ -36,9 +37,11 @@
 #include "SteamAudioBakedSourceComponentVisualizer.h"
 #include "SteamAudioBakedSourceDetails.h"
 #include "SteamAudioBakeWindow.h"
+#include "SteamAudioBaking.h"
 #include "SteamAudioDynamicObjectComponent.h"
 #include "SteamAudioDynamicObjectDetails.h"
 #include "SteamAudioGeometryComponent.h"
+#include "SteamAudioLevelReport.h"
 #include "SteamAudioListenerDetails.h"
 #include "SteamAudioMaterialFactory.h"
 #include "SteamAudioOcclusionSettingsFactory.h"
@@ -133,6 +136,10 @@ void FSteamAudioEditorModule::StartupModule()
     RegisterComponentVisualizer(USteamAudioBakedListenerComponent::StaticClass()->GetFName(), MakeShared<FSteamAudioBakedListenerComponentVisualizer>());
     RegisterComponentVisualizer(USteamAudioSourceComponent::StaticClass()->GetFName(), MakeShared<FSteamAudioSourceComponentVisualizer>());
 
+    // Bakes, calibration, and probe generation use the Steam Audio Manager on a worker thread, so make sure none are
+    // running by the time playing in the editor initializes it.
+    PreBeginPIEHandle = FEditorDelegates::PreBeginPIE.AddRaw(this, &FSteamAudioEditorModule::OnPreBeginPIE);
+
     // Create the bake window.
     BakeWindow = MakeShared<FBakeWindow>();
 
@@ -222,6 +229,15 @@ void FSteamAudioEditorModule::StartupModule()
                     );
                     MenuBuilder.EndSection();
 
+                    MenuBuilder.BeginSection("Report", NSLOCTEXT("SteamAudio", "MenuReport", "Report"));
+                    MenuBuilder.AddMenuEntry(
+                        NSLOCTEXT("SteamAudio", "MenuLevelReport", "Generate Level Report"),
+                        NSLOCTEXT("SteamAudio", "MenuLevelReportTooltip", "Report the memory used by Steam Audio and the estimated simulation cost in all sublevels."),
+                        FSlateIcon(),
+                        FUIAction(FExecuteAction::CreateRaw(this, &FSteamAudioEditorModule::OnGenerateLevelReport))
+                    );
+                    MenuBuilder.EndSection();
+
                     return MenuBuilder.MakeWidget();
                 }),
                 TAttribute<FText>::Create([this]() { return NSLOCTEXT("SteamAudio", "SteamAudio", "Steam Audio"); }),
@@ -236,6 +252,8 @@ void FSteamAudioEditorModule::StartupModule()
 
 void FSteamAudioEditorModule::ShutdownModule()
 {
+    FEditorDelegates::PreBeginPIE.Remove(PreBeginPIEHandle);
+
 	// Unregister component visualizers
     if (GUnrealEd)
     {
@@ -463,6 +481,52 @@ void FSteamAudioEditorModule::OnBake()
     BakeWindow->Invoke();
 }
 
+void FSteamAudioEditorModule::OnGenerateLevelReport()
+{
+    UWorld* World = GEditor->GetLevelViewportClients()[0]->GetWorld();
+
+    NotifyStarting(NSLOCTEXT("SteamAudio", "LevelReport", "Generating level report..."));
+
+    // Gathering the report loads the exported assets to measure them, so it runs on the game thread.
+    TArray<FLevelReport> Reports;
+    for (ULevel* Level : World->GetLevels())
+    {
+        if (!Level)
+            continue;
+
+        FLevelReport Report = GatherLevelReport(World, Level);
+        LogLevelReport(Report);
+        Reports.Add(Report);
+    }
+
+    FString MapName = World->GetOutermost()->GetName();
+    FString FileName = FPaths::ProjectSavedDir() / TEXT("SteamAudio") / TEXT("Reports") / MapName.Replace(TEXT("/"), TEXT("_")) + TEXT(".json");
+
+    if (!WriteLevelReports(FileName, Reports))
+    {
+        NotifyFailed(NSLOCTEXT("SteamAudio", "LevelReportFail", "Failed to write level report."));
+        return;
+    }
+
+    int64 TotalSize = 0;
+    for (const FLevelReport& Report : Reports)
+    {
+        TotalSize += Report.GetTotalSize();
+    }
+
+    NotifySucceeded(FText::FormatOrdered(NSLOCTEXT("SteamAudio", "LevelReportSuccess", "Steam Audio uses {0} in {1} level(s). Report written to {2}."),
+        FText::AsMemory(TotalSize), FText::AsNumber(Reports.Num()), FText::FromString(FPaths::ConvertRelativePathToFull(FileName))));
+}
+
+void FSteamAudioEditorModule::OnPreBeginPIE(bool bIsSimulating)
+{
+    if (!GIsEditorJobRunning)
+        return;
+
+    UE_LOG(LogSteamAudioEditor, Warning, TEXT("Cancelling Steam Audio bake, calibration, or probe generation before playing in the editor."));
+    CancelEditorJobAndWait();
+}
+
 void FSteamAudioEditorModule::ExportSingleLevel(UWorld* World, ULevel* Level, bool bExportOBJ)
 {
     FString Name;
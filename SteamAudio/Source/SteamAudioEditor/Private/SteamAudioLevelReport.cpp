@@ -0,0 +1,297 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioLevelReport.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectIterator.h"
+#include "SteamAudioBakeEstimator.h"
+#include "SteamAudioCommon.h"
+#include "SteamAudioDynamicObjectComponent.h"
+#include "SteamAudioGeometryComponent.h"
+#include "SteamAudioListenerComponent.h"
+#include "SteamAudioProbeVolume.h"
+#include "SteamAudioSerializedObject.h"
+#include "SteamAudioSettings.h"
+#include "SteamAudioSourceComponent.h"
+#include "SteamAudioStaticMeshActor.h"
+
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helper Functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Approximate size of the ray tracing acceleration structure per triangle, in bytes. Steam Audio doesn't report the
+    size of its BVH, so this assumes about two nodes per triangle. */
+static const int64 EstimatedBVHBytesPerTriangle = 64;
+
+/** Returns the size of the data in a Steam Audio Serialized Object asset, in bytes, or 0 if it can't be loaded. */
+static int64 GetAssetDataSize(const FSoftObjectPath& Asset)
+{
+    if (!Asset.IsAsset())
+        return 0;
+
+    const USteamAudioSerializedObject* AssetObject = Cast<USteamAudioSerializedObject>(Asset.TryLoad());
+    return AssetObject ? AssetObject->GetDataSize() : 0;
+}
+
+/** Returns the size of the package file containing an asset, in bytes, or 0 if it doesn't exist. */
+static int64 GetAssetDiskSize(const FSoftObjectPath& Asset)
+{
+    if (!Asset.IsAsset())
+        return 0;
+
+    FString FileName = FPackageName::LongPackageNameToFilename(Asset.GetLongPackageName(), FPackageName::GetAssetPackageExtension());
+    return FMath::Max<int64>(IFileManager::Get().FileSize(*FileName), 0);
+}
+
+/** Returns the name of the kind of baked data in a layer. */
+static FString GetLayerTypeName(const FSteamAudioBakedDataInfo& Info)
+{
+    if (Info.Type == IPL_BAKEDDATATYPE_PATHING)
+        return TEXT("Pathing");
+
+    switch (Info.Variation)
+    {
+    case IPL_BAKEDDATAVARIATION_STATICSOURCE:
+        return TEXT("StaticSource");
+    case IPL_BAKEDDATAVARIATION_STATICLISTENER:
+        return TEXT("StaticListener");
+    default:
+        return TEXT("Reverb");
+    }
+}
+
+/** Returns true if the given component belongs to an actor in the given level. */
+static bool IsInLevel(const UActorComponent* Component, UWorld* World, ULevel* Level)
+{
+    return Component->GetWorld() == World && Component->GetOwner() && Component->GetOwner()->GetLevel() == Level;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Level Reports
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLevelReport GatherLevelReport(UWorld* World, ULevel* Level)
+{
+    check(IsInGameThread());
+    check(World && Level);
+
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+
+    FLevelReport Report;
+    Report.MapName = World->GetOutermost()->GetName();
+    Report.LevelName = Level->GetOutermost()->GetName();
+
+    // Static geometry.
+    for (TObjectIterator<USteamAudioGeometryComponent> It; It; ++It)
+    {
+        if (IsInLevel(*It, World, Level))
+        {
+            Report.NumTaggedTriangles += It->NumTriangles;
+        }
+    }
+
+    if (ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level))
+    {
+        Report.NumTriangles = StaticMeshActor->NumTriangles;
+        Report.StaticGeometrySize = GetAssetDataSize(StaticMeshActor->Asset) + GetAssetDataSize(StaticMeshActor->ReflectionAsset);
+    }
+
+    int NumTrianglesForCost = (Report.NumTriangles > 0) ? Report.NumTriangles : Report.NumTaggedTriangles;
+    Report.EstimatedBVHSize = NumTrianglesForCost * EstimatedBVHBytesPerTriangle;
+
+    // Dynamic objects.
+    for (TObjectIterator<USteamAudioDynamicObjectComponent> It; It; ++It)
+    {
+        if (IsInLevel(*It, World, Level))
+        {
+            Report.NumDynamicObjects++;
+            Report.DynamicObjectsSize += GetAssetDataSize(It->GetAssetToLoad());
+        }
+    }
+
+    // Probes and baked data.
+    for (TActorIterator<ASteamAudioProbeVolume> It(World); It; ++It)
+    {
+        if (It->GetLevel() != Level)
+            continue;
+
+        FLevelReportProbeVolume ProbeVolumeReport;
+        ProbeVolumeReport.Name = It->GetName();
+        ProbeVolumeReport.NumProbes = It->NumProbes;
+        ProbeVolumeReport.DataSize = It->DataSize;
+        ProbeVolumeReport.DiskSize = GetAssetDiskSize(It->Asset);
+
+        for (const FSteamAudioBakedDataInfo& Info : It->DetailedStats)
+        {
+            FLevelReportLayer Layer;
+            Layer.Name = Info.Name;
+            Layer.Type = GetLayerTypeName(Info);
+            Layer.Size = Info.Size;
+            ProbeVolumeReport.Layers.Add(Layer);
+        }
+
+        Report.NumProbes += ProbeVolumeReport.NumProbes;
+        Report.BakedDataSize += ProbeVolumeReport.DataSize;
+        Report.BakedDataDiskSize += ProbeVolumeReport.DiskSize;
+        Report.ProbeVolumes.Add(ProbeVolumeReport);
+    }
+
+    // Simulated sources.
+    for (TObjectIterator<USteamAudioSourceComponent> It; It; ++It)
+    {
+        if (!IsInLevel(*It, World, Level))
+            continue;
+
+        Report.NumSources++;
+
+        if (It->bSimulateOcclusion)
+        {
+            Report.NumOcclusionSources++;
+            Report.NumOcclusionRaysPerFrame += (It->OcclusionType == EOcclusionType::VOLUMETRIC) ? It->OcclusionSamples : 1;
+        }
+
+        if (It->bSimulateReflections)
+        {
+            if (It->ReflectionsType == EReflectionSimulationType::REALTIME)
+            {
+                Report.NumRealTimeReflectionSources++;
+            }
+            else
+            {
+                Report.NumBakedReflectionSources++;
+            }
+        }
+
+        if (It->bSimulatePathing)
+        {
+            Report.NumPathingSources++;
+        }
+    }
+
+    for (TObjectIterator<USteamAudioListenerComponent> It; It; ++It)
+    {
+        if (IsInLevel(*It, World, Level) && It->bSimulateReverb && It->ReverbType == EReverbSimulationType::REALTIME)
+        {
+            Report.bRealTimeReverb = true;
+        }
+    }
+
+    // Estimated simulation cost.
+    int NumRealTimeReflectionSources = Report.NumRealTimeReflectionSources + (Report.bRealTimeReverb ? 1 : 0);
+    if (NumRealTimeReflectionSources > 0)
+    {
+        Report.EstimatedReflectionsTime = EstimateRealTimeReflectionsTime(NumRealTimeReflectionSources, NumTrianglesForCost);
+        Report.EstimatedSimulationLoad = Report.EstimatedReflectionsTime / FMath::Max(Settings->SimulationUpdateInterval, 0.001f);
+    }
+
+    return Report;
+}
+
+bool WriteLevelReports(const FString& FileName, const TArray<FLevelReport>& Reports)
+{
+    const USteamAudioSettings* Settings = GetDefault<USteamAudioSettings>();
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+    Writer->WriteObjectStart();
+
+    Writer->WriteObjectStart(TEXT("settings"));
+    Writer->WriteValue(TEXT("realTimeRays"), Settings->RealTimeRays);
+    Writer->WriteValue(TEXT("realTimeBounces"), Settings->RealTimeBounces);
+    Writer->WriteValue(TEXT("realTimeMaxSources"), Settings->RealTimeMaxSources);
+    Writer->WriteValue(TEXT("realTimeThreads"), GetNumThreadsForCPUCoresPercentage(Settings->RealTimeCPUCoresPercentage));
+    Writer->WriteValue(TEXT("simulationUpdateIntervalSeconds"), Settings->SimulationUpdateInterval);
+    Writer->WriteValue(TEXT("calibrated"), FBakeCalibration::Load().bCalibrated);
+    Writer->WriteObjectEnd();
+
+    Writer->WriteArrayStart(TEXT("levels"));
+    for (const FLevelReport& Report : Reports)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("map"), Report.MapName);
+        Writer->WriteValue(TEXT("level"), Report.LevelName);
+        Writer->WriteValue(TEXT("totalBytes"), Report.GetTotalSize());
+        Writer->WriteValue(TEXT("triangles"), Report.NumTriangles);
+        Writer->WriteValue(TEXT("taggedTriangles"), Report.NumTaggedTriangles);
+        Writer->WriteValue(TEXT("staticGeometryBytes"), Report.StaticGeometrySize);
+        Writer->WriteValue(TEXT("estimatedBVHBytes"), Report.EstimatedBVHSize);
+        Writer->WriteValue(TEXT("dynamicObjects"), Report.NumDynamicObjects);
+        Writer->WriteValue(TEXT("dynamicObjectBytes"), Report.DynamicObjectsSize);
+        Writer->WriteValue(TEXT("probes"), Report.NumProbes);
+        Writer->WriteValue(TEXT("bakedDataBytes"), Report.BakedDataSize);
+        Writer->WriteValue(TEXT("bakedDataDiskBytes"), Report.BakedDataDiskSize);
+        Writer->WriteValue(TEXT("sources"), Report.NumSources);
+        Writer->WriteValue(TEXT("realTimeReflectionSources"), Report.NumRealTimeReflectionSources);
+        Writer->WriteValue(TEXT("bakedReflectionSources"), Report.NumBakedReflectionSources);
+        Writer->WriteValue(TEXT("pathingSources"), Report.NumPathingSources);
+        Writer->WriteValue(TEXT("occlusionSources"), Report.NumOcclusionSources);
+        Writer->WriteValue(TEXT("realTimeReverb"), Report.bRealTimeReverb);
+        Writer->WriteValue(TEXT("occlusionRaysPerFrame"), Report.NumOcclusionRaysPerFrame);
+        Writer->WriteValue(TEXT("estimatedReflectionsSecondsPerUpdate"), Report.EstimatedReflectionsTime);
+        Writer->WriteValue(TEXT("estimatedSimulationLoad"), Report.EstimatedSimulationLoad);
+
+        Writer->WriteArrayStart(TEXT("probeVolumes"));
+        for (const FLevelReportProbeVolume& ProbeVolume : Report.ProbeVolumes)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("name"), ProbeVolume.Name);
+            Writer->WriteValue(TEXT("probes"), ProbeVolume.NumProbes);
+            Writer->WriteValue(TEXT("bytes"), ProbeVolume.DataSize);
+            Writer->WriteValue(TEXT("diskBytes"), ProbeVolume.DiskSize);
+
+            Writer->WriteArrayStart(TEXT("layers"));
+            for (const FLevelReportLayer& Layer : ProbeVolume.Layers)
+            {
+                Writer->WriteObjectStart();
+                Writer->WriteValue(TEXT("name"), Layer.Name);
+                Writer->WriteValue(TEXT("type"), Layer.Type);
+                Writer->WriteValue(TEXT("bytes"), Layer.Size);
+                Writer->WriteObjectEnd();
+            }
+            Writer->WriteArrayEnd();
+
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return FFileHelper::SaveStringToFile(Json, *FileName);
+}
+
+void LogLevelReport(const FLevelReport& Report)
+{
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("%s: %.1f MB total, %d triangles, %d dynamic objects, %d probes (%.1f MB baked), %d sources (%d real-time reflections), ~%.1f ms per reflections update (load %.2f)."),
+        *Report.LevelName, Report.GetTotalSize() / (1024.0 * 1024.0), (Report.NumTriangles > 0) ? Report.NumTriangles : Report.NumTaggedTriangles,
+        Report.NumDynamicObjects, Report.NumProbes, Report.BakedDataSize / (1024.0 * 1024.0), Report.NumSources, Report.NumRealTimeReflectionSources,
+        Report.EstimatedReflectionsTime * 1000.0, Report.EstimatedSimulationLoad);
+}
+
+}
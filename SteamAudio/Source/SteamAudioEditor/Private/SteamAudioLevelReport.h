@@ -0,0 +1,135 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioEditorModule.h"
+
+class UWorld;
+class ULevel;
+
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLevelReport
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Size of one layer of baked data in a probe volume. */
+struct FLevelReportLayer
+{
+    FString Name;
+
+    /** One of Reverb, StaticSource, StaticListener, or Pathing. */
+    FString Type;
+
+    /** Size of the baked data, in bytes. */
+    int64 Size = 0;
+};
+
+/** Probes and baked data in one probe volume. */
+struct FLevelReportProbeVolume
+{
+    FString Name;
+    int NumProbes = 0;
+
+    /** Size of the probe batch once loaded, in bytes. */
+    int64 DataSize = 0;
+
+    /** Size of the probe batch asset on disk, in bytes. */
+    int64 DiskSize = 0;
+
+    TArray<FLevelReportLayer> Layers;
+};
+
+/** Memory used by, and estimated simulation cost of, Steam Audio in one level. */
+struct FLevelReport
+{
+    FString MapName;
+    FString LevelName;
+
+    /** Number of triangles in the exported static geometry, or 0 if it hasn't been exported since triangle counts
+        were recorded. */
+    int NumTriangles = 0;
+
+    /** Number of triangles in actors with a Steam Audio Geometry component, before export. */
+    int NumTaggedTriangles = 0;
+
+    /** Size of the exported static geometry once loaded, in bytes. */
+    int64 StaticGeometrySize = 0;
+
+    /** Estimated size of the ray tracing acceleration structure built for the static geometry, in bytes. */
+    int64 EstimatedBVHSize = 0;
+
+    int NumDynamicObjects = 0;
+
+    /** Total size of the exported dynamic objects once loaded, in bytes. */
+    int64 DynamicObjectsSize = 0;
+
+    int NumProbes = 0;
+
+    /** Total size of the probe batches once loaded, in bytes. */
+    int64 BakedDataSize = 0;
+
+    /** Total size of the probe batch assets on disk, in bytes. */
+    int64 BakedDataDiskSize = 0;
+
+    TArray<FLevelReportProbeVolume> ProbeVolumes;
+
+    int NumSources = 0;
+    int NumRealTimeReflectionSources = 0;
+    int NumBakedReflectionSources = 0;
+    int NumPathingSources = 0;
+    int NumOcclusionSources = 0;
+
+    /** True if a listener simulates real-time reverb, which costs as much as a real-time reflections source. */
+    bool bRealTimeReverb = false;
+
+    /** Number of rays traced for occlusion each audio frame, assuming every source is playing. */
+    int NumOcclusionRaysPerFrame = 0;
+
+    /** Estimated wall-clock time of one real-time reflections update, in seconds. */
+    double EstimatedReflectionsTime = 0.0;
+
+    /** Estimated fraction of the time the simulation threads are busy with real-time reflections, given the simulation
+        update interval. Above 1, updates can't keep up. */
+    double EstimatedSimulationLoad = 0.0;
+
+    /** Returns the total size of all Steam Audio data loaded for the level, in bytes. */
+    int64 GetTotalSize() const { return StaticGeometrySize + EstimatedBVHSize + DynamicObjectsSize + BakedDataSize; }
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Level Reports
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if WITH_EDITOR
+
+/** Summarizes the geometry, probes, baked data, and simulated sources in a level, and estimates their simulation cost
+    using the current settings. Loads the exported geometry and probe batch assets (but not their data) to measure
+    their size. Call on the game thread. */
+FLevelReport STEAMAUDIOEDITOR_API GatherLevelReport(UWorld* World, ULevel* Level);
+
+/** Writes level reports as JSON to the given file. Returns true if successful. */
+bool STEAMAUDIOEDITOR_API WriteLevelReports(const FString& FileName, const TArray<FLevelReport>& Reports);
+
+/** Logs a one-line summary of a level report. */
+void STEAMAUDIOEDITOR_API LogLevelReport(const FLevelReport& Report);
+
+#endif
+
+}
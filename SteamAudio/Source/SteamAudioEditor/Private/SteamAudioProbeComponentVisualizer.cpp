@@ -26,15 +26,125 @@ namespace SteamAudio {
 // FSteamAudioProbeComponentVisualizer
 // ---------------------------------------------------------------------------------------------------------------------
 
+/** Average number of probes in each grid cell. */
+static const int ProbesPerCell = 256;
+
+/** Maximum number of grid cells along each axis. */
+static const int MaxCellsPerAxis = 32;
+
+/** Distance from the viewer, in Unreal units, beyond which probes are thinned out. */
+static const float ThinningDistance = 2000.0f;
+
+/** Largest stride between the probes drawn from a distant cell. */
+static const int MaxThinningStride = 64;
+
+/** Maximum number of probes drawn for one probe volume in one view. */
+static const int MaxProbesDrawn = 16384;
+
+const FSteamAudioProbeComponentVisualizer::FProbeCache& FSteamAudioProbeComponentVisualizer::GetCache(USteamAudioProbeComponent* ProbeComponent)
+{
+    FScopeLock Lock(&ProbeComponent->ProbePositionsCriticalSection);
+
+    const TArray<FVector>& ProbePositions = ProbeComponent->ProbePositions;
+
+    FProbeCache* ExistingCache = Caches.Find(ProbeComponent);
+    if (ExistingCache && ExistingCache->Version == ProbeComponent->ProbePositionsVersion && ExistingCache->NumProbes == ProbePositions.Num())
+        return *ExistingCache;
+
+    // Drop caches for components that no longer exist.
+    for (auto It = Caches.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    FProbeCache& Cache = Caches.FindOrAdd(ProbeComponent);
+    Cache.Version = ProbeComponent->ProbePositionsVersion;
+    Cache.NumProbes = ProbePositions.Num();
+    Cache.Cells.Empty();
+
+    if (ProbePositions.Num() == 0)
+        return Cache;
+
+    FBox Bounds(ProbePositions);
+    FVector Size = Bounds.GetSize().ComponentMax(FVector(1.0f));
+
+    int NumCellsPerAxis = FMath::Clamp(FMath::CeilToInt(FMath::Pow(ProbePositions.Num() / static_cast<float>(ProbesPerCell), 1.0f / 3.0f)), 1, MaxCellsPerAxis);
+
+    TArray<FProbeCell> Cells;
+    Cells.SetNum(NumCellsPerAxis * NumCellsPerAxis * NumCellsPerAxis);
+
+    for (const FVector& Position : ProbePositions)
+    {
+        FVector Normalized = (Position - Bounds.Min) / Size;
+        int X = FMath::Clamp(FMath::FloorToInt(Normalized.X * NumCellsPerAxis), 0, NumCellsPerAxis - 1);
+        int Y = FMath::Clamp(FMath::FloorToInt(Normalized.Y * NumCellsPerAxis), 0, NumCellsPerAxis - 1);
+        int Z = FMath::Clamp(FMath::FloorToInt(Normalized.Z * NumCellsPerAxis), 0, NumCellsPerAxis - 1);
+
+        FProbeCell& Cell = Cells[X + NumCellsPerAxis * (Y + NumCellsPerAxis * Z)];
+        Cell.Bounds += Position;
+        Cell.Positions.Add(Position);
+    }
+
+    for (FProbeCell& Cell : Cells)
+    {
+        if (Cell.Positions.Num() > 0)
+        {
+            Cache.Cells.Add(MoveTemp(Cell));
+        }
+    }
+
+    return Cache;
+}
+
 void FSteamAudioProbeComponentVisualizer::DrawVisualization(const UActorComponent* Component, const FSceneView* View, FPrimitiveDrawInterface* PDI)
 {
     USteamAudioProbeComponent* ProbeComponent = const_cast<USteamAudioProbeComponent*>(Cast<USteamAudioProbeComponent>(Component));
-    if (ProbeComponent)
+    if (!ProbeComponent)
+        return;
+
+    const FProbeCache& Cache = GetCache(ProbeComponent);
+
+    // Cull cells outside the view, and choose how many probes to skip in each remaining cell. The number of probes
+    // drawn per unit of screen area stays roughly constant beyond the thinning distance.
+    TArray<TPair<const FProbeCell*, int>, TInlineAllocator<64>> VisibleCells;
+    int NumProbesToDraw = 0;
+
+    FVector ViewOrigin = View->ViewMatrices.GetViewOrigin();
+    bool bPerspective = View->IsPerspectiveProjection();
+
+    for (const FProbeCell& Cell : Cache.Cells)
+    {
+        if (!View->ViewFrustum.IntersectBox(Cell.Bounds.GetCenter(), Cell.Bounds.GetExtent()))
+            continue;
+
+        int Stride = 1;
+        if (bPerspective)
+        {
+            float Distance = FMath::Sqrt(Cell.Bounds.ComputeSquaredDistanceToPoint(ViewOrigin));
+            if (Distance > ThinningDistance)
+            {
+                Stride = FMath::Min(FMath::FloorToInt(FMath::Square(Distance / ThinningDistance)), MaxThinningStride);
+            }
+        }
+
+        VisibleCells.Add(TPair<const FProbeCell*, int>(&Cell, Stride));
+        NumProbesToDraw += FMath::DivideAndRoundUp(Cell.Positions.Num(), Stride);
+    }
+
+    // If there are still too many probes, thin all cells evenly.
+    int BudgetStride = FMath::Max(FMath::DivideAndRoundUp(NumProbesToDraw, MaxProbesDrawn), 1);
+
+    for (const TPair<const FProbeCell*, int>& VisibleCell : VisibleCells)
     {
-        FScopeLock Lock(&ProbeComponent->ProbePositionsCriticalSection);
-        for (const FVector& Position : ProbeComponent->ProbePositions)
+        const TArray<FVector>& Positions = VisibleCell.Key->Positions;
+        int Stride = VisibleCell.Value * BudgetStride;
+
+        for (int i = 0; i < Positions.Num(); i += Stride)
         {
-            PDI->DrawPoint(Position, FColor(0, 153, 255), 5, SDPG_World);
+            PDI->DrawPoint(Positions[i], FColor(0, 153, 255), 5, SDPG_World);
         }
     }
 }
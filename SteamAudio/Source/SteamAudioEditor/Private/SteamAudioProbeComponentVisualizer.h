@@ -21,6 +21,7 @@
 
 class FPrimitiveDrawInterface;
 class FSceneView;
+class USteamAudioProbeComponent;
 
 
 namespace SteamAudio {
@@ -29,10 +30,35 @@ namespace SteamAudio {
 // FSteamAudioProbeComponentVisualizer
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * Draws the probes in a probe volume. Probes are copied into a grid of cells when they change, so each redraw only
+ * visits the cells in the view frustum, and draws fewer probes from cells that are further away.
+ */
 class FSteamAudioProbeComponentVisualizer : public FComponentVisualizer
 {
 public:
     virtual void DrawVisualization(const UActorComponent* Component, const FSceneView* View, FPrimitiveDrawInterface* PDI) override;
+
+private:
+    /** Probes that lie in one cell of a uniform grid. */
+    struct FProbeCell
+    {
+        FBox Bounds = FBox(ForceInit);
+        TArray<FVector> Positions;
+    };
+
+    /** Cached copy of the probes in one probe component. */
+    struct FProbeCache
+    {
+        uint32 Version = 0;
+        int NumProbes = 0;
+        TArray<FProbeCell> Cells;
+    };
+
+    TMap<TWeakObjectPtr<const USteamAudioProbeComponent>, FProbeCache> Caches;
+
+    /** Returns the cached probes for the given component, rebuilding them if the probes have changed. */
+    const FProbeCache& GetCache(USteamAudioProbeComponent* ProbeComponent);
 };
 
 }
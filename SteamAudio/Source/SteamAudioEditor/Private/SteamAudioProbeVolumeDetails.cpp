@@ -25,7 +25,12 @@
 #include "IDetailPropertyRow.h"
 #include "LevelEditorViewport.h"
 #include "PropertyCustomizationHelpers.h"
+#include "ScopedTransaction.h"
+#include "ActorFactories/ActorFactory.h"
 #include "Async/Async.h"
+#include "Builders/CubeBuilder.h"
+#include "Components/BrushComponent.h"
+#include "Engine/Selection.h"
 #include "Widgets/Input/SButton.h"
 #include "SteamAudioBaking.h"
 #include "SteamAudioCommon.h"
@@ -34,6 +39,7 @@
 #include "SteamAudioProbeVolume.h"
 #include "SteamAudioScene.h"
 #include "SteamAudioSerializedObject.h"
+#include "SteamAudioSettings.h"
 #include "SteamAudioStaticMeshActor.h"
 #include "TickableNotification.h"
 
@@ -70,6 +76,8 @@ void FSteamAudioProbeVolumeDetails::CustomizeDetails(IDetailLayoutBuilder& Detai
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, GenerationType));
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, HorizontalSpacing));
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, HeightAboveFloor));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MinHorizontalSpacing));
+	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, MaxProbes));
 
     DetailLayout.EditCategory("ProbeBatchSettings").AddCustomRow(NSLOCTEXT("SteamAudio", "GenerateProbes", "Generate Probes"))
         .NameContent()
@@ -107,6 +115,21 @@ void FSteamAudioProbeVolumeDetails::CustomizeDetails(IDetailLayoutBuilder& Detai
                     .Font(IDetailLayoutBuilder::GetDetailFont())
                     ]
                 ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                    .ContentPadding(2)
+                    .VAlign(VAlign_Center)
+                    .HAlign(HAlign_Center)
+                    .ToolTipText(NSLOCTEXT("SteamAudio", "SplitForStreamingTooltip", "Replaces this probe volume with probe volumes no larger than the probe streaming chunk size, so each can be streamed separately."))
+                    .OnClicked(this, &FSteamAudioProbeVolumeDetails::OnSplitForStreaming)
+                    [
+                        SNew(STextBlock)
+                        .Text(NSLOCTEXT("SteamAudio", "SplitForStreaming", "Split for Streaming"))
+                        .Font(IDetailLayoutBuilder::GetDetailFont())
+                    ]
+                ]
         ];
 
 	DetailLayout.EditCategory("ProbeBatchSettings").AddProperty(GET_MEMBER_NAME_CHECKED(ASteamAudioProbeVolume, NumProbes));
@@ -183,13 +206,8 @@ void FSteamAudioProbeVolumeDetails::OnClearBakedDataLayer(const int32 ArrayIndex
     IPLProbeBatch ProbeBatch = SteamAudio::LoadProbeBatchFromAsset(ProbeVolume->Asset, Context);
     if (ProbeBatch)
     {
-        FSteamAudioBakedDataInfo& Info = ProbeVolume->DetailedStats[ArrayIndex];
-
-        IPLBakedDataIdentifier Identifier;
-        Identifier.type = static_cast<IPLBakedDataType>(Info.Type);
-        Identifier.variation = static_cast<IPLBakedDataVariation>(Info.Variation);
-        Identifier.endpointInfluence.center = SteamAudio::ConvertVector(Info.EndpointCenter);
-        Identifier.endpointInfluence.radius = Info.EndpointRadius;
+        FString LayerName = ProbeVolume->DetailedStats[ArrayIndex].Name;
+        IPLBakedDataIdentifier Identifier = ProbeVolume->DetailedStats[ArrayIndex].GetIdentifier();
 
         iplProbeBatchRemoveData(ProbeBatch, &Identifier);
 
@@ -201,9 +219,9 @@ void FSteamAudioProbeVolumeDetails::OnClearBakedDataLayer(const int32 ArrayIndex
         {
             iplProbeBatchSave(ProbeBatch, SerializedObject);
 
-            ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString());
+            ProbeVolume->RemoveLayer(LayerName);
+            ProbeVolume->Asset = USteamAudioSerializedObject::SerializeObjectToPackage(SerializedObject, ProbeVolume->Asset.GetAssetPathString(), ProbeVolume->DetailedStats);
             ProbeVolume->UpdateTotalSize(iplSerializedObjectGetSize(SerializedObject));
-            ProbeVolume->RemoveLayer(Info.Name);
             ProbeVolume->MarkPackageDirty();
 
             iplSerializedObjectRelease(&SerializedObject);
@@ -223,34 +241,150 @@ void FSteamAudioProbeVolumeDetails::OnClearBakedDataLayer(const int32 ArrayIndex
 
 FReply FSteamAudioProbeVolumeDetails::OnGenerateProbes()
 {
-	// Grab a copy of the volume ptr as it will be destroyed if user clicks off of volume in GUI
-	ASteamAudioProbeVolume* ProbeVolumeHandle = ProbeVolume.Get();
+    if (GIsEditorJobRunning)
+        return FReply::Handled();
 
     UWorld* World = GEditor->GetLevelViewportClients()[0]->GetWorld();
     ULevel* Level = World->GetCurrentLevel();
 
 	ASteamAudioStaticMeshActor* StaticMeshActor = ASteamAudioStaticMeshActor::FindInLevel(World, Level);
-    if (StaticMeshActor && StaticMeshActor->Asset.IsAsset())
+    if (!StaticMeshActor || !StaticMeshActor->Asset.IsAsset())
+        return FReply::Handled();
+
+    // Generate probes in all selected probe volumes in the current level, along with the one being edited. Grab
+    // pointers to them now, as the details panel will be destroyed if the user clicks off of the volume in the GUI.
+    TArray<ASteamAudioProbeVolume*> ProbeVolumes;
+    if (ProbeVolume.IsValid() && ProbeVolume->GetLevel() == Level)
+    {
+        ProbeVolumes.Add(ProbeVolume.Get());
+    }
+
+    for (FSelectionIterator It(GEditor->GetSelectedActorIterator()); It; ++It)
+    {
+        ASteamAudioProbeVolume* SelectedProbeVolume = Cast<ASteamAudioProbeVolume>(*It);
+        if (SelectedProbeVolume && SelectedProbeVolume->GetLevel() == Level)
+        {
+            ProbeVolumes.AddUnique(SelectedProbeVolume);
+        }
+    }
+
+    if (ProbeVolumes.Num() == 0)
+        return FReply::Handled();
+
+    TArray<FString> AssetNames;
+    for (ASteamAudioProbeVolume* Volume : ProbeVolumes)
     {
         FString AssetName;
-        if (PromptForAssetName(Level, AssetName))
+        if (!PromptForAssetName(Level, Volume, AssetName))
+            return FReply::Handled();
+
+        AssetNames.Add(AssetName);
+    }
+
+    TSharedPtr<FSteamAudioProbeGenerationProgress> Progress = MakeShared<FSteamAudioProbeGenerationProgress>();
+
+    if (!BeginEditorJob(FSimpleDelegate::CreateLambda([Progress]() { Progress->bCancel = true; })))
+        return FReply::Handled();
+    Progress->OnProgress = [](int NumVolumesCompleted, int NumVolumes)
+    {
+        FSteamAudioEditorModule::NotifyUpdate(FText::FormatOrdered(NSLOCTEXT("SteamAudio", "GenerateProbesProgress", "Probe Volumes {0}/{1}\nGenerating probes..."),
+            FText::AsNumber(NumVolumesCompleted), FText::AsNumber(NumVolumes)));
+    };
+
+    FSteamAudioEditorModule::NotifyStartingWithCancel(NSLOCTEXT("SteamAudio", "GenerateProbes", "Generating probes..."),
+        FSimpleDelegate::CreateLambda([Progress]() { Progress->bCancel = true; }));
+
+    Async(EAsyncExecution::Thread, [ProbeVolumes, AssetNames, StaticMeshActor, Progress]()
+    {
+        if (ASteamAudioProbeVolume::GenerateProbesForVolumes(StaticMeshActor, ProbeVolumes, AssetNames, Progress.Get()))
+        {
+            FSteamAudioEditorModule::NotifySucceeded(NSLOCTEXT("SteamAudio", "GenerateProbesSuccess", "Generated probes."));
+        }
+        else if (Progress->bCancel)
         {
-            FSteamAudioEditorModule::NotifyStarting(NSLOCTEXT("SteamAudio", "GenerateProbes", "Generating probes..."));
+            FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "GenerateProbesCancelled", "Cancelled probe generation."));
+        }
+        else
+        {
+            FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "GenerateProbesFail", "Failed to generate probes."));
+        }
 
-            Async(EAsyncExecution::Thread, [ProbeVolumeHandle, StaticMeshActor, AssetName]()
-            {
-                if (ProbeVolumeHandle->GenerateProbes(StaticMeshActor, AssetName))
-                {
-                    FSteamAudioEditorModule::NotifySucceeded(NSLOCTEXT("SteamAudio", "GenerateProbesSuccess", "Generated probes."));
-                }
-                else
-                {
-                    FSteamAudioEditorModule::NotifyFailed(NSLOCTEXT("SteamAudio", "GenerateProbesFail", "Failed to generate probes."));
-                }
-            });
+        EndEditorJob();
+    });
+
+    return FReply::Handled();
+}
+
+FReply FSteamAudioProbeVolumeDetails::OnSplitForStreaming()
+{
+    ASteamAudioProbeVolume* Volume = ProbeVolume.Get();
+    if (!Volume || !Volume->GetBrushComponent())
+        return FReply::Handled();
+
+    // Only box-shaped volumes can be split into a grid of smaller boxes.
+    if (!Cast<UCubeBuilder>(Volume->BrushBuilder))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to split probe volume %s: only box-shaped probe volumes can be split."), *Volume->GetActorLabel());
+        return FReply::Handled();
+    }
+
+    FBox LocalBounds = Volume->GetBrushComponent()->CalcBounds(FTransform::Identity).GetBox();
+    FVector LocalSize = LocalBounds.GetSize();
+    FVector WorldSize = LocalSize * Volume->GetActorScale3D().GetAbs();
+
+    float ChunkSize = SteamAudio::ConvertSteamAudioDistanceToUnreal(GetDefault<USteamAudioSettings>()->ProbeStreamingChunkSize);
+    int NumChunksX = FMath::Max(1, FMath::CeilToInt(WorldSize.X / ChunkSize));
+    int NumChunksY = FMath::Max(1, FMath::CeilToInt(WorldSize.Y / ChunkSize));
+    if (NumChunksX * NumChunksY <= 1)
+    {
+        UE_LOG(LogSteamAudioEditor, Log, TEXT("Probe volume %s is already no larger than the probe streaming chunk size."), *Volume->GetActorLabel());
+        return FReply::Handled();
+    }
+
+    FScopedTransaction Transaction(NSLOCTEXT("SteamAudio", "SplitProbeVolume", "Split Probe Volume"));
+
+    UWorld* World = Volume->GetWorld();
+    FVector ChunkLocalSize(LocalSize.X / NumChunksX, LocalSize.Y / NumChunksY, LocalSize.Z);
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.OverrideLevel = Volume->GetLevel();
+
+    GEditor->SelectNone(false, true);
+
+    for (int i = 0; i < NumChunksX; ++i)
+    {
+        for (int j = 0; j < NumChunksY; ++j)
+        {
+            FVector LocalCenter(LocalBounds.Min.X + (i + 0.5f) * ChunkLocalSize.X, LocalBounds.Min.Y + (j + 0.5f) * ChunkLocalSize.Y, LocalBounds.GetCenter().Z);
+            FTransform ChunkTransform(Volume->GetActorQuat(), Volume->GetActorTransform().TransformPosition(LocalCenter), Volume->GetActorScale3D());
+
+            ASteamAudioProbeVolume* Chunk = World->SpawnActor<ASteamAudioProbeVolume>(ASteamAudioProbeVolume::StaticClass(), ChunkTransform, SpawnParameters);
+            if (!Chunk)
+                continue;
+
+            UCubeBuilder* Builder = NewObject<UCubeBuilder>();
+            Builder->X = ChunkLocalSize.X;
+            Builder->Y = ChunkLocalSize.Y;
+            Builder->Z = ChunkLocalSize.Z;
+            UActorFactory::CreateBrushForVolumeActor(Chunk, Builder);
+
+            Chunk->GenerationType = Volume->GenerationType;
+            Chunk->HorizontalSpacing = Volume->HorizontalSpacing;
+            Chunk->HeightAboveFloor = Volume->HeightAboveFloor;
+            Chunk->MinHorizontalSpacing = Volume->MinHorizontalSpacing;
+            Chunk->MaxProbes = Volume->MaxProbes;
+            Chunk->SetActorLabel(FString::Printf(TEXT("%s_%d_%d"), *Volume->GetActorLabel(), i, j));
+
+            GEditor->SelectActor(Chunk, true, false);
         }
     }
 
+    // The probe batch asset of the original volume is left in place, and can be deleted once probes have been
+    // generated for the new volumes.
+    World->EditorDestroyActor(Volume, true);
+
+    GEditor->NoteSelectionChange();
+
     return FReply::Handled();
 }
 
@@ -320,11 +454,11 @@ FReply FSteamAudioProbeVolumeDetails::OnBakePathing()
     return FReply::Handled();
 }
 
-bool FSteamAudioProbeVolumeDetails::PromptForAssetName(ULevel* Level, FString& AssetName)
+bool FSteamAudioProbeVolumeDetails::PromptForAssetName(ULevel* Level, ASteamAudioProbeVolume* Volume, FString& AssetName)
 {
-    if (ProbeVolume->Asset.IsValid())
+    if (Volume->Asset.IsValid())
     {
-        AssetName = ProbeVolume->Asset.GetAssetPathString();
+        AssetName = Volume->Asset.GetAssetPathString();
     }
     else
     {
@@ -333,7 +467,7 @@ bool FSteamAudioProbeVolumeDetails::PromptForAssetName(ULevel* Level, FString& A
         FSaveAssetDialogConfig DialogConfig{};
         DialogConfig.DialogTitleOverride = NSLOCTEXT("SteamAudio", "SaveProbeBatch", "Save probe batch as...");
         DialogConfig.DefaultPath = TEXT("/Game");
-        DialogConfig.DefaultAssetName = Level->GetOutermostObject()->GetName() + "_" + ProbeVolume->GetName();
+        DialogConfig.DefaultAssetName = Level->GetOutermostObject()->GetName() + "_" + Volume->GetName();
         DialogConfig.ExistingAssetPolicy = ESaveAssetDialogExistingAssetPolicy::AllowButWarn;
 
         AssetName = ContentBrowser.CreateModalSaveAssetDialog(DialogConfig);
@@ -43,10 +43,11 @@ private:
     void OnClearBakedDataLayer(const int32 ArrayIndex);
 
     FReply OnGenerateProbes();
+    FReply OnSplitForStreaming();
     FReply OnClearBakedData();
     FReply OnBakePathing();
 
-    bool PromptForAssetName(ULevel* Level, FString& AssetName);
+    bool PromptForAssetName(ULevel* Level, ASteamAudioProbeVolume* Volume, FString& AssetName);
 };
 
 }
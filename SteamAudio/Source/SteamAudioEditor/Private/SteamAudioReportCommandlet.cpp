@@ -0,0 +1,188 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "SteamAudioReportCommandlet.h"
+#include "FileHelpers.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "SteamAudioLevelReport.h"
+
+namespace SteamAudio {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helper Functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Returns the long package names of all maps in the project's Content directory.
+static TArray<FString> FindAllMaps()
+{
+    TArray<FString> FileNames;
+    FPackageName::FindPackagesInDirectory(FileNames, FPaths::ProjectContentDir());
+
+    TArray<FString> MapNames;
+    for (const FString& FileName : FileNames)
+    {
+        FString MapName;
+        if (FPaths::GetExtension(FileName, true) == FPackageName::GetMapPackageExtension() &&
+            FPackageName::TryConvertFilenameToLongPackageName(FileName, MapName))
+        {
+            MapNames.Add(MapName);
+        }
+    }
+
+    MapNames.Sort();
+    return MapNames;
+}
+
+// Logs an error for each budget that the given level exceeds. Budgets that are 0 or less are ignored. Returns true if
+// the level is within all budgets.
+static bool CheckBudgets(const FLevelReport& Report, int MaxTriangles, double MaxBakedDataMB, double MaxTotalMB, double MaxSimulationLoad)
+{
+    bool bWithinBudget = true;
+
+    int NumTriangles = (Report.NumTriangles > 0) ? Report.NumTriangles : Report.NumTaggedTriangles;
+    if (MaxTriangles > 0 && NumTriangles > MaxTriangles)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("%s: %d triangles exceeds budget of %d."), *Report.LevelName, NumTriangles, MaxTriangles);
+        bWithinBudget = false;
+    }
+
+    double BakedDataMB = Report.BakedDataSize / (1024.0 * 1024.0);
+    if (MaxBakedDataMB > 0.0 && BakedDataMB > MaxBakedDataMB)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("%s: %.1f MB of baked data exceeds budget of %.1f MB."), *Report.LevelName, BakedDataMB, MaxBakedDataMB);
+        bWithinBudget = false;
+    }
+
+    double TotalMB = Report.GetTotalSize() / (1024.0 * 1024.0);
+    if (MaxTotalMB > 0.0 && TotalMB > MaxTotalMB)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("%s: %.1f MB in total exceeds budget of %.1f MB."), *Report.LevelName, TotalMB, MaxTotalMB);
+        bWithinBudget = false;
+    }
+
+    if (MaxSimulationLoad > 0.0 && Report.EstimatedSimulationLoad > MaxSimulationLoad)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("%s: estimated simulation load of %.2f exceeds budget of %.2f."), *Report.LevelName,
+            Report.EstimatedSimulationLoad, MaxSimulationLoad);
+        bWithinBudget = false;
+    }
+
+    return bWithinBudget;
+}
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioReportCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+USteamAudioReportCommandlet::USteamAudioReportCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 USteamAudioReportCommandlet::Main(const FString& Params)
+{
+    using namespace SteamAudio;
+
+    TArray<FString> MapNames;
+
+    FString MapName;
+    FString MapsString;
+    if (FParse::Value(*Params, TEXT("Map="), MapName))
+    {
+        MapNames.Add(MapName);
+    }
+    else if (FParse::Value(*Params, TEXT("Maps="), MapsString, false))
+    {
+        MapsString.ParseIntoArray(MapNames, TEXT(","));
+    }
+    else
+    {
+        MapNames = FindAllMaps();
+    }
+
+    if (MapNames.Num() == 0)
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("No maps to report on. Specify maps with -Map=/Game/Path/To/Map or -Maps=<list>."));
+        return 1;
+    }
+
+    int MaxTriangles = 0;
+    double MaxBakedDataMB = 0.0;
+    double MaxTotalMB = 0.0;
+    double MaxSimulationLoad = 0.0;
+    FParse::Value(*Params, TEXT("MaxTriangles="), MaxTriangles);
+    FParse::Value(*Params, TEXT("MaxBakedDataMB="), MaxBakedDataMB);
+    FParse::Value(*Params, TEXT("MaxTotalMB="), MaxTotalMB);
+    FParse::Value(*Params, TEXT("MaxSimulationLoad="), MaxSimulationLoad);
+
+    FString ReportFileName = FPaths::ProjectSavedDir() / TEXT("SteamAudio") / TEXT("Reports") / TEXT("Levels.json");
+    FParse::Value(*Params, TEXT("Report="), ReportFileName);
+
+    bool bSuccess = true;
+    TArray<FLevelReport> Reports;
+
+    for (const FString& Map : MapNames)
+    {
+        if (!FPackageName::DoesPackageExist(Map))
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Map does not exist: %s"), *Map);
+            bSuccess = false;
+            continue;
+        }
+
+        UWorld* World = UEditorLoadingAndSavingUtils::LoadMap(Map);
+        if (!World)
+        {
+            UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to load map: %s"), *Map);
+            bSuccess = false;
+            continue;
+        }
+
+        for (ULevel* Level : World->GetLevels())
+        {
+            if (!Level)
+                continue;
+
+            FLevelReport Report = GatherLevelReport(World, Level);
+            LogLevelReport(Report);
+
+            if (!CheckBudgets(Report, MaxTriangles, MaxBakedDataMB, MaxTotalMB, MaxSimulationLoad))
+            {
+                bSuccess = false;
+            }
+
+            Reports.Add(Report);
+        }
+    }
+
+    if (!WriteLevelReports(ReportFileName, Reports))
+    {
+        UE_LOG(LogSteamAudioEditor, Error, TEXT("Unable to write level report: %s"), *ReportFileName);
+        return 1;
+    }
+
+    UE_LOG(LogSteamAudioEditor, Display, TEXT("Reported on %d level(s) in %d map(s). Report written to %s."), Reports.Num(), MapNames.Num(),
+        *ReportFileName);
+
+    return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+//
+// Copyright 2017-2023 Valve Corporation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#pragma once
+
+#include "SteamAudioEditorModule.h"
+#include "Commandlets/Commandlet.h"
+#include "SteamAudioReportCommandlet.generated.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// USteamAudioReportCommandlet
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Loads one or more maps and reports the memory used by Steam Audio in each of their levels (geometry, acceleration
+// structures, probes, and each layer of baked data), along with the number of dynamic objects and simulated sources,
+// and the estimated cost of real-time simulation with the current settings. Nothing is saved except the report.
+//
+// Usage:
+//     UnrealEditor-Cmd <Project>.uproject -run=SteamAudioReport [-Map=/Game/Maps/MyMap] [options] -nullrhi -unattended
+//
+// Options:
+//     -Map=<map>                   Map to report on.
+//     -Maps=<list>                 Comma-separated maps to report on. If neither -Map nor -Maps is given, every map
+//                                  in the project's Content directory is reported on.
+//     -Report=<file>               Writes the report as JSON to the given file. Defaults to
+//                                  Saved/SteamAudio/Reports/Levels.json.
+//     -MaxTriangles=<n>            Fails if any level has more than n triangles of static geometry.
+//     -MaxBakedDataMB=<n>          Fails if any level has more than n MB of baked data.
+//     -MaxTotalMB=<n>              Fails if any level uses more than n MB in total.
+//     -MaxSimulationLoad=<n>       Fails if the estimated real-time simulation load of any level is more than n. A load
+//                                  of 1 means the simulation threads are always busy.
+//
+// Returns 0 if every map was loaded and is within budget, and 1 otherwise.
+UCLASS()
+class USteamAudioReportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USteamAudioReportCommandlet();
+
+    //
+    // Inherited from UCommandlet
+    //
+
+    // Runs the commandlet.
+    virtual int32 Main(const FString& Params) override;
+};
@@ -58,6 +58,7 @@ private:
     TArray<TSharedPtr<FAssetTypeActions_Base>> AssetTypeActions; // Metadata objects for each type of Steam Audio asset that can be created.
 	TArray<FName> RegisteredComponentClassNames;
     TSharedPtr<FBakeWindow> BakeWindow;
+    FDelegateHandle PreBeginPIEHandle;
 
     void RegisterComponentVisualizer(FName ComponentClassName, TSharedPtr<FComponentVisualizer> Visualizer);
 
@@ -70,6 +71,8 @@ private:
     void OnExportDynamicObjects();
     void OnExportDynamicObjectsCurrentLevel();
     void OnBake();
+    void OnGenerateLevelReport();
+    void OnPreBeginPIE(bool bIsSimulating);
 
     void ExportSingleLevel(UWorld* World, ULevel* Level, bool bExportOBJ);
     void ExportAllLevels(UWorld* World, bool bExportOBJ);
@@ -14,6 +14,8 @@
 // limitations under the License.
 //
 
+using System;
+using System.IO;
 using UnrealBuildTool;
 
 public class SteamAudioSDK : ModuleRules
@@ -25,6 +27,26 @@ public class SteamAudioSDK : ModuleRules
 
         PublicIncludePaths.Add("$(PluginDir)/Source/SteamAudioSDK/include");
 
+        // If STEAMAUDIO_STUB_PHONON=1 is set, build against the stub implementation of the API in the SteamAudio module
+        // instead of the SDK. This lets the plugin be built and benchmarked on CI machines without the SDK. The stub
+        // produces no audible result, so it must be asked for explicitly, and is never allowed in Shipping builds.
+        bool bUseStub = Environment.GetEnvironmentVariable("STEAMAUDIO_STUB_PHONON") == "1";
+        if (bUseStub && Target.Configuration == UnrealTargetConfiguration.Shipping)
+        {
+            throw new BuildException("STEAMAUDIO_STUB_PHONON=1 is set, but the stub Steam Audio API can't be used in Shipping builds.");
+        }
+
+        string LibraryPath = GetLibraryPath(Target);
+        if (!bUseStub && LibraryPath != null && !File.Exists(LibraryPath))
+        {
+            throw new BuildException("The Steam Audio SDK library for " + Target.Platform + " was not found at " + LibraryPath +
+                ". Copy the SDK libraries into the plugin, or set STEAMAUDIO_STUB_PHONON=1 to build against the stub API for testing.");
+        }
+
+        PublicDefinitions.Add("STEAMAUDIO_STUB_PHONON=" + (bUseStub ? "1" : "0"));
+        if (bUseStub)
+            return;
+
 #if !UE_5_0_OR_LATER
         if (Target.Platform == UnrealTargetPlatform.Win32)
         {
@@ -81,4 +103,23 @@ public class SteamAudioSDK : ModuleRules
             PublicAdditionalLibraries.Add("$(PluginDir)/Source/SteamAudioSDK/lib/ios/libphonon.a");
         }
     }
+
+    // Returns the path of the Steam Audio library to link against for the given target, or null if there isn't one.
+    private string GetLibraryPath(ReadOnlyTargetRules Target)
+    {
+        string LibDir = Path.Combine(PluginDirectory, "Source", "SteamAudioSDK", "lib");
+
+        if (Target.Platform == UnrealTargetPlatform.Win64)
+            return Path.Combine(LibDir, "windows-x64", "phonon.lib");
+        if (Target.Platform == UnrealTargetPlatform.Linux)
+            return Path.Combine(LibDir, "linux-x64", "libphonon.so");
+        if (Target.Platform == UnrealTargetPlatform.Mac)
+            return Path.Combine(LibDir, "osx", "libphonon.dylib");
+        if (Target.Platform == UnrealTargetPlatform.Android)
+            return Path.Combine(LibDir, "android", "arm64-v8a", "libphonon.so");
+        if (Target.Platform == UnrealTargetPlatform.IOS)
+            return Path.Combine(LibDir, "ios", "libphonon.a");
+
+        return null;
+    }
 }